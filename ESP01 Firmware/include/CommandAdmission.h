@@ -0,0 +1,71 @@
+#ifndef COMMAND_ADMISSION_H
+#define COMMAND_ADMISSION_H
+
+#include <Arduino.h>
+#include <functional>
+#include "MQTTConfig.h"
+#include "TimerWheel.h"
+
+// Integer token bucket refilled lazily from millis()
+class TokenBucket {
+    public:
+        TokenBucket(uint16_t capacity, uint32_t refillMs);
+
+        bool take(uint32_t now);
+        uint32_t wait(uint32_t now);                // ms until the next token
+
+    private:
+        uint16_t            capacity;
+        uint16_t            tokens;
+        uint32_t            refillMs;
+        uint32_t            lastRefill;
+
+        void refill(uint32_t now);
+};
+
+// Admission stage in front of processCommand. Downlink messages pass a
+// message bucket before they are even parsed; actuations pass a second
+// bucket and a coalescing window where the last requested state wins; a
+// change outside any window with the bucket empty is throttled.
+// Everything that is dropped or merged is reported back, never silently lost.
+class CommandAdmission {
+    public:
+        enum Verdict {
+            ADMIT_APPLY,                            // Actuate now
+            ADMIT_COALESCED,                        // Merged into the pending target, applied later
+            ADMIT_THROTTLED                         // Rejected, no actuation budget left
+        };
+
+        typedef std::function<bool()>               StateReader;
+        typedef std::function<void(bool state)>     ApplyHandler;
+        typedef std::function<void(uint32_t dropped)> ReportHandler;
+
+        CommandAdmission(TimerWheel& wheel);
+
+        void begin(StateReader current, ApplyHandler onApply, ReportHandler onReport);
+        bool acceptMessage();
+        Verdict admitState(bool state, bool current);
+        bool admitPulse();
+
+        bool hasPending() const                     { return hasTarget; }
+        bool pendingState() const                   { return target; }
+        uint32_t pendingMs() const;
+        uint32_t budgetMs();                        // ms until the next actuation token
+
+    private:
+        bool                hasTarget;
+        bool                target;
+        uint32_t            dropped;
+        TimerWheel&         wheel;
+        TokenBucket         messages;
+        TokenBucket         actuations;
+        StateReader         current;
+        ApplyHandler        onApply;
+        ReportHandler       onReport;
+        TimerWheel::Timer   windowTimer;
+        TimerWheel::Timer   reportTimer;
+
+        void closeWindow();
+};
+
+#endif // COMMAND_ADMISSION_H
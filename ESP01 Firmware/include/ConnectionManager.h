@@ -0,0 +1,58 @@
+#ifndef CONNECTION_MANAGER_H
+#define CONNECTION_MANAGER_H
+
+#include <Arduino.h>
+#ifdef ESP8266
+    #include <ESP8266WiFi.h>
+#else
+    #include <WiFi.h>
+#endif
+#include <ChronoLog.h>
+#include <functional>
+#include "MQTTConfig.h"
+#include "TimerWheel.h"
+
+// Owns the station link after setup(). WiFi events (got IP, disconnected)
+// only flag a change; loop() picks it up and tells the link handler, so the
+// MQTT session reconnects the moment the link is back and stops spending
+// attempts while it is down. The SDK rejoins on its own, a backed-off
+// WiFi.begin() on the timer wheel covers the cases where it gives up.
+class ConnectionManager {
+    public:
+        typedef std::function<void(bool up)> LinkHandler;
+
+        ConnectionManager();
+        ~ConnectionManager();
+
+        ConnectionManager(const ConnectionManager&) = delete;
+        ConnectionManager& operator=(const ConnectionManager&) = delete;
+
+        bool begin(const char* ssid, const char* password, uint32_t timeoutMs);   // Joins and waits up to timeoutMs
+        void attach(TimerWheel& timers, LinkHandler handler);                     // Handler is called with the current state first
+        void loop();
+
+        bool isUp() const                       { return up;        }
+        bool hasEvent() const                   { return changed;   }   // A link change loop() has not handled yet
+
+    private:
+        bool                up;
+        volatile bool       changed;            // Set from the WiFi event context
+        uint32_t            retryMs;
+        String              ssid;
+        String              password;
+        ChronoLogger        logger;
+        TimerWheel*         timers;
+        TimerWheel::Timer   retryTimer;
+        LinkHandler         onLink;
+        #ifdef ESP8266
+            WiFiEventHandler    gotIpHandler;
+            WiFiEventHandler    disconnectedHandler;
+        #else
+            wifi_event_id_t     eventId;
+        #endif
+
+        void retry();
+        bool hasSsid() const                    { return ssid.length() > 0; }
+};
+
+#endif // CONNECTION_MANAGER_H
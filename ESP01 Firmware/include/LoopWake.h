@@ -0,0 +1,23 @@
+#ifndef LOOP_WAKE_H
+#define LOOP_WAKE_H
+
+#include <Arduino.h>
+#include <functional>
+#include "MQTTConfig.h"
+
+// Lets loop() block until its next deadline. Event sources (WiFi events,
+// portal requests) call notify() from their own task or callback and end the
+// sleep at once: a task notification on ESP32, esp_schedule() on ESP8266.
+// Bytes on the broker socket raise no event (the core's TCP client owns the
+// lwIP receive callback), so the wake condition is also checked every
+// LOOP_WAKE_POLL_MS while the loop task is suspended.
+class LoopWake {
+    public:
+        typedef std::function<bool()> Condition;
+
+        static void begin();                                    // From setup(), on the loop task
+        static void notify();                                   // Any task or SDK callback, not an ISR
+        static void sleep(uint32_t ms, Condition wake);         // Returns early once wake() holds
+};
+
+#endif // LOOP_WAKE_H
@@ -10,8 +10,14 @@
 #define MQTT_KEEPALIVE          60
 #endif
 #define MQTT_QOS                1
+#define MQTT_BUFFER_SIZE        1024    // Largest downlink accepted (schedules, group lists)
 #define MQTT_RETAINED           true
 
+// Reported in the retained device state document
+#ifndef FIRMWARE_VERSION
+#define FIRMWARE_VERSION        "1.1.0"
+#endif
+
 // Device Configuration (Note: UUID and Name are now generated dynamically from MAC address)
 // Legacy defines kept for compatibility - actual values generated at runtime
 #define DEVICE_UUID             "AUTO_GENERATED"  // Generated from MAC address
@@ -21,15 +27,69 @@
 #define UPLINK_TOPIC_PREFIX     "ControlDevice/Uplink/"
 #define DOWNLINK_TOPIC_PREFIX   "ControlDevice/Downlink/"
 #define STATUS_TOPIC_PREFIX     "ControlDevice/Status/"
+#define GROUP_TOPIC_PREFIX      "ControlDevice/Group/"
+#define DESIRED_TOPIC_PREFIX    "ControlDevice/Desired/"  // Retained shadow, {"version": n, "state": "on"}
+#define OTA_TOPIC_PREFIX        "ControlDevice/OTA/"      // Firmware chunks, u32 LE chunk number + data
+
+// Group Settings
+#define MQTT_MAX_GROUPS         4       // Group filters per controller (e.g. "site1/floor2/+")
+#define GROUP_ACK_SAMPLE_PERCENT 10     // Share of members acking a group command by default
 
 // Connection Settings
 #define MQTT_RECONNECT_DELAY    5000    // 5 seconds
 #define MQTT_MAX_RECONNECT_ATTEMPTS 10
 #define HEARTBEAT_INTERVAL      30000   // 30 seconds
+#define WIFI_CONNECT_TIMEOUT    10000   // Boot waits this long for the first join
+#define WIFI_RETRY_MIN_MS       5000    // Own rejoin attempts while the link is down, next to the SDK's
+#define WIFI_RETRY_MAX_MS       60000   // Rejoin backoff doubles up to this
+
+// Schedule Settings
+#define MQTT_MAX_SCHEDULE_RULES 8       // Rules per controller (daily/weekly or one-shot)
+#define SCHEDULE_NTP_SERVER     "pool.ntp.org"
+#ifndef SCHEDULE_TIMEZONE
+#define SCHEDULE_TIMEZONE       "UTC0"  // POSIX TZ string, rule times are local
+#endif
+#define SCHEDULE_RESYNC_INTERVAL 3600000 // Re-arm rules hourly against the wall clock
+
+// Timed Action Settings
+#define RELAY_MAX_PULSE_MS      3600000 // Longest accepted pulse (1 hour)
+#define RELAY_PERSIST_DELAY     1000    // Relay state commits are coalesced over this window
+
+// Command Admission Settings
+#define ADMISSION_MSG_BURST     20      // Downlink messages accepted back to back
+#define ADMISSION_MSG_REFILL_MS 50      // Then one more every 50 ms (20 messages/s sustained)
+#define ADMISSION_ACT_BURST     4       // Relay actuations back to back
+#define ADMISSION_ACT_REFILL_MS 500     // Then one more every 500 ms (2 actuations/s sustained)
+#define ADMISSION_COALESCE_MS   100     // set_state requests inside this window collapse to the last one
+#define ADMISSION_REPORT_MS     1000    // Dropped messages are reported at most once per period
+
+// Firmware Update Settings
+#define OTA_MAX_CHUNK           768     // Largest chunk accepted, must fit MQTT_BUFFER_SIZE with its topic
+#define OTA_ACK_EVERY           4       // Progress ack after this many chunks
+#define OTA_ABANDON_TIMEOUT     600000  // Unfinished transfers are dropped after 10 minutes of silence
+#define OTA_REBOOT_DELAY        3000    // Time for the final ack and offline status to leave
+
+// Main Loop Settings
+#define LOOP_IDLE_MAX_MS        1000    // Longest sleep between two loop() passes with nothing scheduled
+#define LOOP_WAKE_POLL_MS       50      // While asleep, broker data (which raises no event) is checked this often, adds up to this much command latency
+
+// Maintenance Portal Settings
+#define PORTAL_DUAL_AP          1       // Maintenance portal also raises its own AP, 0 keeps it on the LAN only
+#define PORTAL_HEAP_RESERVE     16384   // Heap kept for the MQTT session (TLS records), the portal refuses pages below it
+#define PORTAL_JOBS_PER_LOOP    1       // Portal jobs run between two relay passes of loop()
 
 // EEPROM Settings
 #define MQTT_EEPROM_ADDR        200
-#define MQTT_EEPROM_SIZE        100
+#define MQTT_EEPROM_SIZE        1024    // EEPROM.begin() size, must cover every record below
+#define MQTT_GROUPS_EEPROM_ADDR 400     // One ';'-separated group list per controller slot
+#define MQTT_GROUPS_EEPROM_LEN  64
+#define MQTT_MAX_SLOTS          4       // Controllers with persisted groups, schedules and timing
+#define MQTT_SCHEDULE_EEPROM_ADDR (MQTT_GROUPS_EEPROM_ADDR + MQTT_MAX_SLOTS * MQTT_GROUPS_EEPROM_LEN)
+#define MQTT_SCHEDULE_EEPROM_LEN 68     // sizeof(ScheduleTable)
+#define MQTT_TIMING_EEPROM_ADDR (MQTT_SCHEDULE_EEPROM_ADDR + MQTT_MAX_SLOTS * MQTT_SCHEDULE_EEPROM_LEN)
+#define MQTT_TIMING_EEPROM_LEN  16      // sizeof(RelayTiming)
+#define MQTT_VERSION_EEPROM_ADDR (MQTT_TIMING_EEPROM_ADDR + MQTT_MAX_SLOTS * MQTT_TIMING_EEPROM_LEN)
+#define MQTT_VERSION_EEPROM_LEN 4       // Applied desired-state version (uint32_t)
 
 // Root CA Certificate (replace with your actual certificate)
 extern const char* rootCACertificate;
@@ -15,11 +15,35 @@
 #include <EEPROM.h>
 #include <ChronoLog.h>
 #include "MQTTConfig.h"
+#include "MQTTSession.h"
+#include "TimerWheel.h"
+#include "RelaySchedule.h"
+#include "RelayOutputDrivers.h"
+#include "CommandAdmission.h"
+#include "MQTTUpdate.h"
+#include <vector>
+
+#define RELAY_TIMING_MAGIC      0xA7
+
+// Local timing rules, persisted per controller slot
+struct RelayTiming {
+    uint8_t  magic;
+    uint8_t  interlock;                 // Controllers sharing a non-zero group are never on together
+    uint16_t reserved;
+    uint32_t autoOffMs;                 // Switch off this long after any turn-on, 0 = disabled
+    uint32_t minOnMs;                   // Minimum dwell before an on relay may switch off
+    uint32_t minOffMs;                  // Minimum dwell before an off relay may switch on
+};
+
+static_assert(sizeof(RelayTiming) <= MQTT_TIMING_EEPROM_LEN, "Relay timing overflows its EEPROM slot");
+static_assert(MQTT_VERSION_EEPROM_ADDR + MQTT_MAX_SLOTS * MQTT_VERSION_EEPROM_LEN <= MQTT_EEPROM_SIZE, "EEPROM records exceed MQTT_EEPROM_SIZE");
 
 class MQTTRelay {
     public:
 
         MQTTRelay(uint8_t relayPin, const char* deviceUUID = DEVICE_UUID, const char* deviceName = DEVICE_NAME);
+        MQTTRelay(MQTTSession& session, uint8_t relayPin, const char* deviceUUID, const char* deviceName);
+        MQTTRelay(MQTTSession& session, RelayOutput& output, uint8_t channel, const char* deviceUUID, const char* deviceName);
         ~MQTTRelay();
         void loop();
         bool begin();
@@ -29,42 +53,99 @@ class MQTTRelay {
 
         void sendHeartbeat();
         bool setRelayState(bool state, bool saveToEEPROM = true);
+        bool pulse(bool state, uint32_t durationMs);
+        void flush();
+
+        static void flushAll();
+        static void prepareRestart();           // Flush, publish offline and disconnect, before any restart
         void sendStatus(const char* status, bool retained = true);
 
+        bool addGroup(const char* group, bool persist = true);
+        void clearGroups(bool persist = true);
+
         bool getRelayState() const { return relayState; }
+        const std::vector<String>& getGroups() const { return groups; }
         void setBrokerConfig(const char* host, int port, bool useSSL = true);
 
+        MQTTSession& getSession()       { return *session; }
+
     private:
-        int                 reconnectAttempts;
-        bool                autoReconnect;
         bool                relayState;
-        uint8_t             relayPin;
+        bool                ownsSession;
+        bool                ackSuppressed;
+        bool                pendingState;
+        bool                desiredState;
+        bool                pendingPersist;
+        bool                revertState;
+        bool                revertPersist;
+        bool                savedState;
+        bool                stateDirty;
+        bool                stateChanged;
+        bool                ownsOutput;
+        uint8_t             outputChannel;
+        uint8_t             stateSlot;
         String              deviceUUID;
         String              deviceName;
         String              uplinkTopic;
         String              downlinkTopic;
         String              statusTopic;
-        MQTTConfig          config;
-        WiFiClient          wifiClient;
+        String              desiredTopic;
+        String              publishedState;
+        const char*         activeGroup;
+        const char*         admissionOutcome;
         ChronoLogger        logger;
-        unsigned long       lastHeartbeat;
-        unsigned long       lastReconnectAttempt;
-        PubSubClient*       mqttClient;
-        WiFiClientSecure    wifiClientSecure;
+        MQTTSession*        session;
+        RelayOutput*        output;
+        unsigned long       commandStart;
+        uint32_t            lastChange;
+        uint32_t            pendingPulseMs;
+        uint32_t            appliedVersion;             // Last desired-state version reconciled
+        uint32_t            savedVersion;
+        uint32_t            desiredVersion;             // Accepted but not actuated yet, 0 when none
+        uint32_t            supersededVersion;          // Last desired-state version a later command overrode
+        RelayTiming         timing;
+        TimerWheel&         timers;                     // The session's, shared by its controllers
+        TimerWheel::Timer   pendingTimer;
+        TimerWheel::Timer   revertTimer;
+        TimerWheel::Timer   persistTimer;
+        TimerWheel::Timer   heartbeatTimer;
+        TimerWheel::Timer   desiredTimer;               // Retries a throttled desired state
+        RelaySchedule       schedule;
+        CommandAdmission    admission;
+        MQTTUpdate*         firmwareUpdate;             // First controller of a session only
+        std::vector<String> groups;
+
+        static std::vector<MQTTRelay*> instances;      // Interlock peers
 
-        void setupSSL();
-        static void mqttCallback(char* topic, byte* payload, unsigned int length);
-        static MQTTRelay* instance;
-        void handleMessage(char* topic, byte* payload, unsigned int length);
+        void initTopics();
+        bool requestState(bool state, bool persist, uint32_t pulseMs);
+        void applyState(bool state, bool persist, uint32_t pulseMs);
+        void releaseInterlock();
+        uint32_t dwellRemaining(bool state) const;
+        uint32_t interlockRemaining() const;
+        void handleMessage(const char* topic, byte* payload, unsigned int length);
+        void handleGroupMessage(const char* topic, byte* payload, unsigned int length);
+        void handleDesired(const char* topic, byte* payload, unsigned int length);
+        void reconcileDesired();
+        void settleDesired();
+        void schedulePersist();
+        bool isAckSampled(JsonDocument& command);
+        void setGroups(JsonDocument& command);
+        void setSchedule(JsonDocument& command);
+        void sendSchedule();
+        void startPulse(JsonDocument& command);
+        void setTiming(JsonDocument& command);
+        void sendTiming();
+        void sendThrottled(uint32_t dropped);
         void processCommand(JsonDocument& command);
         void sendAck(const char* command, bool success, const char* state = nullptr);
-        void sendHello();
-        bool loadConfig();
-        bool saveConfig();
         bool loadRelayState();
         bool saveRelayState();
+        bool loadGroups();
+        bool saveGroups();
+        bool loadTiming();
+        bool saveTiming();
         String getCurrentTimestamp();
-        void handleReconnection();
         void setupLastWill();
 };
 
@@ -0,0 +1,103 @@
+#ifndef MQTT_SESSION_H
+#define MQTT_SESSION_H
+
+#include <Arduino.h>
+#ifdef ESP8266
+    #include <ESP8266WiFi.h>
+    #include <WiFiClientSecure.h>
+    #include <WiFiClientSecureBearSSL.h>
+#else
+    #include <WiFi.h>
+    #include <WiFiClientSecure.h>
+#endif
+#include <PubSubClient.h>
+#include <EEPROM.h>
+#include <ChronoLog.h>
+#include <vector>
+#include "MQTTConfig.h"
+#include "TopicRouter.h"
+#include "TimerWheel.h"
+
+// Owns the broker connection (TLS socket and PubSubClient) and lets any number
+// of controllers share it. Incoming publishes are dispatched through a
+// TopicRouter, subscriptions are replayed after every reconnect. The session
+// also owns the firmware's timer wheel, every controller on it schedules its
+// timed work there and loop() runs what is due.
+class MQTTSession {
+    public:
+        typedef std::function<void()> ConnectHandler;
+        typedef std::function<void(bool done)> DispatchHandler;
+
+        MQTTSession(const char* clientName = DEVICE_UUID);
+        ~MQTTSession();
+
+        MQTTSession(const MQTTSession&) = delete;
+        MQTTSession& operator=(const MQTTSession&) = delete;
+
+        void loop();
+        bool begin();
+        bool connect();
+        void disconnect();
+        bool isConnected();
+        bool hasInput();                        // Bytes from the broker not yet handled by loop()
+        void setLinkUp(bool up);                // From the connection manager, reconnects at once when the link is back
+        uint32_t nextDeadline(uint32_t limit);  // ms until loop() has timed work, at most limit
+
+        bool subscribe(const char* filter, TopicRouter::Handler handler, void* owner);
+        void unsubscribe(const char* filter, void* owner);
+        void detach(void* owner);
+        void onConnect(ConnectHandler handler, void* owner);
+        void onDispatch(DispatchHandler handler, void* owner); // Runs with false before and true after each routed publish
+        bool publish(const char* topic, const char* payload, bool retained = false);
+        bool setWill(const char* topic, const char* payload);
+
+        uint8_t allocateSlot();                 // Next controller EEPROM slot, MQTT_MAX_SLOTS once they run out
+        void setClientName(const char* name)    { clientName = name;    }
+        const String& getClientName() const     { return clientName;    }
+        TimerWheel& getTimers()                 { return timers;        }
+        void setBrokerConfig(const char* host, int port, bool useSSL = true);
+
+    private:
+        struct Subscription {
+            String              filter;
+            void*               owner;
+        };
+
+        struct ConnectListener {
+            ConnectHandler      handler;
+            void*               owner;
+        };
+
+        struct DispatchListener {
+            DispatchHandler     handler;
+            void*               owner;
+        };
+
+        int                             reconnectAttempts;
+        bool                            autoReconnect;
+        bool                            linkUp;                 // No reconnect attempts while WiFi is down
+        uint8_t                         slotCount;
+        String                          clientName;
+        String                          willTopic;
+        String                          willPayload;
+        MQTTConfig                      config;
+        TopicRouter                     router;
+        WiFiClient                      wifiClient;
+        ChronoLogger                    logger;
+        unsigned long                   lastReconnectAttempt;
+        PubSubClient*                   mqttClient;
+        TimerWheel                      timers;
+        TimerWheel::Timer               reconnectTimer;
+        WiFiClientSecure                wifiClientSecure;
+        std::vector<Subscription>       subscriptions;
+        std::vector<ConnectListener>    connectListeners;
+        std::vector<DispatchListener>   dispatchListeners;
+
+        void setupSSL();
+        bool loadConfig();
+        bool saveConfig();
+        void handleReconnection();
+        bool isSubscribed(const char* filter) const;
+};
+
+#endif // MQTT_SESSION_H
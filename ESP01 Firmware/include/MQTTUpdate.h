@@ -0,0 +1,70 @@
+#ifndef MQTT_UPDATE_H
+#define MQTT_UPDATE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <ChronoLog.h>
+#include <functional>
+#include <OTAGzipPeek.h>
+#include <OTAPatch.h>
+#include <OTAVerifier.h>
+#include "MQTTConfig.h"
+#include "MQTTSession.h"
+#include "TimerWheel.h"
+
+// Firmware update over the MQTT session. An "ota_begin" manifest opens a
+// transfer, numbered binary chunks follow on OTA_TOPIC_PREFIX<uuid> and are
+// written straight to the update partition. Progress acks carry the next
+// expected chunk, so the server keeps a window in flight and rewinds after a
+// gap; re-sending the manifest resumes a transfer after a reconnect. The last
+// chunk is only written once the SHA-256 of the whole image matches. With a
+// signing key set, the signature trailer is checked in the same pass and a
+// bad or missing one aborts the transfer before the update is installed.
+class MQTTUpdate {
+    public:
+        typedef std::function<void()> RestartHandler;
+
+        MQTTUpdate(MQTTSession& session, TimerWheel& timers);
+        ~MQTTUpdate();
+
+        void begin(const String& deviceUUID, RestartHandler onRestart);
+        bool handleCommand(const char* cmd, JsonDocument& command);    // false if cmd is not an OTA command
+
+        bool isActive() const                       { return active;    }
+
+    private:
+        bool                active;
+        bool                verified;
+        bool                autoReboot;
+        bool                gapReported;
+        uint8_t             sinceAck;
+        uint16_t            chunkSize;
+        uint32_t            imageSize;
+        uint32_t            written;
+        uint32_t            nextChunk;
+        String              transferId;
+        String              deviceUUID;
+        String              uplinkTopic;
+        String              chunkTopic;
+        uint8_t             expectedHash[OTA_PATCH_SHA256_SIZE];
+        OTASha256           hash;
+        OTAVerifier         signature;
+        ChronoLogger        logger;
+        MQTTSession&        session;
+        TimerWheel&         timers;
+        RestartHandler      onRestart;
+        TimerWheel::Timer   abandonTimer;
+        TimerWheel::Timer   rebootTimer;
+
+        void start(JsonDocument& manifest);
+        void handleChunk(const char* topic, byte* payload, unsigned int length);
+        void finish(const uint8_t* data, size_t len);
+        bool writeImage(const uint8_t* data, size_t len);
+        void abort(const char* reason);
+        void restart();
+        void report(const char* command, bool success, const char* error = nullptr);
+        static bool parseHash(const char* hex, uint8_t* digest);
+        static String updateError();
+};
+
+#endif // MQTT_UPDATE_H
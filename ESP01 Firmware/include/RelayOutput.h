@@ -0,0 +1,80 @@
+#ifndef RELAY_OUTPUT_H
+#define RELAY_OUTPUT_H
+
+#include <Arduino.h>
+#include <vector>
+
+#define RELAY_OUTPUT_MAX_CHANNELS   32
+
+// Relay output driver. Controllers write logical on/off per channel; the
+// driver maps that to physical levels (active-low inversion included) and
+// pushes every changed bit to the hardware in one transaction. Inside a
+// Batch, writes from any number of controllers are staged and flushed once.
+// Hardware backends live in RelayOutputDrivers.h, this header builds on the host.
+class RelayOutput {
+    public:
+        // Scope guard: outputs written while any Batch is alive commit when the outermost one ends
+        class Batch {
+            public:
+                Batch();
+                ~Batch();
+                Batch(const Batch&) = delete;
+                Batch& operator=(const Batch&) = delete;
+        };
+
+        RelayOutput(uint8_t channels, bool activeLow);
+        virtual ~RelayOutput();
+
+        RelayOutput(const RelayOutput&) = delete;
+        RelayOutput& operator=(const RelayOutput&) = delete;
+
+        bool begin();
+        void write(uint8_t channel, bool on);
+        bool read(uint8_t channel) const;
+        bool commit();
+
+        uint8_t channels() const                { return channelCount; }
+        uint32_t levels() const                 { return requested ^ inversion; }
+
+        static void commitAll();
+        static void beginBatch();               // Same as a Batch scope, for callers that can't hold one
+        static void endBatch();
+
+    protected:
+        virtual bool setup() = 0;
+        virtual bool apply(uint32_t levels, uint32_t changed) = 0;  // Every channel's level, backends write only what covers changed
+
+    private:
+        bool                started;
+        uint8_t             channelCount;
+        uint32_t            requested;
+        uint32_t            applied;
+        uint32_t            inversion;
+
+        static uint8_t                      batchDepth;
+        static std::vector<RelayOutput*>    pending;
+};
+
+// In-memory driver for host tests, records every bus transaction with its time
+class FakeRelayOutput : public RelayOutput {
+    public:
+        struct Transaction {
+            unsigned long   timeUs;
+            uint32_t        levels;
+            uint32_t        changed;
+        };
+
+        FakeRelayOutput(uint8_t channels = 8, bool activeLow = false);
+
+        const std::vector<Transaction>& transactions() const   { return log; }
+        void clear()                                            { log.clear(); }
+
+    protected:
+        bool setup() override;
+        bool apply(uint32_t levels, uint32_t changed) override;
+
+    private:
+        std::vector<Transaction> log;
+};
+
+#endif // RELAY_OUTPUT_H
@@ -0,0 +1,75 @@
+#ifndef RELAY_OUTPUT_DRIVERS_H
+#define RELAY_OUTPUT_DRIVERS_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include <SPI.h>
+#include "RelayOutput.h"
+
+#define RELAY_OUTPUT_SPI_CLOCK      10000000    // MCP23S17 is rated for 10 MHz
+
+// Direct GPIO, set and cleared through the output set/clear registers in
+// one write each. Pins outside the register bank fall back to digitalWrite.
+class GpioRelayOutput : public RelayOutput {
+    public:
+        GpioRelayOutput(uint8_t pin, bool activeLow = true);
+        GpioRelayOutput(const uint8_t* pins, uint8_t count, bool activeLow = true);
+
+    protected:
+        bool setup() override;
+        bool apply(uint32_t levels, uint32_t changed) override;
+
+    private:
+        uint8_t             pins[RELAY_OUTPUT_MAX_CHANNELS];
+};
+
+// Daisy-chained 74HC595s, 8 channels per chip, latched once per update that changes a channel
+class ShiftRegisterRelayOutput : public RelayOutput {
+    public:
+        ShiftRegisterRelayOutput(uint8_t dataPin, uint8_t clockPin, uint8_t latchPin, uint8_t chips = 1, bool activeLow = false);
+
+    protected:
+        bool setup() override;
+        bool apply(uint32_t levels, uint32_t changed) override;
+
+    private:
+        uint8_t             dataPin;
+        uint8_t             clockPin;
+        uint8_t             latchPin;
+        uint8_t             chips;
+};
+
+// PCF8574 (8 channels) or PCF8575 (16 channels) I2C expander, the bus must be started by the caller.
+// A PCF8575 update that leaves P1 alone sends one data byte.
+class Pcf857xRelayOutput : public RelayOutput {
+    public:
+        Pcf857xRelayOutput(TwoWire& wire, uint8_t address, uint8_t channels = 8, bool activeLow = true);
+
+    protected:
+        bool setup() override;
+        bool apply(uint32_t levels, uint32_t changed) override;
+
+    private:
+        TwoWire&            wire;
+        uint8_t             address;
+};
+
+// MCP23S17 SPI expander, 16 channels on ports A and B, only a port with a changed channel is written
+class Mcp23s17RelayOutput : public RelayOutput {
+    public:
+        Mcp23s17RelayOutput(SPIClass& spi, uint8_t csPin, uint8_t hardwareAddress = 0, bool activeLow = false);
+
+    protected:
+        bool setup() override;
+        bool apply(uint32_t levels, uint32_t changed) override;
+
+    private:
+        SPIClass&           spi;
+        uint8_t             csPin;
+        uint8_t             opcode;
+
+        void writeRegister(uint8_t reg, uint8_t value);
+        void writeRegisters(uint8_t reg, uint8_t first, uint8_t second);
+};
+
+#endif // RELAY_OUTPUT_DRIVERS_H
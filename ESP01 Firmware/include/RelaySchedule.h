@@ -0,0 +1,72 @@
+#ifndef RELAY_SCHEDULE_H
+#define RELAY_SCHEDULE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <EEPROM.h>
+#include <ChronoLog.h>
+#include <time.h>
+#include "MQTTConfig.h"
+#include "TimerWheel.h"
+
+#define SCHEDULE_RULE_EMPTY     0
+#define SCHEDULE_RULE_WEEKLY    1       // Fires at a minute of day on the days in the mask
+#define SCHEDULE_RULE_ONCE      2       // Fires once at a UTC epoch second, then is removed
+
+#define SCHEDULE_EEPROM_MAGIC   0x5C
+
+// 8 bytes per rule in flash
+struct ScheduleRule {
+    uint8_t  type;
+    uint8_t  days;                      // Weekday mask, bit 0 = Sunday (weekly rules)
+    uint8_t  state;                     // 1 = on, 0 = off
+    uint8_t  reserved;
+    uint32_t time;                      // Minute of day (weekly) or epoch seconds (one-shot)
+};
+
+struct ScheduleTable {
+    uint8_t       magic;
+    uint8_t       count;
+    uint16_t      reserved;
+    ScheduleRule  rules[MQTT_MAX_SCHEDULE_RULES];
+};
+
+static_assert(sizeof(ScheduleTable) <= MQTT_SCHEDULE_EEPROM_LEN, "Schedule table overflows its EEPROM slot");
+
+// Local relay automation: a compact rule table pushed over MQTT, persisted
+// per controller slot and armed on a TimerWheel, so schedules keep running
+// through broker outages without a server round trip.
+class RelaySchedule {
+    public:
+        typedef std::function<void(uint8_t rule, bool state)> ActionHandler;
+
+        RelaySchedule(TimerWheel& wheel);
+
+        void begin(uint8_t slot, ActionHandler handler);
+        bool set(JsonArray rules, String& error);
+        void clear();
+        void toJson(JsonArray rules) const;
+        size_t size() const;
+
+        static bool clockSynced();
+
+    private:
+        uint8_t             slot;
+        time_t              due[MQTT_MAX_SCHEDULE_RULES];
+        TimerWheel&         wheel;
+        ChronoLogger        logger;
+        ScheduleTable       table;
+        ActionHandler       onAction;
+        TimerWheel::Timer   timers[MQTT_MAX_SCHEDULE_RULES];
+        TimerWheel::Timer   resyncTimer;
+
+        bool load();
+        bool save();
+        void arm(uint8_t index);
+        void armAll();
+        void fire(uint8_t index);
+        static bool parseRule(JsonVariant source, ScheduleRule& rule, String& error);
+        static time_t nextOccurrence(const ScheduleRule& rule, time_t after);
+};
+
+#endif // RELAY_SCHEDULE_H
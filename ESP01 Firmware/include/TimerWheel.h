@@ -0,0 +1,73 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <Arduino.h>
+#include <functional>
+
+#define TIMER_WHEEL_LEVELS      4
+#define TIMER_WHEEL_SLOT_BITS   6
+#define TIMER_WHEEL_SLOTS       (1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_SLOT_MASK   (TIMER_WHEEL_SLOTS - 1)
+
+// Hierarchical timing wheel with a 1 ms tick. Timers are intrusive, so
+// scheduling and cancelling are O(1) and never allocate. Four levels of 64
+// slots cover ~4.6 hours directly; longer delays are parked in the top level
+// and re-cascaded until they are due.
+class TimerWheel {
+    public:
+        typedef std::function<void()> Callback;
+
+        class Timer {
+            public:
+                Timer() {}
+                Timer(Callback callback) : callback(callback) {}
+                ~Timer();
+
+                Timer(const Timer&) = delete;
+                Timer& operator=(const Timer&) = delete;
+
+                bool isActive() const           { return wheel != nullptr; }
+                uint32_t expiresAt() const      { return expires; }
+                void setCallback(Callback cb)   { callback = cb; }
+                void cancel();
+
+            private:
+                friend class TimerWheel;
+                Timer*          next        = nullptr;
+                Timer*          prev        = nullptr;
+                void*           slot        = nullptr;
+                TimerWheel*     wheel       = nullptr;
+                uint32_t        expires     = 0;
+                Callback        callback    = nullptr;
+        };
+
+        TimerWheel();
+        ~TimerWheel();
+
+        void begin(uint32_t now);
+        void schedule(Timer& timer, uint32_t delayMs);
+        void scheduleAt(Timer& timer, uint32_t expires);
+        void cancel(Timer& timer);
+        size_t advance(uint32_t now);
+
+        size_t size() const                     { return count; }
+        uint32_t now() const                    { return current; }
+        uint32_t nextDeadline(uint32_t limit) const;
+
+    private:
+        struct Slot {
+            Timer*          head = nullptr;
+        };
+
+        Slot                slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+        size_t              count;
+        uint32_t            current;
+        bool                started;
+
+        void link(Timer& timer);
+        void unlink(Timer& timer);
+        void cascade(uint8_t level);
+        static void push(Slot& slot, Timer& timer);
+};
+
+#endif // TIMER_WHEEL_H
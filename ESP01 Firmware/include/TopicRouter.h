@@ -0,0 +1,47 @@
+#ifndef TOPIC_ROUTER_H
+#define TOPIC_ROUTER_H
+
+#include <Arduino.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Routes incoming publishes to handlers through a trie keyed by topic level.
+// Filters follow MQTT syntax, so "+" matches one level and a trailing "#"
+// matches the remaining levels (including none). Handlers may add or remove
+// routes while a publish is dispatched; empty levels are pruned afterwards.
+class TopicRouter {
+    public:
+        typedef std::function<void(const char* topic, byte* payload, unsigned int length)> Handler;
+
+        bool add(const char* filter, Handler handler, void* owner);
+        void remove(void* owner);
+        void remove(const char* filter, void* owner);
+        size_t dispatch(const char* topic, byte* payload, unsigned int length);
+        bool empty() const { return root.children.empty() && root.routes.empty(); }
+
+    private:
+        struct Route {
+            Handler             handler;
+            void*               owner;
+        };
+
+        struct Node {
+            String                              level;
+            std::vector<Route>                  routes;
+            std::vector<std::unique_ptr<Node>>  children;
+        };
+
+        Node                root;
+        mutable uint8_t     dispatchDepth = 0;
+        mutable bool        prunePending  = false;
+
+        Node* findChild(Node& node, const char* level, size_t length, bool create);
+        void compact();
+        bool prune(Node& node);
+        void strip(Node& node, void* owner);
+        size_t match(const Node& node, const char* level, const char* topic, byte* payload, unsigned int length) const;
+        static size_t deliver(const std::vector<Route>& routes, const char* topic, byte* payload, unsigned int length);
+};
+
+#endif // TOPIC_ROUTER_H
@@ -36,9 +36,403 @@
  */
 
 #include "OTADash.h"
+#include "OTAPatch.h"
+#include "OTAFlashWriter.h"
+#include "OTAGzipPeek.h"
+#include "OTAVerifier.h"
+#include <new>
+
+#if defined(OTA_DASH_PLATFORM_ESP32)
+    #if __has_include(<esp32/rom/miniz.h>)
+        #include <esp32/rom/miniz.h>
+    #else
+        #include <rom/miniz.h>
+    #endif
+#endif
 
 OTADash* OTADash::instance = nullptr;
 
+/*
+ * Pre-gzipped pages and assets from WebPages.h, sent straight from flash. A
+ * matching If-None-Match is answered with an empty 304, so revisits cost a
+ * round trip and no page bytes.
+ */
+static void sendAsset(AsyncWebServerRequest *request, const OTADashAsset& asset) {
+    AsyncWebServerResponse *response;
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == asset.etag) {
+        response = request->beginResponse(304);
+    } else {
+        response = request->beginResponse(200, asset.type, asset.data, asset.length);
+        response->addHeader("Content-Encoding", "gzip");
+    }
+    response->addHeader("ETag", asset.etag);
+    response->addHeader("Cache-Control", asset.cacheControl);
+    request->send(response);
+}
+
+/*
+ * Templates are streamed: every TCP buffer is filled from the flash text and
+ * the slot values, found through the slot table generated with the page. Only
+ * the values live in RAM, whatever the page size, and there is no
+ * search-and-replace pass over the page.
+ */
+struct OTATemplateRender {
+    const OTADashTemplate*  page;
+    String                  values[OTA_DASH_FIELD_COUNT];
+};
+
+static size_t renderTemplate(const OTATemplateRender& render, uint8_t *buffer, size_t maxLen, size_t index) {
+    const OTADashTemplate& page = *render.page;
+    size_t written  = 0;
+    size_t start    = 0;                                                                                                // Output offset of the current part
+    size_t textPos  = 0;
+
+    auto emit = [&](const char* part, size_t len, bool inFlash) {
+        size_t at = index + written;
+        if (written < maxLen && at >= start && at < start + len) {
+            size_t n = std::min(len - (at - start), maxLen - written);
+            if (inFlash) {
+                memcpy_P(buffer + written, part + (at - start), n);
+            } else {
+                memcpy(buffer + written, part + (at - start), n);
+            }
+            written += n;
+        }
+        start += len;
+    };
+
+    for (uint8_t i = 0; i < page.slotCount && written < maxLen; i++) {
+        OTADashSlot slot;
+        memcpy_P(&slot, &page.slots[i], sizeof(slot));
+        emit(page.text + textPos, slot.offset - textPos, true);
+        const String& value = render.values[slot.field];
+        emit(value.c_str(), value.length(), false);
+        textPos = slot.offset;
+    }
+    emit(page.text + textPos, page.length - textPos, true);
+    return written;
+}
+
+static void sendTemplate(AsyncWebServerRequest *request, const OTADashTemplate& page, std::initializer_list<std::pair<OTADashField, String>> fields) {
+    auto render = std::make_shared<OTATemplateRender>();
+    render->page = &page;
+    for (const auto& field : fields) {
+        render->values[field.first] = field.second;
+    }
+
+    size_t length = page.length;
+    for (uint8_t i = 0; i < page.slotCount; i++) {
+        OTADashSlot slot;
+        memcpy_P(&slot, &page.slots[i], sizeof(slot));
+        length += render->values[slot.field].length();
+    }
+
+    request->send(request->beginResponse("text/html", length, [render](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {
+        return renderTemplate(*render, buffer, maxLen, index);
+    }));
+}
+
+/*
+ * Upload sink shared by both platforms. The first image bytes (after any gzip
+ * layer) decide between a full image, written as is, and a delta patch, which
+ * is applied against the running firmware on its way to flash.
+ */
+static OTAPatch*    deltaPatch      = nullptr;
+static OTAVerifier  imageVerifier;
+static bool         imageStarted    = false;
+static bool         uploadFailed    = false;
+static const char*  imageRejected   = nullptr;                                                                          // Why the first bytes were refused, if they were
+
+static bool flashWrite(const uint8_t* data, size_t len) {
+    return Update.write(const_cast<uint8_t*>(data), len) == len;
+}
+
+static bool writeFirmware(const uint8_t* data, size_t len) {
+    if (!imageStarted && len) {
+        imageStarted = true;
+        if (data[0] != 0xE9 && !OTAPatch::isPatch(data, len)) {
+            imageRejected = "Not a firmware image or delta patch";
+            return false;
+        }
+        if (OTAPatch::isPatch(data, len)) {
+            deltaPatch = new (std::nothrow) OTAPatch;
+            if (!deltaPatch) {
+                return false;
+            }
+            deltaPatch->begin(flashWrite);
+        }
+    }
+    return deltaPatch ? deltaPatch->write(data, len) : flashWrite(data, len);
+}
+
+static const char* uploadError() {
+    if (imageRejected) {
+        return imageRejected;
+    }
+    OTAVerifier::Status signature = imageVerifier.status();
+    if (signature != OTAVerifier::Status::OK && signature != OTAVerifier::Status::WRITE_FAILED) {
+        return imageVerifier.statusString();
+    }
+    return deltaPatch ? deltaPatch->statusString() : "Firmware write failed";
+}
+
+static void resetUpload() {
+    delete deltaPatch;
+    deltaPatch    = nullptr;
+    imageStarted  = false;
+    imageRejected = nullptr;
+}
+
+#if defined(OTA_DASH_PLATFORM_ESP32)
+/*
+ * Streaming gzip inflate for firmware uploads. The ROM inflater writes into a
+ * fixed wrapping window that doubles as the flash write buffer, so RAM use does
+ * not depend on the image size. The gzip trailer is not checked, the image
+ * itself is verified by Update.end().
+ */
+struct OTAInflater {
+    tinfl_decompressor  decompressor;
+    uint8_t             window[OTA_DASH_INFLATE_WINDOW];
+    size_t              windowPos;
+    size_t              total;
+    bool                done;
+};
+
+static OTAInflater* inflater = nullptr;
+
+static_assert((OTA_DASH_INFLATE_WINDOW & (OTA_DASH_INFLATE_WINDOW - 1)) == 0, "Inflate window must be a power of two");
+static_assert(OTA_DASH_INFLATE_WINDOW >= TINFL_LZ_DICT_SIZE, "Inflate window must cover the deflate dictionary");
+
+static bool startInflate() {
+    inflater = new (std::nothrow) OTAInflater;
+    if (!inflater) {
+        return false;
+    }
+    tinfl_init(&inflater->decompressor);
+    inflater->windowPos = 0;
+    inflater->total     = 0;
+    inflater->done      = false;
+    return true;
+}
+
+static void stopInflate() {
+    delete inflater;
+    inflater = nullptr;
+}
+
+static bool inflateChunk(const uint8_t* data, size_t len, bool final) {
+    while (!inflater->done) {
+        size_t inBytes  = len;
+        size_t outBytes = OTA_DASH_INFLATE_WINDOW - inflater->windowPos;
+        tinfl_status status = tinfl_decompress(&inflater->decompressor, data, &inBytes,
+                                               inflater->window, inflater->window + inflater->windowPos, &outBytes,
+                                               final ? 0 : TINFL_FLAG_HAS_MORE_INPUT);
+        data += inBytes;
+        len  -= inBytes;
+
+        if (outBytes && !writeFirmware(inflater->window + inflater->windowPos, outBytes)) {
+            return false;
+        }
+        inflater->windowPos = (inflater->windowPos + outBytes) & (OTA_DASH_INFLATE_WINDOW - 1);
+        inflater->total    += outBytes;
+
+        if (status == TINFL_STATUS_DONE) {
+            inflater->done = true;                                                                                      // Whatever follows is the gzip trailer
+        } else if (status == TINFL_STATUS_NEEDS_MORE_INPUT) {
+            return !final;
+        } else if (status != TINFL_STATUS_HAS_MORE_OUTPUT) {
+            return false;                                                                                               // Corrupt or truncated stream
+        }
+    }
+    return true;
+}
+#endif
+
+/*
+ * Both upload paths feed the same pipeline. Received data goes into the sector
+ * writer, whose sink checks the signature on the way (with a public key set),
+ * strips any gzip layer (ESP32) and hands the image to writeFirmware(). Only
+ * one upload at a time holds the update partition.
+ */
+static OTAFlashWriter flashWriter;
+
+static bool decodeImage(const uint8_t* data, size_t len, bool last) {
+    #if defined(OTA_DASH_PLATFORM_ESP32)
+        if (!imageStarted && !inflater) {
+            size_t header = OTAGzipPeek::headerLength(data, len);
+            if (header) {                                                                                               // Compressed image, inflate on the fly
+                if (!startInflate()) {
+                    return false;
+                }
+                data += header;
+                len  -= header;
+            }
+        }
+        return inflater ? inflateChunk(data, len, last) : (!len || writeFirmware(data, len));
+    #elif defined(OTA_DASH_PLATFORM_ESP8266)
+        // eboot expands gzip uploads after the reboot and boots whatever comes out, so a
+        // compressed patch (or anything but an image) must be refused before it is written
+        if (!imageStarted && len && OTAGzipPeek::headerLength(data, len)) {
+            imageStarted  = true;
+            imageRejected = OTAGzipPeek::compressedImageError(data, len);
+            return !imageRejected && flashWrite(data, len);
+        }
+        return !len || writeFirmware(data, len);
+    #endif
+}
+
+static bool imageSink(const uint8_t* data, size_t len, bool last) {
+    if (OTAVerifier::acceptsUnsigned()) {
+        return decodeImage(data, len, last);
+    }
+    if (!imageVerifier.write(data, len)) {
+        return false;
+    }
+    return !last || (imageVerifier.end() && decodeImage(nullptr, 0, true));                                            // A bad signature fails the upload before anything is installed
+}
+
+static void abandonImage() {
+    flashWriter.end();
+    if (Update.isRunning()) {
+        #if defined(OTA_DASH_PLATFORM_ESP32)
+            Update.abort();
+        #elif defined(OTA_DASH_PLATFORM_ESP8266)
+            Update.end(false);                                                                                          // Unfinished, so the updater discards it
+        #endif
+    }
+    #if defined(OTA_DASH_PLATFORM_ESP32)
+        stopInflate();
+    #endif
+    resetUpload();
+}
+
+static bool startImage() {
+    if (Update.isRunning() || flashWriter.active()) {
+        return false;                                                                                                   // Another upload or an MQTT transfer has the partition
+    }
+    resetUpload();
+    #if defined(OTA_DASH_PLATFORM_ESP32)
+        bool started = Update.begin(UPDATE_SIZE_UNKNOWN);                                                               // Inflated or patched images differ in size from the upload
+    #elif defined(OTA_DASH_PLATFORM_ESP8266)
+        bool started = Update.begin((ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000);
+    #endif
+    if (!started) {
+        Update.printError(Serial);
+        return false;
+    }
+    imageVerifier.begin([](const uint8_t* data, size_t len) {
+        return decodeImage(data, len, false);
+    });
+    if (!flashWriter.begin(imageSink)) {
+        abandonImage();
+        return false;
+    }
+    return true;
+}
+
+static const char* finishImage(const uint8_t* expectedHash) {                                                          // nullptr once the image is installed
+    uint8_t digest[OTA_PATCH_SHA256_SIZE];
+    flashWriter.digest(digest);
+
+    const char* error = nullptr;
+    if (expectedHash && memcmp(digest, expectedHash, sizeof(digest)) != 0) {
+        error = "Firmware checksum mismatch";
+    } else if (deltaPatch && !deltaPatch->end()) {                                                                      // Target hash checked before the image is accepted
+        error = uploadError();
+    } else if (!Update.end(true)) {
+        Update.printError(Serial);
+        error = "Firmware image rejected";
+    }
+    if (error) {
+        abandonImage();
+        return error;
+    }
+
+    flashWriter.end();
+    #if defined(OTA_DASH_PLATFORM_ESP32)
+        stopInflate();
+    #endif
+    resetUpload();
+    return nullptr;
+}
+
+/*
+ * Resumable uploads. The page sends the image in OTA_DASH_UPLOAD_CHUNK pieces,
+ * each with its offset and CRC-32, received straight into a free writer
+ * sector. A verified chunk is committed and acknowledged at once, the upload
+ * job writes it from the loop while the next chunk arrives. The offset
+ * reported back only covers verified chunks, so after a dropped link the page
+ * asks for it and carries on from there instead of starting over. The record
+ * is only touched under the upload lock, the handlers run on the async_tcp
+ * task and the upload job on the loop.
+ */
+struct OTAChunkedUpload {
+    uint32_t                size;
+    uint32_t                crc;                                                                                        // Whole image, recognises the upload when the page resumes
+    uint32_t                received;                                                                                   // Verified bytes, written or waiting in a sector
+    size_t                  chunkLen;                                                                                   // Bytes of the chunk being received
+    uint32_t                chunkCrc;                                                                                   // Of those bytes, taken as they arrive
+    AsyncWebServerRequest*  receiver;                                                                                   // Request whose body fills the free sector
+    uint8_t                 sha256[OTA_PATCH_SHA256_SIZE];
+    bool                    checkHash;
+    const char*             error;
+    bool                    done;
+    unsigned long           lastActivity;
+};
+
+static OTAChunkedUpload* chunked = nullptr;
+
+#if defined(OTA_DASH_PLATFORM_ESP32)
+    static std::mutex       chunkedMutex;
+    #define OTA_DASH_UPLOAD_LOCK()          std::lock_guard<std::mutex> uploadGuard(chunkedMutex)
+#else
+    #define OTA_DASH_UPLOAD_LOCK()
+#endif
+
+static_assert(OTA_DASH_UPLOAD_CHUNK == OTA_FLASH_SECTOR, "Upload chunks are received into writer sectors");
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t len) {                                            // Same CRC-32 as zlib, the page computes it too
+    crc = ~crc;
+    while (len--) {
+        crc ^= *data++;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static uint32_t uploadParam(AsyncWebServerRequest *request, const char* name) {
+    return request->hasParam(name) ? strtoul(request->getParam(name)->value().c_str(), nullptr, 10) : 0;
+}
+
+static bool parseSha256(const String& hex, uint8_t* digest) {
+    if (hex.length() != OTA_PATCH_SHA256_SIZE * 2) return false;
+
+    for (size_t i = 0; i < OTA_PATCH_SHA256_SIZE * 2; i++) {
+        char c = hex[i];
+        uint8_t nibble;
+        if (c >= '0' && c <= '9') {
+            nibble = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            nibble = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            nibble = c - 'A' + 10;
+        } else {
+            return false;
+        }
+        digest[i / 2] = (i & 1) ? (digest[i / 2] | nibble) : (nibble << 4);
+    }
+    return true;
+}
+
+static void releaseUpload() {                                                                                          // Gives the partition back, the record stays for the status query
+    if (!chunked->done && !chunked->error) {
+        abandonImage();
+    }
+    chunked->receiver = nullptr;
+}
+
 OTADash::OTADash(const char* ssid, const char* password, const char* custom_domain, const char* portal_title) : 
     customDomain        (String(custom_domain) + ".local"), 
     ssid                (ssid), 
@@ -46,7 +440,9 @@ OTADash::OTADash(const char* ssid, const char* password, const char* custom_doma
     portal_title        (portal_title),
     dnsServer           (std::make_unique<DNSServer>()),
     server              (std::make_unique<AsyncWebServer>(80)),
-    ws                  (std::make_unique<AsyncWebSocket>("/ws")) {
+    ws                  (std::make_unique<AsyncWebSocket>("/ws")),
+    logBuffer           (std::make_unique<OTALogBuffer>(OTA_DASH_LOG_BUFFER_SIZE, OTA_DASH_DEBUG_LOGS_MAX)),
+    scheduler           (std::make_unique<OTAScheduler>()) {
     instance = this;
 
     #if OTA_DASH_ENABLE_DEBUG_LOGS
@@ -75,9 +471,22 @@ OTADash::~OTADash() {
 }
 
 void OTADash::stop() {
-    #if defined(OTA_DASH_PLATFORM_ESP8266)   
-        clientHandlerTicker.detach();
-    #endif 
+    #if defined(OTA_DASH_PLATFORM_ESP32)
+        WiFi.removeEvent(wifiEventId);
+    #elif defined(OTA_DASH_PLATFORM_ESP8266)
+        stationUpHandler = stationDownHandler = apJoinHandler = nullptr;
+    #endif
+    for (uint8_t job = 0; job < OTA_DASH_JOB_COUNT; job++) {
+        scheduler->cancel(job);
+    }
+    {
+        OTA_DASH_UPLOAD_LOCK();
+        if (chunked) {
+            releaseUpload();
+            delete chunked;
+            chunked = nullptr;
+        }
+    }
     if (serverStarted) {
         ws->closeAll();
         server->end();
@@ -109,23 +518,133 @@ bool OTADash::writeEEPROM() {
     return success;
 }
 
-void OTADash::handleClient() {
+uint32_t OTADash::loop() {
+    return serverStarted ? scheduler->run(millis(), jobsPerLoop) : OTA_SCHEDULER_IDLE;
+}
+
+uint32_t OTADash::nextDeadline() const {
+    return serverStarted ? scheduler->nextDue(millis()) : OTA_SCHEDULER_IDLE;
+}
+
+static_assert(OTA_DASH_JOB_COUNT <= OTA_SCHEDULER_MAX_JOBS, "Scheduler too small for the portal jobs");
+
+/*
+ * Nothing is polled on a fixed tick. Each job is armed by the event that
+ * makes it necessary (a request, a WiFi event, a log line) and re-arms itself
+ * only while there is still something to do.
+ */
+void OTADash::setupJobs() {
+    scheduler->setJob(OTA_DASH_JOB_DNS,       [this]() { serviceDns();            });
+    scheduler->setJob(OTA_DASH_JOB_SCAN,      [this]() { pollWifiScan();          });
+    scheduler->setJob(OTA_DASH_JOB_PAIRING,   [this]() { handlePairingResult();   });
+    scheduler->setJob(OTA_DASH_JOB_RESTART,   []()     { restartDevice();         });
+    scheduler->setJob(OTA_DASH_JOB_LOG_FLUSH, [this]() { flushLogs();             });
+    scheduler->setJob(OTA_DASH_JOB_CLIENTS,   [this]() { serviceClients();        });
+    scheduler->setJob(OTA_DASH_JOB_STATION,   [this]() { checkStation();          });
+    scheduler->setJob(OTA_DASH_JOB_UPLOAD,    [this]() { serviceUpload();         });
+
+    #if defined(OTA_DASH_PLATFORM_ESP32)
+        WiFi.removeEvent(wifiEventId);
+        wifiEventId = WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+            switch (event) {
+                case ARDUINO_EVENT_WIFI_STA_GOT_IP:         onStationUp();                                      break;
+                case ARDUINO_EVENT_WIFI_STA_DISCONNECTED:   onStationDown();                                    break;
+                case ARDUINO_EVENT_WIFI_AP_STACONNECTED:    scheduler->schedule(OTA_DASH_JOB_DNS, 0);          break;
+                default:                                                                                        break;
+            }
+        });
+    #elif defined(OTA_DASH_PLATFORM_ESP8266)
+        stationUpHandler = WiFi.onStationModeGotIP([this](const WiFiEventStationModeGotIP&) {
+            onStationUp();
+        });
+        stationDownHandler = WiFi.onStationModeDisconnected([this](const WiFiEventStationModeDisconnected&) {
+            onStationDown();
+        });
+        apJoinHandler = WiFi.onSoftAPModeStationConnected([this](const WiFiEventSoftAPModeStationConnected&) {
+            scheduler->schedule(OTA_DASH_JOB_DNS, 0);
+        });
+    #endif
+
     if (currentMode == NetworkMode::ACCESS_POINT || currentMode == NetworkMode::DUAL) {
-        dnsServer->processNextRequest();
+        scheduler->schedule(OTA_DASH_JOB_DNS, 0);
     }
-    
-    if ((currentMode == NetworkMode::STATION || currentMode == NetworkMode::DUAL) 
-        && WiFi.status() != WL_CONNECTED && autoReconnect) {
-        handleNetworkFailure();
+    if ((currentMode == NetworkMode::STATION || currentMode == NetworkMode::DUAL) && WiFi.status() != WL_CONNECTED) {
+        onStationDown();
     }
-    
-    int scanResult = WiFi.scanComplete();
-    if (scanResult >= 0) {
-        handleWifiScanResult(scanResult);
+}
+
+void OTADash::serviceDns() {
+    dnsServer->processNextRequest();
+    if (WiFi.softAPgetStationNum() > 0) {                                                                           // Idle until a station joins the AP again
+        scheduler->schedule(OTA_DASH_JOB_DNS, OTA_DASH_DNS_INTERVAL);
     }
+}
 
-    if(pairRequest) {
-        handlePairingResult();
+void OTADash::requestScan() {
+    if (scanState == OTA_DASH_SCAN_IDLE) {                                                                          // A scan in progress already covers this request
+        scanState = OTA_DASH_SCAN_START;
+        scheduler->schedule(OTA_DASH_JOB_SCAN, 0);
+    }
+}
+
+void OTADash::pollWifiScan() {
+    switch (scanState) {
+        case OTA_DASH_SCAN_START:
+            otaLogger->debug("Wi-Fi scan started");
+            #if defined(OTA_DASH_PLATFORM_ESP8266)
+                WiFi.scanDelete();
+                if (currentMode == NetworkMode::ACCESS_POINT) WiFi.mode(WIFI_AP_STA);
+            #endif
+            WiFi.scanNetworks(true);
+            scanState = OTA_DASH_SCAN_RUNNING;
+            scheduler->schedule(OTA_DASH_JOB_SCAN, OTA_DASH_SCAN_POLL_INTERVAL);
+            break;
+
+        case OTA_DASH_SCAN_RUNNING: {
+            int scanResult = WiFi.scanComplete();
+            if (scanResult == WIFI_SCAN_RUNNING) {
+                scheduler->schedule(OTA_DASH_JOB_SCAN, OTA_DASH_SCAN_POLL_INTERVAL);
+            } else {
+                handleWifiScanResult(scanResult);
+            }
+            break;
+        }
+
+        case OTA_DASH_SCAN_STREAM:
+            streamScanResults();
+            break;
+
+        default:
+            break;
+    }
+}
+
+void OTADash::onStationUp() {
+    isWifiConnected = true;
+    reconnectCount = 0;
+    scheduler->cancel(OTA_DASH_JOB_STATION);
+}
+
+void OTADash::onStationDown() {
+    isWifiConnected = false;
+    if ((currentMode == NetworkMode::STATION || currentMode == NetworkMode::DUAL) && autoReconnect) {
+        scheduler->scheduleWithin(OTA_DASH_JOB_STATION, reconnectDelay);
+    }
+}
+
+void OTADash::checkStation() {
+    if (WiFi.status() == WL_CONNECTED) {
+        onStationUp();
+        return;
+    }
+    handleNetworkFailure();
+    scheduler->schedule(OTA_DASH_JOB_STATION, reconnectDelay);                                                      // Until the got-IP event cancels it
+}
+
+void OTADash::setPairRequest(bool request) {
+    pairRequest = request;
+    if (pairRequest) {
+        scheduler->schedule(OTA_DASH_JOB_PAIRING, 0);
     }
 }
 
@@ -189,28 +708,17 @@ void OTADash::begin(NetworkMode mode) {
 
         #if defined(OTA_DASH_PLATFORM_ESP32)
             try {
-                if (type == WS_EVT_DATA) {
-                    AwsFrameInfo *info = (AwsFrameInfo *)arg;
-                    if (info->opcode == WS_TEXT) {
-                        data[len] = 0;
-                        handleWebSocketMessage(arg, data, len);
-                    }
-                }
+                handleWebSocketEvent(client, type, arg, data, len);
             } catch (const std::exception &e) {
                 otaLogger->error("WebSocket error: {}", e.what());
             }
         #elif defined(OTA_DASH_PLATFORM_ESP8266)
-            if (type == WS_EVT_DATA) {
-                AwsFrameInfo *info = (AwsFrameInfo *)arg;
-                if (info->opcode == WS_TEXT) {
-                    data[len] = 0;
-                    handleWebSocketMessage(arg, data, len);
-                }
-            }
+            handleWebSocketEvent(client, type, arg, data, len);
         #endif
     });
 
     server->addHandler(ws.get());
+    cacheDeviceFacts();
     setupServer();
     server->begin();
     otaLogger->debug("Server started");
@@ -225,64 +733,142 @@ void OTADash::begin(NetworkMode mode) {
         otaLogger->debug(String("Access in the browser by: http://" + customDomain).c_str());
     }
     serverStarted = true;
-
-    #if defined(OTA_DASH_PLATFORM_ESP32)
-        xTaskCreatePinnedToCore(otaDashTask, "otaDashTask", 4096, instance, 1, &otaTaskHandle, 0);
-    #elif defined(OTA_DASH_PLATFORM_ESP8266)
-        clientHandlerTicker.attach_ms(100, [this]() { handleClientTick(); });
-        
-    #endif
+    setupJobs();
 }
 
+static_assert(OTA_DASH_LOG_FRAME_SIZE >= OTA_LOG_JSON_MAX + 40, "A log frame must hold the longest line");
+
 void OTADash::printDebug(const String& message) {
-    if (serverStarted && isOnDebugPage) {                                                                           // Replace escape sequences with HTML equivalents
-        
-        String formattedMessage = message;
-        formattedMessage.replace("\n", "<br/>");
-        formattedMessage.replace("\r", "");
-        formattedMessage.replace("\t", "&emsp;");
-
-        debugLogs += formattedMessage + "<br/>";
-        debugLogsCounter++;
-        
-        #if defined(OTA_DASH_PLATFORM_ESP32)
-        try {
-            ws->textAll(formattedMessage);                                                                          // Send the formatted message to all WebSocket clients
-        } catch (const std::exception& e) {
-            otaLogger->error("Debug print error: {}", e.what());
+    logBuffer->push(message.c_str(), message.length());                                                             // Kept even with no viewer, the debug page fetches the backlog
+    scheduler->scheduleWithin(OTA_DASH_JOB_LOG_FLUSH, OTA_DASH_LOG_FLUSH_INTERVAL);                                 // Lines arriving meanwhile go out in the same frame
+}
+
+void OTADash::flushLogs() {
+    if (!serverStarted) {
+        return;
+    }
+
+    std::unique_ptr<char[]> frame;
+    uint32_t frameFrom = 0, frameSeq = 0;                                                                           // Last frame built, reused by clients at the same cursor
+    uint16_t frameCount = 0;
+    size_t frameLen = 0;
+    uint32_t next = logBuffer->nextSeq();
+
+    for (OTADashClient& slot : wsClients) {
+        if (!slot.id || !slot.logs) {
+            continue;
         }
-        #elif defined(OTA_DASH_PLATFORM_ESP8266)
-            ws->textAll(formattedMessage);                                                                          // Send the formatted message to all WebSocket clients
-        #endif
+        AsyncWebSocketClient *client = ws->client(slot.id);
+        if (!client) {
+            continue;
+        }
+
+        for (int frames = 0; frames < 4 && slot.logCursor != next; frames++) {                                      // A few frames per flush so a burst catches up
+            if (client->queueLen() >= OTA_DASH_WS_QUEUE_MAX) {
+                break;                                                                                              // Its oldest lines get overwritten meanwhile, counted once it catches up
+            }
+
+            if (!frame || !frameCount || frameFrom != slot.logCursor) {
+                if (!frame) {
+                    frame.reset(new char[OTA_DASH_LOG_FRAME_SIZE]);
+                }
+                frameFrom = frameSeq = slot.logCursor;
+                frameLen = strlen("{\"logs\":[");
+                memcpy(frame.get(), "{\"logs\":[", frameLen);
+                frameLen += logBuffer->writeJson(frameSeq, frameCount, frame.get() + frameLen, OTA_DASH_LOG_FRAME_SIZE - frameLen - 24);
+                if (!frameCount) {
+                    break;
+                }
+                frameLen += snprintf(frame.get() + frameLen, 24, "],\"seq\":%lu}", (unsigned long)frameSeq);    // First line sent, past the cursor if lines were overwritten
+            }
 
-        if (debugLogsCounter >= debugLogsMax) {
-            debugLogs = "";
-            debugLogsCounter = 0;
+            slot.dropped += frameSeq - slot.logCursor;
+            slot.logCursor = frameSeq + frameCount;
+            slot.sent++;
+            client->text(frame.get(), frameLen);
+        }
+
+        if (slot.logCursor != next) {                                                                               // Queue full or a long burst, try again next interval
+            scheduler->scheduleWithin(OTA_DASH_JOB_LOG_FLUSH, OTA_DASH_LOG_FLUSH_INTERVAL);
         }
     }
 }
 
-String OTADash::encryptionTypeToString(int encryptionType) {                                                                                              // Helper function to convert encryption type to a string
-    #if defined(OTA_DASH_PLATFORM_ESP32)
-    switch (encryptionType) {
-        case WIFI_AUTH_OPEN: return "Open";
-        case WIFI_AUTH_WEP: return "WEP";
-        case WIFI_AUTH_WPA_PSK: return "WPA";
-        case WIFI_AUTH_WPA2_PSK: return "WPA2";
-        case WIFI_AUTH_WPA_WPA2_PSK: return "WPA/WPA2";
-        case WIFI_AUTH_WPA3_PSK: return "WPA3";
-        default: return "Unknown";
+void OTADash::sendAll(const String& message) {
+    sendAll(message.c_str(), message.length());
+}
+
+void OTADash::sendAll(const char* message, size_t len) {
+    for (OTADashClient& slot : wsClients) {
+        if (!slot.id) {
+            continue;
+        }
+        AsyncWebSocketClient *client = ws->client(slot.id);
+        if (!client) {
+            continue;
+        }
+        if (client->queueLen() >= OTA_DASH_WS_QUEUE_MAX) {                                                          // Not reading, don't queue more for it
+            slot.dropped++;
+            continue;
+        }
+        slot.sent++;
+        client->text(message, len);
     }
-    #elif defined(OTA_DASH_PLATFORM_ESP8266)
-        switch (encryptionType) {
-            case ENC_TYPE_WEP:  return "WEP";
-            case ENC_TYPE_TKIP: return "WPA";
-            case ENC_TYPE_CCMP: return "WPA2";
-            case ENC_TYPE_NONE: return "Open";
-            case ENC_TYPE_AUTO: return "Auto";
-            default: return "Unknown";
+}
+
+/*
+ * Every WebSocket client gets a slot, up to OTA_DASH_WS_MAX_CLIENTS. Sends
+ * skip a client whose queue is full, so a stalled tab can't hold more than a
+ * few frames of heap, and clients that stop answering pings are closed.
+ */
+void OTADash::serviceClients() {
+    ws->cleanupClients(OTA_DASH_WS_MAX_CLIENTS);
+    bool connected = false;
+
+    for (OTADashClient& slot : wsClients) {
+        if (!slot.id) {
+            continue;
         }
-    #endif
+        AsyncWebSocketClient *client = ws->client(slot.id);
+        if (!client || client->status() != WS_CONNECTED) {
+            slot = OTADashClient{};
+        } else if (millis() - slot.lastSeen > OTA_DASH_WS_IDLE_TIMEOUT) {
+            otaLogger->debug("Closing idle WebSocket client %lu", (unsigned long)slot.id);
+            wsEvicted++;
+            slot = OTADashClient{};
+            client->close(1001, "idle");
+        } else {
+            connected = true;
+        }
+    }
+
+    if (connected) {
+        scheduler->schedule(OTA_DASH_JOB_CLIENTS, OTA_DASH_WS_SERVICE_INTERVAL);
+    }
+}
+
+bool OTADash::hasHeadroom(size_t extra) const {
+    return !heapReserve || ESP.getFreeHeap() >= heapReserve + extra;
+}
+
+bool OTADash::admit(AsyncWebServerRequest *request) {
+    if (hasHeadroom()) {
+        return true;
+    }
+    busyRejected++;                                                                                                 // The application's share of the heap comes first
+    AsyncWebServerResponse *response = request->beginResponse(503, "text/plain", "Busy, try again shortly");
+    response->addHeader("Retry-After", OTA_DASH_BUSY_RETRY);
+    request->send(response);
+    return false;
+}
+
+OTADashClient* OTADash::findClient(uint32_t id) {
+    for (OTADashClient& slot : wsClients) {
+        if (slot.id == id) {
+            return &slot;
+        }
+    }
+    return nullptr;
 }
 
 void OTADash::disconnectWifi() {
@@ -296,6 +882,10 @@ bool OTADash::connectToWifi(const char* ssid, const char* password, uint32_t tim
         otaLogger->warn("Cannot connect to WiFi in AP-only mode");
         return false;
     }
+    if (WiFi.status() == WL_CONNECTED && WiFi.SSID() == ssid) {                                                     // Joined by the application already, reconnecting would drop its sessions
+        otaLogger->debug("Already connected to WiFi");
+        return true;
+    }
 
     WiFi.begin(ssid, password);
     
@@ -314,6 +904,29 @@ bool OTADash::connectToWifi(const char* ssid, const char* password, uint32_t tim
     return true;
 }
 
+void OTADash::cacheDeviceFacts() {
+    JsonDocument facts;                                                                                             // Fixed for the life of the firmware, getFreeSketchSpace() alone is slow on ESP8266
+    facts["product"]            = productName;
+    facts["firmware"]           = firmwareVersion;
+    #if defined(OTA_DASH_PLATFORM_ESP32)
+        facts["chip_model"]     = ESP.getChipModel();
+        facts["chip_cores"]     = ESP.getChipCores();
+        facts["chip_revision"]  = ESP.getChipRevision();
+        facts["heap_size"]      = ESP.getHeapSize();
+        facts["psram_size"]     = ESP.getPsramSize();
+    #elif defined(OTA_DASH_PLATFORM_ESP8266)
+        facts["chip_id"]        = String(ESP.getChipId(), HEX);
+    #endif
+    facts["cpu_mhz"]            = ESP.getCpuFreqMHz();
+    facts["flash_size"]         = ESP.getFlashChipSize();
+    facts["flash_speed"]        = ESP.getFlashChipSpeed();
+    facts["sketch_size"]        = ESP.getSketchSize();
+    facts["free_sketch_space"]  = ESP.getFreeSketchSpace();
+
+    deviceFacts = String();
+    serializeJson(facts, deviceFacts);
+}
+
 void OTADash::setupServer() {
     server->onNotFound([](AsyncWebServerRequest *request) {
         if (request->method() == HTTP_OPTIONS) {
@@ -327,61 +940,101 @@ void OTADash::setupServer() {
         request->send(404, "text/plain", "Not Found");
     });
 
+    server->on(OTA_DASH_PORTAL_CSS, HTTP_GET, [this](AsyncWebServerRequest *request){
+        if (!admit(request)) return;
+        sendAsset(request, portal_css);
+    });
+
     server->on("/", HTTP_GET, [this](AsyncWebServerRequest *request){
-        isOnDebugPage = false;
-        String html = index_html;
-        html.replace("%PORTAL_HEADING%", portal_title);
-        html.replace("%CUSTOM_DOMAIN%", customDomain);
-        request->send(200, "text/html", html.c_str());
+        if (!admit(request)) return;
+        sendTemplate(request, index_html, {{OTA_DASH_FIELD_PORTAL_HEADING, portal_title}, {OTA_DASH_FIELD_CUSTOM_DOMAIN, customDomain}});
     });
 
     server->on("/info", HTTP_GET, [this](AsyncWebServerRequest *request){
-        String infoHtml = device_info_html;
-        String deviceInfo;
-        deviceInfo =  "<tr><td>Product Name</td><td>"               + productName                                       + "</td></tr>";
-        deviceInfo += "<tr><td>Firmware Version</td><td>"           + firmwareVersion                                   + "</td></tr>";
-        #if defined(OTA_DASH_PLATFORM_ESP32)
-            deviceInfo +=  "<tr><td>Chip Model</td><td>"            + String(ESP.getChipModel())                        + "</td></tr>";
-            deviceInfo += "<tr><td>Chip Cores</td><td>"             + String(ESP.getChipCores())                        + "</td></tr>";
-            deviceInfo += "<tr><td>Chip Revision</td><td>"          + String(ESP.getChipRevision())                     + "</td></tr>";
-            deviceInfo += "<tr><td>CPU Frequency</td><td>"          + String(ESP.getCpuFreqMHz())                       + " MHz</td></tr>";
-            deviceInfo += "<tr><td>Chip Temperature</td><td>"       + String(temperatureRead())                         + " °C</td></tr>";
-        #elif defined(OTA_DASH_PLATFORM_ESP8266)
-            deviceInfo +=  "<tr><td>Chip ID</td><td>"               + String(ESP.getChipId())                           + "</td></tr>";
-            deviceInfo += "<tr><td>CPU Frequency</td><td>"          + String(ESP.getCpuFreqMHz())                       + " MHz</td></tr>";
-        #endif
-        deviceInfo += "<tr><td>Access Point SSID</td><td>"          + WiFi.softAPSSID()                                 + "</td></tr>";
-        deviceInfo += "<tr><td>Access Point IP Address</td><td>"    + WiFi.softAPIP().toString()                        + "</td></tr>";
-        deviceInfo += "<tr><td>Connected Clients</td><td>"          + String(WiFi.softAPgetStationNum())                + "</td></tr>";
-        deviceInfo += "<tr><td>Flash Size</td><td>"                 + String(ESP.getFlashChipSize() / (1024 * 1024))    + " MB</td></tr>";
-        deviceInfo += "<tr><td>Flash Speed</td><td>"                + String(ESP.getFlashChipSpeed() / 1000000)         + " MHz</td></tr>";
-        deviceInfo += "<tr><td>Sketch Size</td><td>"                + String(ESP.getSketchSize() / (1024 * 1024))       + " MB</td></tr>";
-        deviceInfo += "<tr><td>Free Sketch Space</td><td>"          + String(ESP.getFreeSketchSpace() / (1024 * 1024))  + " MB</td></tr>";
+        if (!admit(request)) return;
+        sendAsset(request, info_html);                                                                              // Rendered by the browser from /api/info
+    });
+
+    server->on("/api/info", HTTP_GET, [this](AsyncWebServerRequest *request){
+        if (!admit(request)) return;
+        if (deviceFacts.isEmpty()) {
+            cacheDeviceFacts();
+        }
+
+        JsonDocument status;                                                                                        // Only what changes between polls, all cheap to sample
+        status["uptime"]            = millis() / 1000;
+        status["free_heap"]         = ESP.getFreeHeap();
         #if defined(OTA_DASH_PLATFORM_ESP32)
-            deviceInfo += "<tr><td>Heap Size</td><td>"              + String(ESP.getHeapSize() / (1024 * 1024))         + " MB</td></tr>";
-            deviceInfo += "<tr><td>Free Heap</td><td>"              + String(ESP.getFreeHeap() / (1024 * 1024))         + " MB</td></tr>";
-            deviceInfo += "<tr><td>PSRAM Size</td><td>"             + String(ESP.getPsramSize() / (1024 * 1024))        + " MB</td></tr>";
-            deviceInfo += "<tr><td>Free PSRAM</td><td>"             + String(ESP.getFreePsram() / (1024 * 1024))        + " MB</td></tr>";
+            status["max_free_block"]    = ESP.getMaxAllocHeap();
+            status["free_psram"]        = ESP.getFreePsram();
+            status["temperature"]       = temperatureRead();
         #elif defined(OTA_DASH_PLATFORM_ESP8266)
-            deviceInfo += "<tr><td>Free Heap</td><td>"              + String(ESP.getFreeHeap() / 1024)                  + " KB</td></tr>";
+            status["max_free_block"]    = ESP.getMaxFreeBlockSize();
+            status["heap_fragmentation"] = ESP.getHeapFragmentation();
         #endif
-        deviceInfo += "<tr><td>Uptime</td><td>"                     + String(millis() / 1000)                           + " seconds</td></tr>";
+        if (WiFi.getMode() & WIFI_AP) {
+            status["ap_ssid"]       = WiFi.softAPSSID();
+            status["ap_ip"]         = WiFi.softAPIP().toString();
+            status["ap_clients"]    = WiFi.softAPgetStationNum();
+        }
+        if (WiFi.status() == WL_CONNECTED) {
+            status["station_ip"]    = WiFi.localIP().toString();
+            status["rssi"]          = WiFi.RSSI();
+        }
 
-        infoHtml.replace("%DEVICE_INFO%", deviceInfo);
-        request->send(200, "text/html", infoHtml.c_str());
+        JsonArray clients = status["ws_clients"].to<JsonArray>();                                                  // Queue depth per portal viewer
+        for (const OTADashClient& slot : wsClients) {
+            AsyncWebSocketClient *client = slot.id ? ws->client(slot.id) : nullptr;
+            if (!client) {
+                continue;
+            }
+            JsonObject entry = clients.add<JsonObject>();
+            entry["id"]             = slot.id;
+            entry["queue"]          = client->queueLen();
+            entry["sent"]           = slot.sent;
+            entry["dropped"]        = slot.dropped;
+            entry["idle"]           = (millis() - slot.lastSeen) / 1000;
+        }
+        status["ws_rejected"]       = wsRejected;
+        status["ws_evicted"]        = wsEvicted;
+        if (heapReserve) {
+            status["heap_reserve"]  = heapReserve;
+            status["busy_rejected"] = busyRejected;
+        }
+
+        AsyncResponseStream *response = request->beginResponseStream("application/json", 256);
+        response->addHeader("Cache-Control", "no-store");
+        response->print("{\"device\":");
+        response->print(deviceFacts);
+        response->print(",\"status\":");
+        serializeJson(status, *response);
+        response->print('}');
+        request->send(response);
     });
 
     server->on("/wifimanage", HTTP_GET, [this](AsyncWebServerRequest *request) {
-        otaLogger->debug("Wi-Fi scan requested");
-        #if defined(OTA_DASH_PLATFORM_ESP32)
-            WiFi.scanNetworks(true);
-        #elif defined(OTA_DASH_PLATFORM_ESP8266)
-            WiFi.scanDelete();
-            if (currentMode == NetworkMode::ACCESS_POINT) WiFi.mode(WIFI_AP_STA);
-            WiFi.scanNetworks(true);
-        #endif
-        String html = wifi_manage_html;
-        request->send(200, "text/html", html.c_str());
+        if (!admit(request)) return;
+        sendAsset(request, wifimanage_html);                                                                        // The page asks /api/networks, a reload no longer rescans
+    });
+
+    server->on("/api/networks", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        if (!admit(request)) return;
+        bool fresh = scannedAt && millis() - scannedAt < OTA_DASH_SCAN_TTL;
+        if (!fresh || request->hasParam("refresh")) {
+            requestScan();                                                                                          // Results follow over the WebSocket
+        }
+
+        JsonDocument doc;
+        writeNetworks(doc["networks"].to<JsonArray>(), 0, networkCount);
+        if (scannedAt) {
+            doc["age"]      = (millis() - scannedAt) / 1000;
+        }
+        doc["scanning"]     = scanState != OTA_DASH_SCAN_IDLE;
+
+        AsyncResponseStream *response = request->beginResponseStream("application/json", 512);
+        response->addHeader("Cache-Control", "no-store");
+        serializeJson(doc, *response);
+        request->send(response);
     });
 
     server->on("/save-wifi", HTTP_POST, [this](AsyncWebServerRequest *request) {
@@ -412,7 +1065,7 @@ void OTADash::setupServer() {
                 strcpy(networkCredentials.setuped, "true");
                 writeEEPROM();
                 request->send(200, "text/plain", "Missing Saving Callback");
-                ESP.restart();
+                scheduler->schedule(OTA_DASH_JOB_RESTART, OTA_DASH_RESTART_DELAY);
             }
             
         } else {
@@ -421,17 +1074,40 @@ void OTADash::setupServer() {
     });
 
     server->on("/update", HTTP_GET, [this](AsyncWebServerRequest *request){
-        String html = update_firmware_html;
-        request->send(200, "text/html", html.c_str());
+        if (!admit(request)) return;
+        sendAsset(request, update_html);
     });
 
     server->on("/update", HTTP_POST, [](AsyncWebServerRequest *request){
         handleUpdate(request);
     }, handleUpload);
 
+    server->on("/api/upload/begin", HTTP_POST, [this](AsyncWebServerRequest *request){
+        beginUpload(request);
+    });
+
+    server->on("/api/upload/chunk", HTTP_POST, [this](AsyncWebServerRequest *request){
+        commitChunk(request);
+    }, nullptr, [this](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
+        receiveChunk(request, data, len, index, total);
+    });
+
+    server->on("/api/upload/status", HTTP_GET, [this](AsyncWebServerRequest *request){
+        OTA_DASH_UPLOAD_LOCK();
+        sendUploadStatus(request, chunked ? 200 : 404);
+    });
+
+    server->on("/api/upload/abort", HTTP_POST, [this](AsyncWebServerRequest *request){
+        OTA_DASH_UPLOAD_LOCK();
+        if (chunked && !chunked->done && !chunked->error) {
+            abortUpload("Upload cancelled");
+        }
+        sendUploadStatus(request, 200);
+    });
+
     server->on("/erase", HTTP_GET, [this](AsyncWebServerRequest *request){
-        String html = erase_settings_html;
-        request->send(200, "text/html", html.c_str());
+        if (!admit(request)) return;
+        sendAsset(request, erase_html);
     });
 
     server->on("/erase", HTTP_POST, [this](AsyncWebServerRequest *request){
@@ -443,39 +1119,79 @@ void OTADash::setupServer() {
     });
 
     server->on("/debug", HTTP_GET, [this](AsyncWebServerRequest *request){
-        String html = debug_html;
-        isOnDebugPage = true;
-        html.replace("%PORTAL_HEADING%", portal_title);
-        request->send(200, "text/html", html.c_str());
+        if (!admit(request)) return;
+        sendTemplate(request, debug_html, {{OTA_DASH_FIELD_PORTAL_HEADING, portal_title}});
+    });
+
+    server->on("/api/logs", HTTP_GET, [this](AsyncWebServerRequest *request){
+        if (!admit(request)) return;
+        struct Backlog { uint32_t seq; uint32_t first; uint32_t lines; bool done; };
+        auto backlog = std::make_shared<Backlog>(Backlog{logBuffer->firstSeq(), 0, 0, false});
+        OTALogBuffer* logs = logBuffer.get();
+
+        AsyncWebServerResponse *response = request->beginChunkedResponse("application/json",
+            [backlog, logs](uint8_t *buffer, size_t maxLen, size_t index) -> size_t {              // {"logs":["...",...],"seq":<first line>}
+                char* out = reinterpret_cast<char*>(buffer);
+                if (backlog->done) {
+                    return 0;
+                }
+                if (maxLen < 32) {
+                    return RESPONSE_TRY_AGAIN;
+                }
+
+                size_t len = 0;
+                if (!index) {
+                    len = strlen("{\"logs\":[");
+                    memcpy(out, "{\"logs\":[", len);
+                }
+
+                if (backlog->seq != logs->nextSeq()) {
+                    size_t comma = backlog->lines ? 1 : 0;
+                    uint32_t seq = backlog->seq;
+                    uint16_t count = 0;
+                    size_t written = logs->writeJson(seq, count, out + len + comma, maxLen - len - comma);
+                    if (!count) {
+                        return len ? len : RESPONSE_TRY_AGAIN;                                                      // Next line needs a bigger buffer
+                    }
+                    if (!backlog->lines) {
+                        backlog->first = seq;
+                    }
+                    if (comma) {
+                        out[len] = ',';
+                    }
+                    backlog->seq = seq + count;
+                    backlog->lines += count;
+                    return len + comma + written;
+                }
+
+                backlog->done = true;
+                if (!backlog->lines) {
+                    backlog->first = backlog->seq;
+                }
+                return len + snprintf(out + len, maxLen - len, "],\"seq\":%lu}", (unsigned long)backlog->first);
+            });
+        response->addHeader("Cache-Control", "no-store");
+        request->send(response);
     });
 
     server->on("/restart", HTTP_GET, [this](AsyncWebServerRequest *request){
-        String html = restart_device_html;
-        request->send(200, "text/html", html.c_str());
+        if (!admit(request)) return;
+        sendAsset(request, restart_html);
     });
 
     server->on("/restart", HTTP_POST, [this](AsyncWebServerRequest *request){
         request->send(200, "text/html", "Device is restarting...<br/>Please wait a moment.");
-        #if defined(OTA_DASH_PLATFORM_ESP32)
-            vTaskDelay(1000);
-        #elif defined(OTA_DASH_PLATFORM_ESP8266)
-            delay(1000);
-        #endif
-        ESP.restart();
+        scheduler->schedule(OTA_DASH_JOB_RESTART, OTA_DASH_RESTART_DELAY);                                         // Restarting here would cut the response off
     });
 
     server->on("/generate_204", HTTP_GET, [this](AsyncWebServerRequest *request){
-        String html = index_html;
-        html.replace("%PORTAL_HEADING%", portal_title);
-        html.replace("%CUSTOM_DOMAIN%", customDomain);
-        request->send(200, "text/html", html.c_str());
+        if (!admit(request)) return;
+        sendTemplate(request, index_html, {{OTA_DASH_FIELD_PORTAL_HEADING, portal_title}, {OTA_DASH_FIELD_CUSTOM_DOMAIN, customDomain}});
     });
 
     server->on("/fwlink", HTTP_GET, [this](AsyncWebServerRequest *request){
-        String html = index_html;
-        html.replace("%PORTAL_HEADING%", portal_title);
-        html.replace("%CUSTOM_DOMAIN%", customDomain);
-        request->send(200, "text/html", html.c_str());
+        if (!admit(request)) return;
+        sendTemplate(request, index_html, {{OTA_DASH_FIELD_PORTAL_HEADING, portal_title}, {OTA_DASH_FIELD_CUSTOM_DOMAIN, customDomain}});
     });
 
     server->on("/pair", HTTP_OPTIONS, [](AsyncWebServerRequest *request){
@@ -558,7 +1274,7 @@ bool OTADash::startDualMode() {
     bool result;
     WiFi.mode(WIFI_AP_STA);
     result = WiFi.softAP(String(ssid + String("_AP")).c_str(), password);
-    if (!connectToWifi(ssid, password)) {
+    if (!connectToWifi(networkCredentials.ssid, networkCredentials.password)) {                                     // ssid/password are the portal's own AP
         otaLogger->error("Failed to connect in Dual mode");
         return false;
     }
@@ -572,11 +1288,11 @@ bool OTADash::startAccessPoint() {
 
 void OTADash::reconnectWifi() {
     disconnectWifi();
-    connectToWifi(ssid, password, 5000);
+    WiFi.begin(networkCredentials.ssid, networkCredentials.password);                                               // Not waited for, the got-IP event reports success
 }
 
 void OTADash::handleUpdate(AsyncWebServerRequest *request) {
-    bool hasError = Update.hasError();
+    bool hasError = Update.hasError() || uploadFailed;
     int statusCode = hasError ? 500 : 200;                                                // Return 500 on update error
     AsyncWebServerResponse *response = request->beginResponse(
         statusCode,
@@ -586,64 +1302,236 @@ void OTADash::handleUpdate(AsyncWebServerRequest *request) {
     response->addHeader("Connection", "close");
     request->send(response);
 
-    #if defined(OTA_DASH_PLATFORM_ESP32)
-        xTaskCreate([](void *param) {
-            vTaskDelay(pdMS_TO_TICKS(2000));
-            ESP.restart();
-            vTaskDelete(NULL);
-        }, "ota_restart", 2048, NULL, 1, NULL);
-    #elif defined(OTA_DASH_PLATFORM_ESP8266)
-        // Use a simple delay for ESP8266
-        delay(2000);
-        ESP.restart();
-    #endif
+    if (instance) {
+        instance->scheduler->schedule(OTA_DASH_JOB_RESTART, OTA_DASH_UPDATE_RESTART_DELAY);
+    }
+}
+
+void OTADash::restartDevice() {
+    if (instance && instance->restartCallback) {                                                                    // Let the application flush pending state first
+        instance->restartCallback();
+    }
+    ESP.restart();
 }
 
 void OTADash::handleUpload(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final) {
-    #if defined(OTA_DASH_PLATFORM_ESP32)
-        try {
-            if (!index) {
-                instance->otaLogger->debug("Update Start: %s\n", filename.c_str());
-                if (!Update.begin(UPDATE_SIZE_UNKNOWN)) { 
-                    Update.printError(Serial);
-                }
-            }
-            if (!Update.hasError()) {
-                if (Update.write(data, len) != len) {
-                    // Update.printError(Serial);
-                }
-            }
-            if (final) {
-                if (Update.end(true)) {
-                    instance->otaLogger->debug("Update Success: %u B\n", index + len);
-                } else {
-                    // Update.printError(Serial);
-                }
-            }
-        } catch (const std::exception& e) {
-            otaLogger->error("Update error: {}", e.what());
+    if (!index) {
+        instance->otaLogger->debug("Update Start: %s\n", filename.c_str());
+        uploadFailed = !instance->hasHeadroom(OTA_FLASH_WRITER_SECTORS * OTA_FLASH_SECTOR) || !startImage();
+        if (uploadFailed) {
+            instance->otaLogger->error("Cannot start firmware update");
         }
-    #elif defined(OTA_DASH_PLATFORM_ESP8266)
-        if (!index) {
-            instance->otaLogger->debug("Update Start: %s\n", filename.c_str());
-            uint32_t maxSketchSpace = (ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000;
-            if (!Update.begin(maxSketchSpace)) {
-                Update.printError(Serial);
-            }
+    }
+    if (uploadFailed) return;
+
+    // Sectors are written from loop(), only when all are still waiting does the upload write one itself
+    while (len) {
+        size_t taken = flashWriter.write(data, len);
+        data += taken;
+        len  -= taken;
+        if (!taken && (!flashWriter.pending() || !flashWriter.service())) {
+            break;
         }
-        if (!Update.hasError()) {
-            if (Update.write(data, len) != len) {
-                Update.printError(Serial);
-            }
+    }
+
+    bool ok = !len && !flashWriter.failed();
+    if (ok && final) {
+        ok = (flashWriter.finish() || (flashWriter.service() && flashWriter.finish())) && flashWriter.flush();
+    }
+    if (!ok) {
+        instance->otaLogger->error("Update failed: %s", uploadError());
+        uploadFailed = true;                                                                                            // Update.end() is never called, nothing gets installed
+        abandonImage();
+        return;
+    }
+
+    if (final) {
+        uint32_t size = flashWriter.written();
+        const char* error = finishImage(nullptr);
+        if (error) {
+            instance->otaLogger->error("Update failed: %s", error);
+            uploadFailed = true;
+        } else {
+            instance->otaLogger->debug("Update Success: %u B\n", size);
         }
-        if (final) {
-            if (Update.end(true)) {
-                instance->otaLogger->debug("Update Success: %u B\n", index + len);
-            } else {
-                Update.printError(Serial);
-            }
+    } else if (flashWriter.pending()) {
+        instance->scheduler->schedule(OTA_DASH_JOB_UPLOAD, 0);
+    }
+}
+
+void OTADash::beginUpload(AsyncWebServerRequest *request) {
+    uint32_t size = uploadParam(request, "size");
+    uint32_t crc  = uploadParam(request, "crc");
+    uint8_t  sha256[OTA_PATCH_SHA256_SIZE];
+    bool     checkHash = request->hasParam("sha256");
+    if (!size || (checkHash && !parseSha256(request->getParam("sha256")->value(), sha256))) {
+        request->send(400, "application/json", "{\"error\":\"Bad upload parameters\"}");
+        return;
+    }
+
+    OTA_DASH_UPLOAD_LOCK();
+    // Same image again: the link dropped, carry on after the last verified chunk
+    if (chunked && !chunked->error && chunked->size == size && chunked->crc == crc) {
+        otaLogger->debug("Resuming upload at %u of %u B\n", chunked->received, size);
+        chunked->lastActivity = millis();
+        sendUploadStatus(request, 200);
+        return;
+    }
+    if (chunked) {
+        releaseUpload();
+        delete chunked;
+        chunked = nullptr;
+    }
+    if (Update.isRunning() || flashWriter.active()) {                                                               // A form upload or an MQTT transfer has the partition
+        request->send(409, "application/json", "{\"error\":\"Another update is running\"}");
+        return;
+    }
+    if (!hasHeadroom(OTA_FLASH_WRITER_SECTORS * OTA_FLASH_SECTOR + sizeof(OTAChunkedUpload))) {                     // Sector buffers on top of the reserve
+        busyRejected++;
+        sendUploadStatus(request, 503, "Not enough free memory, try again later");
+        return;
+    }
+
+    chunked = new (std::nothrow) OTAChunkedUpload();
+    if (!chunked || !startImage()) {
+        delete chunked;
+        chunked = nullptr;
+        request->send(507, "application/json", "{\"error\":\"Not enough space or memory for the update\"}");
+        return;
+    }
+    chunked->size         = size;
+    chunked->crc          = crc;
+    chunked->checkHash    = checkHash;
+    chunked->lastActivity = millis();
+    memcpy(chunked->sha256, sha256, sizeof(sha256));
+
+    otaLogger->debug("Update Start: %u B in %u B chunks\n", size, OTA_DASH_UPLOAD_CHUNK);
+    scheduler->schedule(OTA_DASH_JOB_UPLOAD, OTA_DASH_UPLOAD_TIMEOUT);
+    sendUploadStatus(request, 200);
+}
+
+void OTADash::receiveChunk(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+    OTA_DASH_UPLOAD_LOCK();
+    if (!chunked || chunked->error || chunked->done) return;
+
+    if (!index) {
+        // A retry after a dropped request takes the sector over, anything else is answered in commitChunk()
+        bool next = request->hasParam("offset") && uploadParam(request, "offset") == chunked->received;
+        if (!next || !flashWriter.canFill() || total > OTA_DASH_UPLOAD_CHUNK) {
+            if (chunked->receiver == request) chunked->receiver = nullptr;
+            return;
         }
+        chunked->receiver = request;
+        chunked->chunkLen = 0;
+        chunked->chunkCrc = 0;
+    }
+    if (chunked->receiver != request) return;
+
+    if (index != chunked->chunkLen || !flashWriter.fill(chunked->chunkLen, data, len)) {
+        chunked->receiver = nullptr;
+        return;
+    }
+    chunked->chunkLen += len;
+    chunked->chunkCrc  = crc32Update(chunked->chunkCrc, data, len);
+}
+
+void OTADash::commitChunk(AsyncWebServerRequest *request) {
+    OTA_DASH_UPLOAD_LOCK();
+    if (!chunked) {
+        sendUploadStatus(request, 404);
+        return;
+    }
+    bool sectorFree = flashWriter.canFill();
+    if (chunked->error || chunked->done || chunked->receiver != request || !sectorFree) {
+        bool busy = !chunked->error && !chunked->done && !sectorFree;
+        sendUploadStatus(request, busy ? 503 : 409);                                                                // The page waits, or goes on from the offset it gets back
+        return;
+    }
+
+    chunked->receiver = nullptr;
+    size_t expected = std::min<uint32_t>(OTA_DASH_UPLOAD_CHUNK, chunked->size - chunked->received);
+    if (chunked->chunkLen != expected || chunked->chunkCrc != uploadParam(request, "crc")) {
+        sendUploadStatus(request, 422, "Chunk damaged in transit");                                                // Resent by the page
+        return;
+    }
+
+    flashWriter.commit(chunked->chunkLen, chunked->received + chunked->chunkLen == chunked->size);                  // Still free, only the chunk handlers fill it
+    chunked->received     += chunked->chunkLen;
+    chunked->lastActivity  = millis();
+    #if defined(OTA_DASH_PLATFORM_ESP8266)
+        flashWriter.service();                                                                                          // Single sector: written before the answer, so the next chunk finds it free
     #endif
+    scheduler->schedule(OTA_DASH_JOB_UPLOAD, 0);                                                                    // Writes it on ESP32, and finishes or fails the upload
+    sendUploadStatus(request, 200);
+}
+
+void OTADash::sendUploadStatus(AsyncWebServerRequest *request, int code, const char* error) {
+    JsonDocument doc;
+    doc["active"]       = chunked != nullptr;
+    if (chunked) {
+        doc["size"]     = chunked->size;
+        doc["offset"]   = chunked->received;
+        doc["chunk"]    = OTA_DASH_UPLOAD_CHUNK;
+        doc["done"]     = chunked->done;
+    }
+    if (error || (chunked && chunked->error)) {
+        doc["error"]    = error ? error : chunked->error;
+    }
+
+    AsyncResponseStream *response = request->beginResponseStream("application/json", 128);
+    response->setCode(code);
+    response->addHeader("Cache-Control", "no-store");
+    serializeJson(doc, *response);
+    request->send(response);
+}
+
+void OTADash::serviceUpload() {
+    flashWriter.service();                                                                                              // Outside the upload lock, chunks keep arriving while flash is busy
+    OTA_DASH_UPLOAD_LOCK();
+    if (!chunked) {
+        if (flashWriter.pending()) {
+            scheduler->schedule(OTA_DASH_JOB_UPLOAD, 0);                                                            // A form upload, handleUpload() finishes it
+        }
+        return;
+    }
+
+    if (!chunked->done && !chunked->error) {
+        if (flashWriter.failed()) {                                                                                     // Read under the lock, the upload may have been replaced meanwhile
+            otaLogger->error("Update failed: %s", uploadError());
+            abortUpload(uploadError());
+            return;
+        }
+        if (flashWriter.complete()) {
+            const char* error = finishImage(chunked->checkHash ? chunked->sha256 : nullptr);
+            if (error) {
+                otaLogger->error("Update failed: %s", error);
+                abortUpload(error);
+                return;
+            }
+            chunked->done = true;
+            otaLogger->debug("Update Success: %u B\n", chunked->size);
+            scheduler->schedule(OTA_DASH_JOB_RESTART, OTA_DASH_UPDATE_RESTART_DELAY);
+            return;
+        }
+    }
+
+    unsigned long idle = millis() - chunked->lastActivity;
+    if (idle >= OTA_DASH_UPLOAD_TIMEOUT) {                                                                          // Nobody came back for it
+        otaLogger->warn("Upload dropped at %u of %u B", chunked->received, chunked->size);
+        releaseUpload();
+        delete chunked;
+        chunked = nullptr;
+        return;
+    }
+    scheduler->schedule(OTA_DASH_JOB_UPLOAD, flashWriter.pending() ? 0 : OTA_DASH_UPLOAD_TIMEOUT - idle);
+}
+
+void OTADash::abortUpload(const char* reason) {
+    releaseUpload();
+    chunked->error = reason;
+    otaLogger->warn("Upload aborted: %s", reason);
+    chunked->lastActivity = millis();
+    scheduler->schedule(OTA_DASH_JOB_UPLOAD, OTA_DASH_UPLOAD_TIMEOUT);                                              // The record stays until then, for the page to read the reason
 }
 
 void OTADash::handlePairingResult() {
@@ -656,72 +1544,207 @@ void OTADash::handlePairingResult() {
         response = "{\"status\":\"error\",\"message\":\"Pairing failed\"}";
     }
     pairRequest = pairResult = false;
-    ws->textAll(response);
+    sendAll(response);
 }
 
-#if defined(OTA_DASH_PLATFORM_ESP32)
-void OTADash::otaDashTask(void *parameter) {
-    OTADash* dash = static_cast<OTADash*>(parameter);
-    unsigned long previousMillis = 0;
-    while(dash->serverStarted) {
-        dash->handleClient();
-        vTaskDelay(10);
-
-        if(millis() - previousMillis >= 10000 && dash->currentMode == NetworkMode::STATION) {
-            previousMillis = millis();
-            dash->isWifiConnected = WiFi.status() == WL_CONNECTED;
-
-            if (!dash->isWifiConnected) {
-                dash->handleNetworkFailure();
+void OTADash::handleWifiScanResult(int scanResult) {
+    if (scanResult < 0) {
+        otaLogger->error("Wi-Fi scan failed");
+        scanState = OTA_DASH_SCAN_IDLE;
+        sendAll("{\"networks\":[],\"offset\":0,\"done\":true,\"error\":\"scan_failed\"}");               // The cached list stays
+        return;
+    }
+
+    otaLogger->debug("Wi-Fi scan completed with %d networks", scanResult);
+    storeScanResults(scanResult);
+    WiFi.scanDelete();
+
+    networksStreamed = 0;
+    scanState = OTA_DASH_SCAN_STREAM;
+    streamScanResults();
+}
+
+/*
+ * Scan results are kept, deduplicated by SSID and sorted by signal, so page
+ * loads within OTA_DASH_SCAN_TTL are answered from memory. The SSIDs are read
+ * straight from the SDK records instead of through WiFi.SSID(i) Strings.
+ */
+void OTADash::storeScanResults(int found) {
+    networkCount = 0;
+
+    for (int i = 0; i < found; i++) {
+        OTADashNetwork network = {};
+        #if defined(OTA_DASH_PLATFORM_ESP32)
+            const wifi_ap_record_t* record = static_cast<const wifi_ap_record_t*>(WiFi.getScanInfoByIndex(i));
+            if (!record) continue;
+            strncpy(network.ssid, reinterpret_cast<const char*>(record->ssid), sizeof(network.ssid) - 1);
+        #elif defined(OTA_DASH_PLATFORM_ESP8266)
+            const bss_info* record = WiFi.getScanInfoByIndex(i);
+            if (!record) continue;
+            memcpy(network.ssid, record->ssid, std::min<size_t>(record->ssid_len, sizeof(network.ssid) - 1));
+        #endif
+        if (!network.ssid[0]) {
+            continue;                                                                                               // Hidden network
+        }
+        network.rssi       = WiFi.RSSI(i);
+        network.channel    = WiFi.channel(i);
+        network.encryption = WiFi.encryptionType(i);
+
+        int index = networkCount;
+        for (int j = 0; j < networkCount; j++) {
+            if (strcmp(networks[j].ssid, network.ssid) == 0) {
+                index = j;                                                                                          // Same network from another access point
+                break;
             }
         }
+        if (index < networkCount) {
+            if (networks[index].rssi >= network.rssi) continue;
+        } else if (networkCount < OTA_DASH_SCAN_MAX) {
+            networkCount++;
+        } else if (networks[networkCount - 1].rssi < network.rssi) {
+            index = networkCount - 1;                                                                               // Full, replace the weakest
+        } else {
+            continue;
+        }
+
+        while (index > 0 && networks[index - 1].rssi < network.rssi) {                                              // Keep the list sorted, strongest first
+            networks[index] = networks[index - 1];
+            index--;
+        }
+        networks[index] = network;
     }
-    vTaskDelete(NULL);
+
+    scannedAt = millis() | 1;                                                                                       // Never 0, that means no scan yet
 }
-#elif defined(OTA_DASH_PLATFORM_ESP8266)
-void OTADash::handleClientTick() {
-    if (serverStarted) {
-        handleClient();
+
+void OTADash::streamScanResults() {
+    uint8_t count = std::min<uint8_t>(networkCount - networksStreamed, OTA_DASH_SCAN_BATCH);
+    bool done = networksStreamed + count >= networkCount;
+
+    JsonDocument batch;                                                                                             // SSIDs are referenced, not copied
+    writeNetworks(batch["networks"].to<JsonArray>(), networksStreamed, count);
+    batch["offset"] = networksStreamed;
+    batch["done"]   = done;
+
+    size_t len = measureJson(batch);
+    std::unique_ptr<char[]> frame(new char[len + 1]);
+    serializeJson(batch, frame.get(), len + 1);
+    sendAll(frame.get(), len);
+
+    networksStreamed += count;
+    if (done) {
+        scanState = OTA_DASH_SCAN_IDLE;
+    } else {
+        scheduler->schedule(OTA_DASH_JOB_SCAN, OTA_DASH_SCAN_STREAM_INTERVAL);                                     // Spread out, so clients' queues drain in between
     }
 }
-#endif
 
-void OTADash::handleWifiScanResult(int scanResult) {
-    if (scanResult == WIFI_SCAN_FAILED) {
-        otaLogger->error("Wi-Fi scan failed");
-        ws->textAll("[]");
-    } else if (scanResult == WIFI_SCAN_RUNNING) {
-        otaLogger->debug("Wi-Fi scan still running");
-    } else {
-        if (scanResult <= 0) {
-            otaLogger->warn("Wi-Fi scan returned no results");
-            ws->textAll("[]");
-            return;
+void OTADash::writeNetworks(JsonArray list, uint8_t from, uint8_t count) const {
+    for (uint8_t i = from; i < from + count && i < networkCount; i++) {
+        JsonObject entry    = list.add<JsonObject>();
+        entry["ssid"]       = (const char*)networks[i].ssid;
+        entry["rssi"]       = networks[i].rssi;
+        entry["channel"]    = networks[i].channel;
+        entry["encryption"] = encryptionTypeToString(networks[i].encryption);
+    }
+}
+
+const char* OTADash::encryptionTypeToString(int encryptionType) {
+    #if defined(OTA_DASH_PLATFORM_ESP32)
+        switch (encryptionType) {
+            case WIFI_AUTH_OPEN:            return "Open";
+            case WIFI_AUTH_WEP:             return "WEP";
+            case WIFI_AUTH_WPA_PSK:         return "WPA";
+            case WIFI_AUTH_WPA2_PSK:        return "WPA2";
+            case WIFI_AUTH_WPA_WPA2_PSK:    return "WPA/WPA2";
+            case WIFI_AUTH_WPA2_ENTERPRISE: return "WPA2-Enterprise";
+            case WIFI_AUTH_WPA3_PSK:        return "WPA3";
+            case WIFI_AUTH_WPA2_WPA3_PSK:   return "WPA2/WPA3";
+            default:                        return "Unknown";
+        }
+    #elif defined(OTA_DASH_PLATFORM_ESP8266)
+        switch (encryptionType) {
+            case ENC_TYPE_NONE:             return "Open";
+            case ENC_TYPE_WEP:              return "WEP";
+            case ENC_TYPE_TKIP:             return "WPA";
+            case ENC_TYPE_CCMP:             return "WPA2";
+            case ENC_TYPE_AUTO:             return "WPA/WPA2";
+            default:                        return "Unknown";
+        }
+    #endif
+}
+
+void OTADash::handleWebSocketEvent(AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len) {
+    OTADashClient* slot = findClient(client->id());
+
+    switch (type) {
+        case WS_EVT_CONNECT: {
+            if (!hasHeadroom()) {                                                                                   // Each client holds its own send queue
+                busyRejected++;
+                client->close(1013, "busy");
+                return;
+            }
+            if (!slot) {
+                slot = findClient(0);
+            }
+            if (!slot) {                                                                                            // Full: make room only if some client stopped answering pings
+                OTADashClient* idlest = nullptr;
+                for (OTADashClient& other : wsClients) {
+                    if (!idlest || millis() - other.lastSeen > millis() - idlest->lastSeen) {
+                        idlest = &other;
+                    }
+                }
+                if (millis() - idlest->lastSeen > OTA_DASH_WS_PING_INTERVAL * 2000UL) {
+                    if (AsyncWebSocketClient *stale = ws->client(idlest->id)) {
+                        stale->close(1001, "idle");
+                    }
+                    wsEvicted++;
+                    slot = idlest;
+                }
+            }
+            if (!slot) {
+                wsRejected++;
+                client->close(1013, "busy");
+                return;
+            }
+            *slot = OTADashClient{};
+            slot->id = client->id();
+            slot->lastSeen = millis();
+            client->keepAlivePeriod(OTA_DASH_WS_PING_INTERVAL);
+            scheduler->scheduleWithin(OTA_DASH_JOB_CLIENTS, OTA_DASH_WS_SERVICE_INTERVAL);
+            break;
         }
 
-        otaLogger->debug(
-            String("Wi-Fi scan completed with " + String(scanResult) + " networks").c_str()
-        );
-        String networks = "[";
-        for (int i = 0; i < scanResult; i++) {
-            if (i > 0) networks += ",";
-            String ssidEscaped = WiFi.SSID(i);
-            ssidEscaped.replace("\"", "\\\""); // Escape quotes
-            ssidEscaped.replace("\\", "\\\\"); // Escape backslashes
-            networks += "{\"ssid\":\"" + ssidEscaped + "\",";
-            networks += "\"rssi\":" + String(WiFi.RSSI(i)) + ",";
-            networks += "\"channel\":" + String(WiFi.channel(i)) + ",";
-            networks += "\"encryption\":\"" + encryptionTypeToString(WiFi.encryptionType(i)) + "\"}";
+        case WS_EVT_DISCONNECT:
+            if (slot) {
+                *slot = OTADashClient{};
+            }
+            break;
+
+        case WS_EVT_PONG:
+            if (slot) {
+                slot->lastSeen = millis();
+            }
+            break;
+
+        case WS_EVT_DATA: {
+            if (slot) {
+                slot->lastSeen = millis();
+            }
+            AwsFrameInfo *info = (AwsFrameInfo *)arg;
+            if (info->opcode == WS_TEXT) {
+                data[len] = 0;
+                handleWebSocketMessage(client, arg, data, len);
+            }
+            break;
         }
-        networks += "]";
-        otaLogger->debug("Sending scan results to WebSocket");
-        ws->textAll(networks); // Send the results over WebSocket
-        WiFi.scanDelete();
+
+        default:
+            break;
     }
-    WiFi.scanDelete(); // Clear the scan results
 }
 
-void OTADash::handleWebSocketMessage(void *arg, uint8_t *data, size_t len) {
+void OTADash::handleWebSocketMessage(AsyncWebSocketClient *client, void *arg, uint8_t *data, size_t len) {
     AwsFrameInfo *info = (AwsFrameInfo*)arg;
     if(info->final && info->index == 0 && info->len == len) {
         if(info->opcode == WS_TEXT) {
@@ -729,25 +1752,27 @@ void OTADash::handleWebSocketMessage(void *arg, uint8_t *data, size_t len) {
             for (size_t i = 0; i < len; i++) {
                 message += (char)data[i];
             }
+
+            if (message == "logs") {                                                                                // Sent by the debug page, it fetched the backlog from /api/logs
+                if (OTADashClient* slot = findClient(client->id())) {
+                    slot->logs = true;
+                    slot->logCursor = logBuffer->nextSeq();
+                }
+                return;
+            }
             printDebug("Received message: " + message);
         }
     }
 }
 
 void OTADash::handleNetworkFailure() {
-    static int reconnectCount = 0;
-    static unsigned long lastReconnectAttempt = 0;
-    
-    if (millis() - lastReconnectAttempt >= reconnectDelay) {
-        if (reconnectCount < maxReconnectAttempts) {
-            otaLogger->debug("Attempting to reconnect to WiFi...");
-            reconnectWifi();
-            reconnectCount++;
-            lastReconnectAttempt = millis();
-        } else {
-            otaLogger->error("Max reconnection attempts reached");
-            reconnectCount = 0;
-        }
+    if (reconnectCount < maxReconnectAttempts) {                                                                    // Called every reconnectDelay by the station job
+        otaLogger->debug("Attempting to reconnect to WiFi...");
+        reconnectWifi();
+        reconnectCount++;
+    } else {
+        otaLogger->error("Max reconnection attempts reached");
+        reconnectCount = 0;
     }
 }
 
@@ -757,4 +1782,8 @@ void OTADash::onWifiSaved(std::function<void(const String&, const String&)> call
 
 void OTADash::onPaired(std::function<void(JsonDocument&)> callback) {
     pairingCallback = callback;
+}
+
+void OTADash::onRestart(std::function<void()> callback) {
+    restartCallback = callback;
 }
\ No newline at end of file
@@ -53,25 +53,53 @@
     #include <EEPROM.h>
     #include "WebPages.h"
     #include "ArduinoJson.h"
+    #include "OTALogBuffer.h"
+    #include "OTAScheduler.h"
 #elif defined(OTA_DASH_PLATFORM_ESP8266)
     #include <ESP8266WiFi.h>
     #include <ESPAsyncWebServer.h>
     #include <ESPAsyncTCP.h>
-    #include <Ticker.h>
     #include <EEPROM.h>
     #include <Updater.h>
     #include "WebPages.h"
     #include <DNSServer.h>
     #include <ESP8266mDNS.h>
     #include "ArduinoJson.h"
+    #include "OTALogBuffer.h"
+    #include "OTAScheduler.h"
 #endif
 
 #define OTA_DASH_VERSION                    "1.0.0"
 #define OTA_DASH_EEPROM_SIZE                50
 #define OTA_DASH_EEPROM_ADDR                0
-#define OTA_DASH_DEBUG_LOGS_MAX             200
+#define OTA_DASH_DEBUG_LOGS_MAX             200            // Lines kept for the debug page, the buffer size caps them too
+#define OTA_DASH_LOG_FLUSH_INTERVAL         250            // New log lines are pushed to the debug page in one frame per interval
+#define OTA_DASH_LOG_FRAME_SIZE             1536           // One WebSocket frame of log lines, fits at least one line
+#define OTA_DASH_DNS_INTERVAL               5              // Captive DNS polling while stations are on the AP
+#define OTA_DASH_SCAN_POLL_INTERVAL         100            // Wi-Fi scan completion checks, only while a scan runs
+#define OTA_DASH_SCAN_TTL                   30000          // Cached scan results younger than this are served without a new scan
+#define OTA_DASH_SCAN_MAX                   20             // Networks kept, strongest first
+#define OTA_DASH_SCAN_BATCH                 4              // Networks per WebSocket frame when a scan completes
+#define OTA_DASH_SCAN_STREAM_INTERVAL       20
+#define OTA_DASH_RESTART_DELAY              1000           // Lets the response go out before restarting
+#define OTA_DASH_UPDATE_RESTART_DELAY       2000
+#define OTA_DASH_WS_QUEUE_MAX               4              // Frames queued for one client before it is skipped
+#define OTA_DASH_WS_PING_INTERVAL           15             // Seconds, browsers answer with a pong even in background tabs
+#define OTA_DASH_WS_IDLE_TIMEOUT            60000          // Clients not heard from for this long are closed
+#define OTA_DASH_WS_SERVICE_INTERVAL        1000           // Client cleanup and idle checks
+#if defined(OTA_DASH_PLATFORM_ESP32)
+    #define OTA_DASH_LOG_BUFFER_SIZE        8192
+    #define OTA_DASH_WS_MAX_CLIENTS         8
+#else
+    #define OTA_DASH_LOG_BUFFER_SIZE        2048
+    #define OTA_DASH_WS_MAX_CLIENTS         4
+#endif
 #define OTA_DASH_RECONNECT_DELAY            5000
 #define OTA_DASH_MAX_RECONNECT_ATTEMPTS     3
+#define OTA_DASH_BUSY_RETRY                 "2"            // Retry-After (seconds) on requests refused below the heap reserve
+#define OTA_DASH_INFLATE_WINDOW             32768          // ESP32 gzip upload: deflate window, also the flash write buffer
+#define OTA_DASH_UPLOAD_CHUNK               4096           // Resumable upload chunk, one flash sector
+#define OTA_DASH_UPLOAD_TIMEOUT             600000         // An interrupted upload is kept this long for the page to resume it
 
 #define OTA_DASH_ENABLE_DEBUG_LOGS          1              // Enable/Disable debug logs 0 disable, 1 enable
 
@@ -92,6 +120,41 @@ struct NetworkCredentials {
     char setuped[10];
 };
 
+enum OTADashScanState : uint8_t {
+    OTA_DASH_SCAN_IDLE,
+    OTA_DASH_SCAN_START,
+    OTA_DASH_SCAN_RUNNING,
+    OTA_DASH_SCAN_STREAM
+};
+
+struct OTADashNetwork {
+    char            ssid[33];
+    int8_t          rssi;
+    uint8_t         channel;
+    uint8_t         encryption;
+};
+
+enum OTADashJob : uint8_t {
+    OTA_DASH_JOB_DNS,
+    OTA_DASH_JOB_SCAN,
+    OTA_DASH_JOB_PAIRING,
+    OTA_DASH_JOB_RESTART,
+    OTA_DASH_JOB_LOG_FLUSH,
+    OTA_DASH_JOB_CLIENTS,
+    OTA_DASH_JOB_STATION,
+    OTA_DASH_JOB_UPLOAD,
+    OTA_DASH_JOB_COUNT
+};
+
+struct OTADashClient {
+    uint32_t        id;                                                                                                 // WebSocket client id, 0 for a free slot
+    bool            logs;                                                                                               // Asked for debug log frames
+    uint32_t        logCursor;                                                                                          // Next log line to send
+    uint32_t        sent;
+    uint32_t        dropped;                                                                                            // Frames skipped while its queue was full, and log lines overwritten before it got them
+    unsigned long   lastSeen;                                                                                           // Last message or pong
+};
+
 class OTADash {
 public:
     OTADash(const char* ssid, const char* password, const char* custom_domain, const char* portal_title);
@@ -105,22 +168,29 @@ public:
     
     void printDebug(const String& message);   
     void begin(NetworkMode mode = NetworkMode::AUTO); 
+    uint32_t loop();                                                                                                // Call from loop(), runs the jobs the portal has scheduled, returns ms until the next one
+    uint32_t nextDeadline() const;                                                                                  // 0 once a handler has armed a job, lets a sleeping loop() wake early
     
     void onPaired(std::function<void(JsonDocument&)> callback);
+    void onRestart(std::function<void()> callback);
+    void onWake(std::function<void()> callback);                                                                    // A handler armed a job, from the context that armed it
     void onWifiSaved(std::function<void(const String&, const String&)> callback);
     
-    void setDebugLogMax(int logs)           { debugLogsMax          = logs;    }
+    void setDebugLogMax(int logs)           { debugLogsMax          = logs;     logBuffer->setMaxLines(logs); }
     void setEEPROMSize(size_t size)         { eepromSize            = size;    }
     void setPairResult(bool result)         { pairResult            = result;  }
-    void setProductName(String name)        { productName           = name;    }
-    void setPairRequest(bool request)       { pairRequest           = request; }
+    void setProductName(String name)        { productName           = name;     deviceFacts = String(); }
+    void setPairRequest(bool request);
     void setEEPROMAddress(int address)      { eepromAddress         = address; }
     void setReconnectDelay(uint32_t delay)  { reconnectDelay        = delay;   }
     void setReconnectAttempts(int attempts) { maxReconnectAttempts  = attempts;}
-    void setFirmwareVersion(String version) { firmwareVersion       = version; }
+    void setAutoReconnect(bool reconnect)   { autoReconnect         = reconnect;}                                   // false when the application looks after the station
+    void setHeapReserve(uint32_t bytes)     { heapReserve           = bytes;   }                                    // Kept free for the application, pages and uploads are refused below it
+    void setJobsPerLoop(uint8_t jobs)       { jobsPerLoop           = jobs;    }                                    // Portal jobs per loop() call, the application runs in between
+    void setFirmwareVersion(String version) { firmwareVersion       = version;  deviceFacts = String(); }
 
     int getEEPROMAddress()    const         { return eepromAddress;            }
-    int getDebugLogsCounter() const         { return debugLogsCounter;         }
+    int getDebugLogsCounter() const         { return logBuffer->lines();       }
     int getDebugLogsMax()     const         { return debugLogsMax;             }
     bool isConnected()        const         { return isWifiConnected;          }
     size_t getEEPROMSize()    const         { return eepromSize;               }
@@ -134,21 +204,29 @@ public:
 
 private:      
     int                                                 eepromAddress           = OTA_DASH_EEPROM_ADDR;
-    int                                                 debugLogsCounter        = 0;
     int                                                 debugLogsMax            = OTA_DASH_DEBUG_LOGS_MAX;
     int                                                 maxReconnectAttempts    = OTA_DASH_MAX_RECONNECT_ATTEMPTS;
+    int                                                 reconnectCount          = 0;
     bool                                                isWifiConnected         = false;
     bool                                                serverStarted           = false;
-    bool                                                isOnDebugPage           = false;
     bool                                                autoReconnect           = true;
     bool                                                pairRequest             = false;
     bool                                                pairResult              = false;
     size_t                                              eepromSize              = OTA_DASH_EEPROM_SIZE; 
-    String                                              debugLogs;
+    String                                              deviceFacts;                                                // /api/info static part, serialized once
     String                                              customDomain;
     String                                              firmwareVersion         = "Not Configured";
     String                                              productName             = "ESP32 Device";
     uint32_t                                            reconnectDelay          = 5000;   
+    uint32_t                                            wsRejected              = 0;
+    uint8_t                                             networkCount            = 0;
+    uint8_t                                             networksStreamed        = 0;
+    OTADashScanState                                    scanState               = OTA_DASH_SCAN_IDLE;
+    unsigned long                                       scannedAt               = 0;                                // 0: never scanned
+    uint32_t                                            wsEvicted               = 0;
+    uint32_t                                            heapReserve             = 0;                                // 0: the portal has the device to itself
+    uint32_t                                            busyRejected            = 0;                                // Requests and clients refused for lack of heap
+    uint8_t                                             jobsPerLoop             = OTA_SCHEDULER_MAX_JOBS;
     const char*                                         ssid;
     const char*                                         password;
     const char*                                         portal_title;
@@ -162,23 +240,45 @@ private:
     std::unique_ptr<DNSServer>                          dnsServer;
     std::unique_ptr<AsyncWebServer>                     server;
     std::unique_ptr<AsyncWebSocket>                     ws;
+    std::unique_ptr<OTALogBuffer>                       logBuffer;
+    std::unique_ptr<OTAScheduler>                       scheduler;
+    OTADashClient                                       wsClients[OTA_DASH_WS_MAX_CLIENTS]      = {};
+    OTADashNetwork                                      networks[OTA_DASH_SCAN_MAX]             = {};
     std::function<void(JsonDocument&)>                  pairingCallback         = nullptr;
     std::function<void(const String&, const String&)>   wifiSavedCallback       = nullptr;
+    std::function<void()>                               restartCallback         = nullptr;
 
 
     #if defined(OTA_DASH_PLATFORM_ESP32)
-        TaskHandle_t otaTaskHandle = nullptr;
-        static void otaDashTask(void *parameter);
+        wifi_event_id_t                                 wifiEventId             = 0;
     #elif defined(OTA_DASH_PLATFORM_ESP8266)
-        Ticker clientHandlerTicker;
-        void handleClientTick();
+        WiFiEventHandler                                stationUpHandler;
+        WiFiEventHandler                                stationDownHandler;
+        WiFiEventHandler                                apJoinHandler;
     #endif
 
     void stop();
     bool readEEPROM();
     bool writeEEPROM();
     void setupServer();
-    void handleClient();   
+    void cacheDeviceFacts();
+    void setupJobs();
+    void serviceDns();
+    void requestScan();
+    void pollWifiScan();
+    void storeScanResults(int found);
+    void streamScanResults();
+    void writeNetworks(JsonArray list, uint8_t from, uint8_t count) const;
+    void checkStation();
+    void onStationUp();
+    void onStationDown();
+    void flushLogs();
+    void serviceClients();
+    void sendAll(const String& message);
+    void sendAll(const char* message, size_t len);
+    bool hasHeadroom(size_t extra = 0) const;
+    bool admit(AsyncWebServerRequest *request);                                                                     // Or answers 503 below the heap reserve
+    OTADashClient* findClient(uint32_t id);
     bool startStation();
     void reconnectWifi();
     bool startDualMode(); 
@@ -187,9 +287,17 @@ private:
     void handlePairingResult(); 
     void handleNetworkFailure();
     void handleWifiScanResult(int scanResult); 
-    String encryptionTypeToString(int encryptionType); 
+    static const char* encryptionTypeToString(int encryptionType);
+    static void restartDevice();
     static void handleUpdate(AsyncWebServerRequest *request);
-    void handleWebSocketMessage(void *arg, uint8_t *data, size_t len);
+    void beginUpload(AsyncWebServerRequest *request);
+    void receiveChunk(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total);
+    void commitChunk(AsyncWebServerRequest *request);
+    void sendUploadStatus(AsyncWebServerRequest *request, int code, const char* error = nullptr);
+    void serviceUpload();
+    void abortUpload(const char* reason);
+    void handleWebSocketEvent(AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len);
+    void handleWebSocketMessage(AsyncWebSocketClient *client, void *arg, uint8_t *data, size_t len);
     bool connectToWifi(const char* ssid, const char* password, uint32_t timeout_ms = 20000);
     static void handleUpload(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final);
 };
@@ -0,0 +1,190 @@
+   /*
+ ====================================================================================================
+ * File:        OTAFlashWriter.cpp
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       Sector buffered firmware writes, decoupled from the network
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#include "OTAFlashWriter.h"
+#include <new>
+
+#if defined(ESP32)
+    #define OTA_FLASH_WRITER_LOCK()         std::lock_guard<std::mutex> guard(mutex)
+    #define OTA_FLASH_WRITER_FILL_LOCK()    std::lock_guard<std::mutex> fillGuard(fillMutex)
+#else
+    #define OTA_FLASH_WRITER_LOCK()
+    #define OTA_FLASH_WRITER_FILL_LOCK()
+#endif
+
+bool OTAFlashWriter::begin(Sink sink) {
+    OTA_FLASH_WRITER_LOCK();
+    OTA_FLASH_WRITER_FILL_LOCK();
+    release();
+    memory = new (std::nothrow) uint8_t[OTA_FLASH_WRITER_SECTORS * OTA_FLASH_SECTOR];
+    if (!memory) {
+        return false;
+    }
+    for (uint8_t i = 0; i < OTA_FLASH_WRITER_SECTORS; i++) {
+        sectors[i].data  = memory + i * OTA_FLASH_SECTOR;
+        sectors[i].len   = 0;
+        sectors[i].last  = false;
+        sectors[i].ready = false;
+    }
+    this->sink  = sink;
+    filling     = 0;
+    draining    = 0;
+    fillLen     = 0;
+    total       = 0;
+    sinkFailed  = false;
+    lastWritten = false;
+    hash.begin();
+    return true;
+}
+
+void OTAFlashWriter::end() {
+    OTA_FLASH_WRITER_LOCK();                                                                                            // Not while service() is in the sink
+    OTA_FLASH_WRITER_FILL_LOCK();                                                                                       // Nor while a sector is being filled
+    release();
+}
+
+void OTAFlashWriter::release() {
+    delete[] memory;
+    memory = nullptr;
+    for (Sector& sector : sectors) {
+        sector.ready = false;
+    }
+    sink = nullptr;
+}
+
+uint8_t* OTAFlashWriter::freeSector() {
+    if (!memory || sinkFailed || sectors[filling].ready) {
+        return nullptr;
+    }
+    return sectors[filling].data;
+}
+
+bool OTAFlashWriter::canFill() {
+    OTA_FLASH_WRITER_FILL_LOCK();
+    return freeSector() != nullptr;
+}
+
+bool OTAFlashWriter::fill(size_t offset, const uint8_t* data, size_t len) {
+    OTA_FLASH_WRITER_FILL_LOCK();
+    uint8_t* sector = freeSector();
+    if (!sector || offset + len > OTA_FLASH_SECTOR) {
+        return false;
+    }
+    memcpy(sector + offset, data, len);
+    return true;
+}
+
+bool OTAFlashWriter::commit(size_t len, bool last) {
+    OTA_FLASH_WRITER_FILL_LOCK();
+    if (!freeSector()) {
+        return false;
+    }
+    handOver(len, last);
+    return true;
+}
+
+void OTAFlashWriter::handOver(size_t len, bool last) {
+    Sector& sector = sectors[filling];
+    sector.len   = len;
+    sector.last  = last;
+    sector.ready = true;                                                                                                // Last, the data must be in place before service() sees it
+    filling      = (filling + 1) % OTA_FLASH_WRITER_SECTORS;
+    fillLen      = 0;
+}
+
+size_t OTAFlashWriter::write(const uint8_t* data, size_t len) {
+    OTA_FLASH_WRITER_FILL_LOCK();
+    size_t taken = 0;
+    while (taken < len) {
+        uint8_t* sector = freeSector();
+        if (!sector) {
+            break;
+        }
+        size_t n = std::min(len - taken, OTA_FLASH_SECTOR - fillLen);
+        memcpy(sector + fillLen, data + taken, n);
+        fillLen += n;
+        taken   += n;
+        if (fillLen == OTA_FLASH_SECTOR) {
+            handOver(fillLen, false);
+        }
+    }
+    return taken;
+}
+
+bool OTAFlashWriter::finish() {
+    OTA_FLASH_WRITER_FILL_LOCK();
+    if (!freeSector()) {
+        return false;
+    }
+    handOver(fillLen, true);                                                                                            // May be empty, the sink still learns the stream ended
+    return true;
+}
+
+bool OTAFlashWriter::service() {
+    OTA_FLASH_WRITER_LOCK();
+    if (!memory || sinkFailed) {
+        return !sinkFailed;
+    }
+    Sector& sector = sectors[draining];
+    if (!sector.ready) {
+        return true;
+    }
+
+    hash.update(sector.data, sector.len);
+    if (!sink(sector.data, sector.len, sector.last)) {
+        sinkFailed = true;
+        return false;
+    }
+    total       += sector.len;
+    lastWritten  = sector.last;
+    sector.ready = false;
+    draining     = (draining + 1) % OTA_FLASH_WRITER_SECTORS;
+    return true;
+}
+
+bool OTAFlashWriter::flush() {
+    while (pending()) {
+        if (!service()) {
+            return false;
+        }
+    }
+    return !sinkFailed;
+}
+
+void OTAFlashWriter::digest(uint8_t out[OTA_PATCH_SHA256_SIZE]) {
+    hash.finish(out);
+}
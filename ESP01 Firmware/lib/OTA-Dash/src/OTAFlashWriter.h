@@ -0,0 +1,127 @@
+   /*
+ ====================================================================================================
+ * File:        OTAFlashWriter.h
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       Sector buffered firmware writes, decoupled from the network
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#ifndef OTAFLASHWRITER_H
+#define OTAFLASHWRITER_H
+
+#include <Arduino.h>
+#include <functional>
+#include "OTAPatch.h"
+
+#if defined(ESP32)
+    #include <atomic>
+    #include <mutex>
+#endif
+
+#define OTA_FLASH_SECTOR                    4096
+
+#if defined(ESP32)
+    #define OTA_FLASH_WRITER_SECTORS        2                                                                           // One fills on the async_tcp task while the loop writes the other
+#else
+    #define OTA_FLASH_WRITER_SECTORS        1                                                                           // One context, nothing to overlap; holds a chunk until its CRC is checked
+#endif
+
+/*
+ * Sector buffers between the network and the update partition. Received data
+ * fills a sector while service(), which the portal runs from the loop, hands
+ * the one before it to the sink, so on ESP32 erasing and programming flash
+ * never holds up the next network buffer. The sink gets the stream in sector
+ * sized pieces, not flash aligned writes: the verifier behind it holds back
+ * the signature trailer and gzip or a patch change the length, and Updater
+ * keeps its own sector buffer for the erase. The SHA-256 of the stream is
+ * taken on the same pass. On ESP32 the two sides run on different tasks, each
+ * takes its own lock so a fill never waits for an erase, and end() takes both
+ * before it frees the sectors.
+ */
+class OTAFlashWriter {
+public:
+    typedef std::function<bool(const uint8_t* data, size_t len, bool last)> Sink;
+
+    bool begin(Sink sink);                                                                                              // false without memory for the sectors
+    void end();                                                                                                         // Drops what was not written yet
+
+    bool canFill();                                                                                                     // A sector is free, false while all wait for flash
+    bool fill(size_t offset, const uint8_t* data, size_t len);                                                          // Copies into the free sector, false if there is none
+    bool commit(size_t len, bool last = false);                                                                         // Hands the free sector to service()
+    size_t write(const uint8_t* data, size_t len);                                                                      // Stream input, returns the bytes taken
+    bool finish();                                                                                                      // Stream input ends; false if no sector is free for the tail
+
+    bool service();                                                                                                     // Writes the oldest waiting sector, false once the sink failed
+    bool flush();                                                                                                       // service() until nothing waits
+    void digest(uint8_t out[OTA_PATCH_SHA256_SIZE]);                                                                    // Once complete()
+
+    bool     active()   const               { return memory != nullptr;                                 }
+    bool     pending()  const               { return active() && sectors[draining].ready;               }
+    bool     failed()   const               { return sinkFailed;                                        }
+    bool     complete() const               { return lastWritten;                                       }
+    uint32_t written()  const               { return total;                                             }
+
+private:
+    #if defined(ESP32)
+        typedef std::atomic<bool>                       Flag;                                                       // Filled on the async_tcp task, written from the loop
+    #else
+        typedef volatile bool                           Flag;
+    #endif
+
+    struct Sector {
+        uint8_t*                                        data                    = nullptr;
+        size_t                                          len                     = 0;
+        bool                                            last                    = false;
+        Flag                                            ready                   {false};
+    };
+
+    uint8_t* freeSector();                                                                                              // Caller holds fillMutex
+    void handOver(size_t len, bool last);                                                                               // Caller holds fillMutex, a sector is free
+    void release();                                                                                                     // Caller holds both locks
+
+    Sink                                                sink;
+    Sector                                              sectors[OTA_FLASH_WRITER_SECTORS];
+    uint8_t*                                            memory                  = nullptr;
+    uint8_t                                             filling                 = 0;
+    uint8_t                                             draining                = 0;
+    size_t                                              fillLen                 = 0;                                // Stream bytes in the filling sector
+    uint32_t                                            total                   = 0;
+    Flag                                                sinkFailed              {false};
+    Flag                                                lastWritten             {false};
+    OTASha256                                           hash;
+    #if defined(ESP32)
+        std::mutex                                      mutex;                                                      // Draining side, held across the sink
+        std::mutex                                      fillMutex;                                                  // Filling side, so end() never frees a sector being copied into
+    #endif
+};
+
+#endif // OTAFLASHWRITER_H
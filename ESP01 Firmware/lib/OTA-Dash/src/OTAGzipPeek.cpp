@@ -0,0 +1,324 @@
+   /*
+ ====================================================================================================
+ * File:        OTAGzipPeek.cpp
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       First bytes of a gzip upload, without inflating the rest
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#include "OTAGzipPeek.h"
+#include "OTAPatch.h"
+#include <new>
+
+#define OTA_GZIP_MAX_BITS                   15
+#define OTA_GZIP_MAX_LITERALS               288
+#define OTA_GZIP_MAX_DISTANCES              30
+
+/*
+ * Canonical Huffman decoding after Mark Adler's puff.c: codes are counted per
+ * length and symbols listed in code order, a symbol is found bit by bit.
+ */
+struct OTAGzipHuffman {
+    uint16_t                                            count[OTA_GZIP_MAX_BITS + 1];
+    uint16_t                                            symbol[OTA_GZIP_MAX_LITERALS];
+};
+
+struct OTAGzipState {
+    const uint8_t*                                      in;
+    size_t                                              inLen;
+    size_t                                              inPos;
+    uint32_t                                            bitBuf;
+    uint8_t                                             bitCount;
+    bool                                                overrun;                                                        // Ran out of input, nothing read after it counts
+    uint8_t*                                            out;
+    size_t                                              outLen;
+    size_t                                              want;
+    OTAGzipHuffman                                      lengths;
+    OTAGzipHuffman                                      distances;
+    uint16_t                                            codeLengths[OTA_GZIP_MAX_LITERALS + OTA_GZIP_MAX_DISTANCES];
+};
+
+static const uint16_t LENGTH_BASE[29]  = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                           35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t  LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                           3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t DIST_BASE[30]    = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                           257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t  DIST_EXTRA[30]   = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                           7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static const uint8_t  CODE_ORDER[19]   = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+static uint32_t readBits(OTAGzipState& s, uint8_t need) {
+    while (s.bitCount < need) {
+        if (s.inPos == s.inLen) {
+            s.overrun = true;
+            return 0;
+        }
+        s.bitBuf |= (uint32_t)s.in[s.inPos++] << s.bitCount;
+        s.bitCount += 8;
+    }
+    uint32_t value = s.bitBuf & ((1UL << need) - 1);
+    s.bitBuf >>= need;
+    s.bitCount -= need;
+    return value;
+}
+
+static bool buildHuffman(OTAGzipHuffman& h, const uint16_t* lengths, uint16_t n) {
+    uint16_t offsets[OTA_GZIP_MAX_BITS + 1];
+
+    memset(h.count, 0, sizeof(h.count));
+    for (uint16_t symbol = 0; symbol < n; symbol++) {
+        h.count[lengths[symbol]]++;
+    }
+
+    // Over-subscribed code sets are corrupt, incomplete ones are allowed (a single distance code)
+    int32_t left = 1;
+    for (uint8_t len = 1; len <= OTA_GZIP_MAX_BITS; len++) {
+        left = (left << 1) - h.count[len];
+        if (left < 0) return false;
+    }
+
+    offsets[1] = 0;
+    for (uint8_t len = 1; len < OTA_GZIP_MAX_BITS; len++) {
+        offsets[len + 1] = offsets[len] + h.count[len];
+    }
+    for (uint16_t symbol = 0; symbol < n; symbol++) {
+        if (lengths[symbol]) {
+            h.symbol[offsets[lengths[symbol]]++] = symbol;
+        }
+    }
+    return true;
+}
+
+static int decodeSymbol(OTAGzipState& s, const OTAGzipHuffman& h) {
+    int code = 0, first = 0, index = 0;
+    for (uint8_t len = 1; len <= OTA_GZIP_MAX_BITS; len++) {
+        code |= readBits(s, 1);
+        if (s.overrun) return -1;
+        int count = h.count[len];
+        if (code - count < first) {
+            return h.symbol[index + (code - first)];
+        }
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    return -1;                                                                                                          // No such code
+}
+
+static void emit(OTAGzipState& s, uint8_t byte) {
+    if (s.outLen < s.want) {
+        s.out[s.outLen] = byte;
+    }
+    s.outLen++;
+}
+
+static bool inflateCodes(OTAGzipState& s) {                                                                            // false on corrupt data or overrun
+    while (s.outLen < s.want) {
+        int symbol = decodeSymbol(s, s.lengths);
+        if (symbol < 0) return false;
+        if (symbol < 256) {
+            emit(s, symbol);
+            continue;
+        }
+        if (symbol == 256) return true;                                                                                 // End of block
+
+        symbol -= 257;
+        if (symbol >= 29) return false;
+        uint32_t length = LENGTH_BASE[symbol] + readBits(s, LENGTH_EXTRA[symbol]);
+        int dist = decodeSymbol(s, s.distances);
+        if (dist < 0 || dist >= OTA_GZIP_MAX_DISTANCES) return false;
+        uint32_t distance = DIST_BASE[dist] + readBits(s, DIST_EXTRA[dist]);
+        if (s.overrun || distance > s.outLen) return false;
+
+        // Only the bytes still wanted are copied, they all lie inside out[]
+        while (length-- && s.outLen < s.want) {
+            emit(s, s.out[s.outLen - distance]);
+        }
+    }
+    return true;
+}
+
+static bool inflateStored(OTAGzipState& s) {
+    s.bitBuf   = 0;                                                                                                     // Rest of the current byte is padding
+    s.bitCount = 0;
+    if (s.inPos + 4 > s.inLen) {
+        s.overrun = true;
+        return false;
+    }
+    uint16_t len  = s.in[s.inPos] | (s.in[s.inPos + 1] << 8);
+    uint16_t nlen = s.in[s.inPos + 2] | (s.in[s.inPos + 3] << 8);
+    s.inPos += 4;
+    if (len != (uint16_t)~nlen) return false;
+
+    while (len-- && s.outLen < s.want) {
+        if (s.inPos == s.inLen) {
+            s.overrun = true;
+            return false;
+        }
+        emit(s, s.in[s.inPos++]);
+    }
+    return true;
+}
+
+static bool inflateFixed(OTAGzipState& s) {
+    uint16_t symbol = 0;
+    for (; symbol < 144; symbol++) s.codeLengths[symbol] = 8;
+    for (; symbol < 256; symbol++) s.codeLengths[symbol] = 9;
+    for (; symbol < 280; symbol++) s.codeLengths[symbol] = 7;
+    for (; symbol < OTA_GZIP_MAX_LITERALS; symbol++) s.codeLengths[symbol] = 8;
+    buildHuffman(s.lengths, s.codeLengths, OTA_GZIP_MAX_LITERALS);
+
+    for (symbol = 0; symbol < OTA_GZIP_MAX_DISTANCES; symbol++) s.codeLengths[symbol] = 5;
+    buildHuffman(s.distances, s.codeLengths, OTA_GZIP_MAX_DISTANCES);
+    return inflateCodes(s);
+}
+
+static bool inflateDynamic(OTAGzipState& s) {
+    uint16_t literals  = readBits(s, 5) + 257;
+    uint16_t distances = readBits(s, 5) + 1;
+    uint16_t codes     = readBits(s, 4) + 4;
+    if (s.overrun || literals > OTA_GZIP_MAX_LITERALS || distances > OTA_GZIP_MAX_DISTANCES) return false;
+
+    // Code lengths of the code length code, then the literal/length and distance code lengths with it
+    uint16_t index = 0;
+    for (; index < codes; index++) s.codeLengths[CODE_ORDER[index]] = readBits(s, 3);
+    for (; index < 19; index++) s.codeLengths[CODE_ORDER[index]] = 0;
+    if (s.overrun || !buildHuffman(s.lengths, s.codeLengths, 19)) return false;
+
+    index = 0;
+    while (index < literals + distances) {
+        int symbol = decodeSymbol(s, s.lengths);
+        if (symbol < 0) return false;
+        if (symbol < 16) {
+            s.codeLengths[index++] = symbol;
+            continue;
+        }
+
+        uint16_t repeat;
+        uint16_t length = 0;
+        if (symbol == 16) {
+            if (!index) return false;
+            length = s.codeLengths[index - 1];
+            repeat = 3 + readBits(s, 2);
+        } else if (symbol == 17) {
+            repeat = 3 + readBits(s, 3);
+        } else {
+            repeat = 11 + readBits(s, 7);
+        }
+        if (s.overrun || index + repeat > literals + distances) return false;
+        while (repeat--) s.codeLengths[index++] = length;
+    }
+    if (!s.codeLengths[256]) return false;                                                                              // No end of block code
+
+    if (!buildHuffman(s.lengths, s.codeLengths, literals) ||
+        !buildHuffman(s.distances, s.codeLengths + literals, distances)) {
+        return false;
+    }
+    return inflateCodes(s);
+}
+
+static bool skipGzipString(const uint8_t* data, size_t len, size_t& pos) {
+    while (pos < len) {
+        if (!data[pos++]) return true;
+    }
+    return false;
+}
+
+size_t OTAGzipPeek::headerLength(const uint8_t* data, size_t len) {
+    if (len < 10 || data[0] != 0x1F || data[1] != 0x8B || data[2] != 8) {
+        return 0;
+    }
+
+    uint8_t flags = data[3];
+    size_t  pos   = 10;
+    if (flags & 0x04) {                                                                                                 // FEXTRA
+        if (pos + 2 > len) return 0;
+        pos += 2 + (data[pos] | (data[pos + 1] << 8));
+    }
+    if ((flags & 0x08) && !skipGzipString(data, len, pos)) return 0;                                                   // FNAME
+    if ((flags & 0x10) && !skipGzipString(data, len, pos)) return 0;                                                   // FCOMMENT
+    if (flags & 0x02) pos += 2;                                                                                         // FHCRC
+    return pos <= len ? pos : 0;
+}
+
+size_t OTAGzipPeek::peek(const uint8_t* data, size_t len, uint8_t* out, size_t want) {
+    OTAGzipState* s = new (std::nothrow) OTAGzipState;
+    if (!s) {
+        return 0;
+    }
+    s->in       = data;
+    s->inLen    = len;
+    s->inPos    = 0;
+    s->bitBuf   = 0;
+    s->bitCount = 0;
+    s->overrun  = false;
+    s->out      = out;
+    s->outLen   = 0;
+    s->want     = want;
+
+    bool last = false;
+    while (!last && s->outLen < want) {
+        last = readBits(*s, 1);
+        uint32_t type = readBits(*s, 2);
+        bool ok = !s->overrun;
+        if (ok) {
+            switch (type) {
+                case 0:  ok = inflateStored(*s);  break;
+                case 1:  ok = inflateFixed(*s);   break;
+                case 2:  ok = inflateDynamic(*s); break;
+                default: ok = false;              break;
+            }
+        }
+        if (!ok) break;
+    }
+
+    size_t decoded = min(s->outLen, want);
+    delete s;
+    return decoded;
+}
+
+const char* OTAGzipPeek::compressedImageError(const uint8_t* data, size_t len) {
+    size_t header = headerLength(data, len);
+    if (!header) {
+        return nullptr;                                                                                                 // Plain upload, the caller checks it
+    }
+
+    uint8_t magic[4];
+    if (peek(data + header, len - header, magic, sizeof(magic)) < sizeof(magic)) {
+        return "Compressed upload could not be read";
+    }
+    if (memcmp(magic, OTA_PATCH_MAGIC, sizeof(magic)) == 0) {
+        return "Compressed delta patches need ESP32, upload the plain patch";
+    }
+    return magic[0] == 0xE9 ? nullptr : "Compressed upload is not a firmware image";
+}
@@ -0,0 +1,58 @@
+   /*
+ ====================================================================================================
+ * File:        OTAGzipPeek.h
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       First bytes of a gzip upload, without inflating the rest
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#ifndef OTAGZIPPEEK_H
+#define OTAGZIPPEEK_H
+
+#include <Arduino.h>
+
+/*
+ * eboot expands a gzip upload on ESP8266 after the reboot, so the portal only
+ * ever sees the compressed bytes. peek() decodes just enough of the deflate
+ * stream (RFC 1951) to return its first bytes, which tells an image (0xE9)
+ * from a delta patch or anything else before it is written to flash. Decoding
+ * stops at `want` bytes or at the end of the input it was given; the tables it
+ * needs (about 1.2 KB) are allocated for the call only.
+ */
+class OTAGzipPeek {
+public:
+    static size_t headerLength(const uint8_t* data, size_t len);                                                      // 0 if not a gzip stream (or header split across chunks)
+    static size_t peek(const uint8_t* data, size_t len, uint8_t* out, size_t want);                                    // Deflate data after the header, returns bytes decoded
+    static const char* compressedImageError(const uint8_t* data, size_t len);                                         // First upload bytes: nullptr unless gzip that is not a firmware image
+};
+
+#endif // OTAGZIPPEEK_H
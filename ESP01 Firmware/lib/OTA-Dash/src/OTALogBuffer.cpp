@@ -0,0 +1,196 @@
+   /*
+ ====================================================================================================
+ * File:        OTALogBuffer.cpp
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       Fixed-size ring buffer of debug log lines for the web portal
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#include "OTALogBuffer.h"
+
+#if defined(ESP32)
+    #define OTA_LOG_LOCK()                  std::lock_guard<std::mutex> guard(mutex)
+#else
+    #define OTA_LOG_LOCK()
+#endif
+
+OTALogBuffer::OTALogBuffer(size_t capacity, uint16_t maxLines) :
+    data        (new uint8_t[capacity]),
+    capacity    (capacity),
+    maxLines    (maxLines ? maxLines : 1) {
+}
+
+void OTALogBuffer::push(const char* text, size_t len) {
+    if (len > OTA_LOG_LINE_MAX) {
+        len = OTA_LOG_LINE_MAX;
+        while (len && (text[len] & 0xC0) == 0x80) {                                                                    // Don't split a UTF-8 character, browsers drop the socket on it
+            len--;
+        }
+    }
+    if (len + 2 > capacity) {
+        return;
+    }
+
+    OTA_LOG_LOCK();
+    while (count && (capacity - used < len + 2 || count >= maxLines)) {
+        dropOldest();
+    }
+
+    data[head] = len & 0xFF;
+    data[advance(head, 1)] = len >> 8;
+
+    size_t start = advance(head, 2);
+    size_t first = std::min(len, capacity - start);
+    memcpy(&data[start], text, first);
+    memcpy(&data[0], text + first, len - first);
+
+    head = advance(head, len + 2);
+    used += len + 2;
+    count++;
+}
+
+void OTALogBuffer::setMaxLines(uint16_t lines) {
+    OTA_LOG_LOCK();
+    maxLines = lines ? lines : 1;
+    while (count > maxLines) {
+        dropOldest();
+    }
+}
+
+uint32_t OTALogBuffer::firstSeq() const {
+    OTA_LOG_LOCK();
+    return tailSeq;
+}
+
+uint32_t OTALogBuffer::nextSeq() const {
+    OTA_LOG_LOCK();
+    return tailSeq + count;
+}
+
+uint16_t OTALogBuffer::lines() const {
+    OTA_LOG_LOCK();
+    return count;
+}
+
+size_t OTALogBuffer::writeJson(uint32_t& seq, uint16_t& written, char* out, size_t maxLen) {
+    OTA_LOG_LOCK();
+    if ((int32_t)(seq - tailSeq) < 0 || (int32_t)(seq - tailSeq) > count) {
+        seq = tailSeq;                                                                                                  // Overwritten since the last read
+    }
+
+    size_t offset = tail;
+    for (uint32_t skip = seq - tailSeq; skip; skip--) {
+        offset = advance(offset, lengthAt(offset) + 2);
+    }
+
+    size_t pos = 0;
+    written = 0;
+    for (uint32_t remaining = tailSeq + count - seq; remaining; remaining--) {
+        uint16_t len = lengthAt(offset);
+        size_t separator = written ? 1 : 0;
+        if (pos + separator >= maxLen) {
+            break;
+        }
+        size_t escaped = escape(advance(offset, 2), len, out + pos + separator, maxLen - pos - separator);
+        if (!escaped) {
+            break;
+        }
+        if (separator) {
+            out[pos] = ',';
+        }
+        pos += separator + escaped;
+        offset = advance(offset, len + 2);
+        written++;
+    }
+    return pos;
+}
+
+void OTALogBuffer::dropOldest() {
+    size_t len = lengthAt(tail) + 2;
+    tail = advance(tail, len);
+    used -= len;
+    tailSeq++;
+    count--;
+}
+
+uint16_t OTALogBuffer::lengthAt(size_t offset) const {
+    return data[offset] | (data[advance(offset, 1)] << 8);
+}
+
+size_t OTALogBuffer::advance(size_t offset, size_t len) const {
+    offset += len;
+    return offset >= capacity ? offset - capacity : offset;
+}
+
+size_t OTALogBuffer::escape(size_t offset, uint16_t len, char* out, size_t maxLen) const {
+    static const char hex[] = "0123456789abcdef";
+    size_t pos = 0;
+
+    if (maxLen < 2) {
+        return 0;
+    }
+    out[pos++] = '"';
+
+    for (uint16_t i = 0; i < len; i++, offset = advance(offset, 1)) {
+        char c = data[offset];
+        char sequence[6];
+        size_t n = 2;
+
+        sequence[0] = '\\';
+        switch (c) {
+            case '"':  sequence[1] = '"';  break;
+            case '\\': sequence[1] = '\\'; break;
+            case '\n': sequence[1] = 'n';  break;
+            case '\r': sequence[1] = 'r';  break;
+            case '\t': sequence[1] = 't';  break;
+            default:
+                if ((uint8_t)c < 0x20) {                                                                                // Other control characters as \u00XX
+                    memcpy(sequence + 1, "u00", 3);
+                    sequence[4] = hex[c >> 4];
+                    sequence[5] = hex[c & 0x0F];
+                    n = 6;
+                } else {
+                    sequence[0] = c;
+                    n = 1;
+                }
+        }
+
+        if (pos + n + 1 > maxLen) {                                                                                     // Room for the closing quote
+            return 0;
+        }
+        memcpy(out + pos, sequence, n);
+        pos += n;
+    }
+
+    out[pos++] = '"';
+    return pos;
+}
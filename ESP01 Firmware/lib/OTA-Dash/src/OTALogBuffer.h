@@ -0,0 +1,92 @@
+   /*
+ ====================================================================================================
+ * File:        OTALogBuffer.h
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       Fixed-size ring buffer of debug log lines for the web portal
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#ifndef OTALOGBUFFER_H
+#define OTALOGBUFFER_H
+
+#include <Arduino.h>
+#include <memory>
+
+#if defined(ESP32)
+    #include <mutex>
+#endif
+
+#define OTA_LOG_LINE_MAX                    192            // Longer lines are cut, so one line always fits a frame
+#define OTA_LOG_JSON_MAX                    (OTA_LOG_LINE_MAX * 6 + 3)  // One line escaped as a JSON string, worst case
+
+/*
+ * Log lines are stored back to back as u16 length + text in one byte ring.
+ * Every line gets a sequence number. When a new line does not fit, the oldest
+ * lines are dropped, so memory stays fixed however busy the logs are. Readers
+ * keep the sequence number of the next line they want. If that line was
+ * already overwritten, reading restarts at the oldest line still held.
+ */
+class OTALogBuffer {
+public:
+    OTALogBuffer(size_t capacity, uint16_t maxLines);
+
+    void push(const char* text, size_t len);
+    void setMaxLines(uint16_t lines);
+
+    uint32_t firstSeq() const;
+    uint32_t nextSeq()  const;
+    uint16_t lines()    const;
+
+    // Writes lines from seq on as comma separated JSON strings, whole lines only.
+    // seq returns the first line written and count how many were.
+    size_t writeJson(uint32_t& seq, uint16_t& count, char* out, size_t maxLen);
+
+private:
+    std::unique_ptr<uint8_t[]>                          data;
+    size_t                                              capacity;
+    size_t                                              head                    = 0;                                // Where the next line goes
+    size_t                                              tail                    = 0;                                // Oldest line
+    size_t                                              used                    = 0;
+    uint32_t                                            tailSeq                 = 0;
+    uint16_t                                            count                   = 0;
+    uint16_t                                            maxLines;
+    #if defined(ESP32)
+        mutable std::mutex                              mutex;                                                      // printDebug may run on any task
+    #endif
+
+    void dropOldest();
+    uint16_t lengthAt(size_t offset) const;
+    size_t advance(size_t offset, size_t len) const;
+    size_t escape(size_t offset, uint16_t len, char* out, size_t maxLen) const;
+};
+
+#endif // OTALOGBUFFER_H
@@ -0,0 +1,339 @@
+   /*
+ ====================================================================================================
+ * File:        OTAPatch.cpp
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       Streaming delta firmware updates applied against the running image
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#include "OTAPatch.h"
+
+#if defined(ESP32)
+    #include <mbedtls/version.h>
+    #include <esp_ota_ops.h>
+    #include <esp_partition.h>
+#endif
+
+enum : uint8_t {
+    OTA_PATCH_OP_END                                    = 0x00,
+    OTA_PATCH_OP_COPY                                   = 0x01,
+    OTA_PATCH_OP_ADD                                    = 0x02,
+    OTA_PATCH_OP_INSERT                                 = 0x03,
+    OTA_PATCH_OP_SEEK                                   = 0x04
+};
+
+static uint32_t readLE32(const uint8_t* data) {
+    return data[0] | (data[1] << 8) | (data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+void OTASha256::begin() {
+    #if defined(ESP32)
+        mbedtls_sha256_init(&context);
+        #if MBEDTLS_VERSION_NUMBER >= 0x03000000
+            mbedtls_sha256_starts(&context, 0);
+        #else
+            mbedtls_sha256_starts_ret(&context, 0);
+        #endif
+    #elif defined(ESP8266)
+        br_sha256_init(&context);
+    #endif
+}
+
+void OTASha256::update(const uint8_t* data, size_t len) {
+    #if defined(ESP32)
+        #if MBEDTLS_VERSION_NUMBER >= 0x03000000
+            mbedtls_sha256_update(&context, data, len);
+        #else
+            mbedtls_sha256_update_ret(&context, data, len);
+        #endif
+    #elif defined(ESP8266)
+        br_sha256_update(&context, data, len);
+    #endif
+}
+
+void OTASha256::finish(uint8_t digest[OTA_PATCH_SHA256_SIZE]) {
+    #if defined(ESP32)
+        #if MBEDTLS_VERSION_NUMBER >= 0x03000000
+            mbedtls_sha256_finish(&context, digest);
+        #else
+            mbedtls_sha256_finish_ret(&context, digest);
+        #endif
+        mbedtls_sha256_free(&context);
+    #elif defined(ESP8266)
+        br_sha256_out(&context, digest);
+    #endif
+}
+
+bool OTAPatch::isPatch(const uint8_t* data, size_t len) {
+    return len >= 4 && memcmp(data, OTA_PATCH_MAGIC, 4) == 0;
+}
+
+void OTAPatch::begin(Writer writer, Reader reader) {
+    this->writer    = writer;
+    this->reader    = reader ? reader : readRunningImage;
+    state           = State::HEADER;
+    currentStatus   = Status::OK;
+    headerFill      = 0;
+    sourceLength    = 0;
+    sourcePos       = 0;
+    targetLength    = 0;
+    targetWritten   = 0;
+    targetHash.begin();
+}
+
+bool OTAPatch::write(const uint8_t* data, size_t len) {
+    while (len && currentStatus == Status::OK) {
+        switch (state) {
+            case State::HEADER: {
+                size_t n = min(len, (size_t)(OTA_PATCH_HEADER_SIZE - headerFill));
+                memcpy(header + headerFill, data, n);
+                headerFill += n;
+                data += n;
+                len  -= n;
+                if (headerFill == OTA_PATCH_HEADER_SIZE) {
+                    parseHeader();
+                }
+                break;
+            }
+            case State::OPCODE:
+                opcode = *data++;
+                len--;
+                if (opcode == OTA_PATCH_OP_END) {
+                    state = State::DONE;
+                } else if (opcode > OTA_PATCH_OP_SEEK) {
+                    fail(Status::CORRUPT);
+                } else {
+                    length      = 0;
+                    lengthShift = 0;
+                    state       = State::LENGTH;
+                }
+                break;
+
+            case State::LENGTH: {
+                uint8_t byte = *data++;
+                len--;
+                if (lengthShift > 28) {
+                    fail(Status::CORRUPT);
+                    break;
+                }
+                length |= (uint32_t)(byte & 0x7F) << lengthShift;
+                lengthShift += 7;
+                if (!(byte & 0x80)) {
+                    runOp();
+                }
+                break;
+            }
+            case State::DATA: {
+                size_t used = consumeData(data, len);
+                data += used;
+                len  -= used;
+                break;
+            }
+            case State::DONE:
+                fail(Status::CORRUPT);                                                                                  // Bytes after END
+                break;
+        }
+    }
+    return currentStatus == Status::OK;
+}
+
+bool OTAPatch::end() {
+    if (currentStatus != Status::OK) {
+        return false;
+    }
+    if (state != State::DONE || targetWritten != targetLength) {
+        return fail(Status::CORRUPT);
+    }
+
+    // After patching: what went to flash must be exactly the image the patch was made for
+    uint8_t digest[OTA_PATCH_SHA256_SIZE];
+    targetHash.finish(digest);
+    if (memcmp(digest, header + 16 + OTA_PATCH_SHA256_SIZE, OTA_PATCH_SHA256_SIZE) != 0) {
+        return fail(Status::TARGET_MISMATCH);
+    }
+    return true;
+}
+
+const char* OTAPatch::statusString() const {
+    switch (currentStatus) {
+        case Status::OK:                return "OK";
+        case Status::BAD_HEADER:        return "Not a delta patch";
+        case Status::SOURCE_MISMATCH:   return "Patch was made for a different firmware";
+        case Status::CORRUPT:           return "Patch is corrupt or truncated";
+        case Status::READ_FAILED:       return "Reading the running firmware failed";
+        case Status::WRITE_FAILED:      return "Writing the new firmware failed";
+        case Status::TARGET_MISMATCH:   return "Patched firmware does not match its checksum";
+    }
+    return "Unknown";
+}
+
+bool OTAPatch::fail(Status status) {
+    currentStatus = status;
+    return false;
+}
+
+bool OTAPatch::parseHeader() {
+    if (!isPatch(header, OTA_PATCH_HEADER_SIZE)) {
+        return fail(Status::BAD_HEADER);
+    }
+    sourceLength = readLE32(header + 4);
+    targetLength = readLE32(header + 8);
+    if (!sourceLength || !targetLength) {
+        return fail(Status::BAD_HEADER);
+    }
+
+    // Before patching: the running image must be the one the patch was made against
+    OTASha256 sourceHash;
+    sourceHash.begin();
+    for (uint32_t offset = 0; offset < sourceLength; offset += OTA_PATCH_CHUNK) {
+        size_t n = min((uint32_t)OTA_PATCH_CHUNK, sourceLength - offset);
+        if (!readSource(offset, buffer, n)) {
+            return false;
+        }
+        sourceHash.update(buffer, n);
+        #if defined(ESP8266)
+            if (!(offset & 0xFFFF)) {
+                ESP.wdtFeed();                                                                                          // Hashing the image takes a few hundred ms
+            }
+        #endif
+    }
+
+    uint8_t digest[OTA_PATCH_SHA256_SIZE];
+    sourceHash.finish(digest);
+    if (memcmp(digest, header + 16, OTA_PATCH_SHA256_SIZE) != 0) {
+        return fail(Status::SOURCE_MISMATCH);
+    }
+
+    state = State::OPCODE;
+    return true;
+}
+
+bool OTAPatch::runOp() {
+    state = State::OPCODE;
+
+    switch (opcode) {
+        case OTA_PATCH_OP_COPY:
+            if ((uint64_t)sourcePos + length > sourceLength) {
+                return fail(Status::CORRUPT);
+            }
+            while (length) {
+                size_t n = min(length, (uint32_t)OTA_PATCH_CHUNK);
+                if (!readSource(sourcePos, buffer, n) || !emit(buffer, n)) {
+                    return false;
+                }
+                sourcePos += n;
+                length    -= n;
+            }
+            return true;
+
+        case OTA_PATCH_OP_ADD:
+            if ((uint64_t)sourcePos + length > sourceLength) {
+                return fail(Status::CORRUPT);
+            }
+            // fall through
+        case OTA_PATCH_OP_INSERT:
+            if (length) {
+                state = State::DATA;
+            }
+            return true;
+
+        case OTA_PATCH_OP_SEEK: {
+            int64_t position = (int64_t)sourcePos + (int32_t)((length >> 1) ^ (0 - (length & 1)));
+            if (position < 0 || position > sourceLength) {
+                return fail(Status::CORRUPT);
+            }
+            sourcePos = (uint32_t)position;
+            return true;
+        }
+    }
+    return fail(Status::CORRUPT);
+}
+
+size_t OTAPatch::consumeData(const uint8_t* data, size_t len) {
+    size_t n = min(len, (size_t)min(length, (uint32_t)OTA_PATCH_CHUNK));
+
+    if (opcode == OTA_PATCH_OP_ADD) {
+        if (!readSource(sourcePos, buffer, n)) {
+            return 0;
+        }
+        for (size_t i = 0; i < n; i++) {
+            buffer[i] += data[i];
+        }
+        if (!emit(buffer, n)) {
+            return 0;
+        }
+        sourcePos += n;
+    } else if (!emit(data, n)) {
+        return 0;
+    }
+
+    length -= n;
+    if (!length) {
+        state = State::OPCODE;
+    }
+    return n;
+}
+
+bool OTAPatch::readSource(uint32_t offset, uint8_t* data, size_t len) {
+    if (!reader(offset, data, len)) {
+        return fail(Status::READ_FAILED);
+    }
+    for (uint32_t i = 2; i < 4; i++) {                                                                                  // Image header as built, not as flashed
+        if (i >= offset && i < offset + len) {
+            data[i - offset] = header[12 + i - 2];
+        }
+    }
+    return true;
+}
+
+bool OTAPatch::emit(const uint8_t* data, size_t len) {
+    if ((uint64_t)targetWritten + len > targetLength) {
+        return fail(Status::CORRUPT);
+    }
+    targetHash.update(data, len);
+    if (!writer(data, len)) {
+        return fail(Status::WRITE_FAILED);
+    }
+    targetWritten += len;
+    return true;
+}
+
+bool OTAPatch::readRunningImage(uint32_t offset, uint8_t* data, size_t len) {
+    #if defined(ESP32)
+        static const esp_partition_t* running = esp_ota_get_running_partition();
+        return running && esp_partition_read(running, offset, data, len) == ESP_OK;
+    #elif defined(ESP8266)
+        return ESP.flashRead(offset, data, len);                                                                        // The sketch image starts at flash offset 0
+    #else
+        return false;
+    #endif
+}
@@ -0,0 +1,140 @@
+   /*
+ ====================================================================================================
+ * File:        OTAPatch.h
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       Streaming delta firmware updates applied against the running image
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#ifndef OTAPATCH_H
+#define OTAPATCH_H
+
+#include <Arduino.h>
+#include <functional>
+
+#if defined(ESP32)
+    #include <mbedtls/sha256.h>
+#elif defined(ESP8266)
+    #include <bearssl/bearssl_hash.h>
+#endif
+
+#define OTA_PATCH_MAGIC                     "ODP1"
+#define OTA_PATCH_HEADER_SIZE               80             // Magic, sizes, source image bytes 2-3, source and target SHA-256
+#define OTA_PATCH_CHUNK                     256            // Source bytes read from flash per step
+#define OTA_PATCH_SHA256_SIZE               32
+
+/*
+ * Patch format (little endian), produced by scripts/ota_delta.py:
+ *
+ *   header   "ODP1", u32 source size, u32 target size, u8[2] source image bytes 2-3,
+ *            u16 reserved, u8[32] source SHA-256, u8[32] target SHA-256
+ *   ops      u8 opcode followed by a LEB128 length
+ *              0x01 COPY   n       target <- source[pos, pos + n), pos += n
+ *              0x02 ADD    n bytes target <- source[pos + i] + byte[i], pos += n
+ *              0x03 INSERT n bytes target <- byte[i]
+ *              0x04 SEEK   d       pos += d (zigzag encoded)
+ *              0x00 END
+ *
+ * The source is the running image. Bytes 2-3 of an image header (flash mode and
+ * size) are rewritten by esptool when flashing over serial, so the patch carries
+ * the values the source was built with and they replace what is read from flash.
+ */
+
+class OTASha256 {
+public:
+    void begin();
+    void update(const uint8_t* data, size_t len);
+    void finish(uint8_t digest[OTA_PATCH_SHA256_SIZE]);
+
+private:
+    #if defined(ESP32)
+        mbedtls_sha256_context                          context;
+    #elif defined(ESP8266)
+        br_sha256_context                               context;
+    #endif
+};
+
+class OTAPatch {
+public:
+    enum class Status {
+        OK,
+        BAD_HEADER,
+        SOURCE_MISMATCH,
+        CORRUPT,
+        READ_FAILED,
+        WRITE_FAILED,
+        TARGET_MISMATCH
+    };
+
+    typedef std::function<bool(uint32_t offset, uint8_t* data, size_t len)> Reader;
+    typedef std::function<bool(const uint8_t* data, size_t len)>            Writer;
+
+    static bool isPatch(const uint8_t* data, size_t len);
+
+    void begin(Writer writer, Reader reader = nullptr);                                                                 // Default reader: the running firmware image
+    bool write(const uint8_t* data, size_t len);
+    bool end();
+
+    Status      status()        const               { return currentStatus;                                     }
+    uint32_t    targetSize()    const               { return targetLength;                                      }
+    uint32_t    written()       const               { return targetWritten;                                     }
+    const char* statusString()  const;
+
+private:
+    enum class State { HEADER, OPCODE, LENGTH, DATA, DONE };
+
+    State                                               state                   = State::HEADER;
+    Status                                              currentStatus           = Status::OK;
+    Reader                                              reader;
+    Writer                                              writer;
+    OTASha256                                           targetHash;
+    uint8_t                                             header[OTA_PATCH_HEADER_SIZE];
+    uint8_t                                             buffer[OTA_PATCH_CHUNK];
+    uint8_t                                             opcode                  = 0;
+    uint8_t                                             lengthShift             = 0;
+    uint32_t                                            headerFill              = 0;
+    uint32_t                                            length                  = 0;
+    uint32_t                                            sourceLength            = 0;
+    uint32_t                                            sourcePos               = 0;
+    uint32_t                                            targetLength            = 0;
+    uint32_t                                            targetWritten           = 0;
+
+    bool fail(Status status);
+    bool parseHeader();
+    bool runOp();
+    bool readSource(uint32_t offset, uint8_t* data, size_t len);
+    bool emit(const uint8_t* data, size_t len);
+    size_t consumeData(const uint8_t* data, size_t len);
+    static bool readRunningImage(uint32_t offset, uint8_t* data, size_t len);
+};
+
+#endif // OTAPATCH_H
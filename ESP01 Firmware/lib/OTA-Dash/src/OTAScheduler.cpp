@@ -0,0 +1,122 @@
+   /*
+ ====================================================================================================
+ * File:        OTAScheduler.cpp
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       Deferred jobs for the web portal, run from the application loop
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#include "OTAScheduler.h"
+
+#if defined(ESP32)
+    #define OTA_SCHEDULER_LOCK()            std::lock_guard<std::mutex> guard(mutex)
+#else
+    #define OTA_SCHEDULER_LOCK()
+#endif
+
+void OTAScheduler::setJob(uint8_t id, Job job) {
+    OTA_SCHEDULER_LOCK();
+    entries[id].job = job;
+}
+
+void OTAScheduler::onArm(Job hook) {
+    OTA_SCHEDULER_LOCK();
+    armHook = hook;
+}
+
+void OTAScheduler::schedule(uint8_t id, uint32_t delayMs) {
+    {
+        OTA_SCHEDULER_LOCK();
+        entries[id].due = millis() + delayMs;
+        entries[id].armed = true;
+    }
+    if (armHook) armHook();
+}
+
+void OTAScheduler::scheduleWithin(uint8_t id, uint32_t delayMs) {
+    {
+        OTA_SCHEDULER_LOCK();
+        uint32_t due = millis() + delayMs;
+        if (entries[id].armed && (int32_t)(entries[id].due - due) <= 0) {
+            return;                                                                                                     // Due sooner already, the loop knows
+        }
+        entries[id].due = due;
+        entries[id].armed = true;
+    }
+    if (armHook) armHook();
+}
+
+void OTAScheduler::cancel(uint8_t id) {
+    OTA_SCHEDULER_LOCK();
+    entries[id].armed = false;
+}
+
+bool OTAScheduler::isScheduled(uint8_t id) const {
+    OTA_SCHEDULER_LOCK();
+    return entries[id].armed;
+}
+
+uint32_t OTAScheduler::run(uint32_t now, uint8_t maxJobs) {
+    uint8_t ran = 0;
+    for (uint8_t i = 0; i < OTA_SCHEDULER_MAX_JOBS && ran < maxJobs; i++) {
+        uint8_t id = (cursor + i) % OTA_SCHEDULER_MAX_JOBS;
+        Job job;
+        {
+            OTA_SCHEDULER_LOCK();
+            Entry& entry = entries[id];
+            if (!entry.armed || (int32_t)(now - entry.due) < 0) {
+                continue;
+            }
+            entry.armed = false;                                                                                        // Disarmed first, the job may arm itself again
+            job = entry.job;
+        }
+        if (job) {
+            job();
+        }
+        if (++ran == maxJobs) {
+            cursor = (id + 1) % OTA_SCHEDULER_MAX_JOBS;                                                                 // Whatever is still due goes first next time
+        }
+    }
+    return nextDue(now);
+}
+
+uint32_t OTAScheduler::nextDue(uint32_t now) const {
+    uint32_t next = OTA_SCHEDULER_IDLE;
+    OTA_SCHEDULER_LOCK();
+    for (const Entry& entry : entries) {
+        if (entry.armed) {
+            int32_t wait = (int32_t)(entry.due - now);
+            next = std::min<uint32_t>(next, wait < 0 ? 0 : wait);
+        }
+    }
+    return next;
+}
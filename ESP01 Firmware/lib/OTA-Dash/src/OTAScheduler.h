@@ -0,0 +1,87 @@
+   /*
+ ====================================================================================================
+ * File:        OTAScheduler.h
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       Deferred jobs for the web portal, run from the application loop
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#ifndef OTASCHEDULER_H
+#define OTASCHEDULER_H
+
+#include <Arduino.h>
+#include <functional>
+
+#if defined(ESP32)
+    #include <mutex>
+#endif
+
+#define OTA_SCHEDULER_MAX_JOBS              8
+#define OTA_SCHEDULER_IDLE                  0xFFFFFFFF     // run(): nothing scheduled
+
+/*
+ * A fixed table of jobs, each run at most once per arming. Request handlers
+ * and WiFi events only arm jobs, nothing runs in their context. run() is
+ * called from the loop, executes what is due and reports how long until the
+ * next job, so an idle portal does no work at all. Sharing the loop with other
+ * work, run() can be limited to a few jobs per call.
+ */
+class OTAScheduler {
+public:
+    typedef std::function<void()> Job;
+
+    void setJob(uint8_t id, Job job);
+    void onArm(Job hook);                                                                                               // Runs in the arming context once a job is armed
+    void schedule(uint8_t id, uint32_t delayMs);                                                                        // Replaces any earlier arming
+    void scheduleWithin(uint8_t id, uint32_t delayMs);                                                                  // Keeps an arming that is due sooner
+    void cancel(uint8_t id);
+    bool isScheduled(uint8_t id) const;
+    uint32_t nextDue(uint32_t now) const;                                                                               // ms until a job is due, OTA_SCHEDULER_IDLE if none is armed
+
+    uint32_t run(uint32_t now, uint8_t maxJobs = OTA_SCHEDULER_MAX_JOBS);                                              // Stops after maxJobs, the rest stay due
+
+private:
+    struct Entry {
+        Job                                             job;
+        uint32_t                                        due                     = 0;
+        bool                                            armed                   = false;
+    };
+
+    Entry                                               entries[OTA_SCHEDULER_MAX_JOBS];
+    Job                                                 armHook;                                                    // Wakes a loop() sleeping on nextDue()
+    uint8_t                                             cursor                  = 0;                                // First job looked at by a limited run(), rotates so none starves
+    #if defined(ESP32)
+        mutable std::mutex                              mutex;                                                      // Handlers arm jobs from the async_tcp task
+    #endif
+};
+
+#endif // OTASCHEDULER_H
@@ -0,0 +1,161 @@
+   /*
+ ====================================================================================================
+ * File:        OTAVerifier.cpp
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       Signed firmware, verified while the upload streams past
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#include "OTAVerifier.h"
+
+#if defined(ESP32)
+    #include <mbedtls/ecdsa.h>
+#elif defined(ESP8266)
+    #include <bearssl/bearssl_ec.h>
+#endif
+
+const uint8_t* OTAVerifier::publicKey = nullptr;
+
+void OTAVerifier::setPublicKey(const uint8_t* key) {
+    publicKey = key;
+}
+
+bool OTAVerifier::acceptsUnsigned() {
+    #if defined(OTA_ALLOW_UNSIGNED)
+        return publicKey == nullptr;
+    #else
+        return false;
+    #endif
+}
+
+void OTAVerifier::begin(Writer writer) {
+    this->writer  = writer;
+    currentStatus = publicKey ? Status::OK : Status::NO_KEY;                                                            // Fail closed, write() refuses everything
+    tailLen       = 0;
+    hash.begin();
+}
+
+bool OTAVerifier::write(const uint8_t* data, size_t len) {
+    if (currentStatus != Status::OK) {
+        return false;
+    }
+    if (tailLen + len <= OTA_SIGNATURE_TRAILER) {
+        memcpy(tail + tailLen, data, len);
+        tailLen += len;
+        return true;
+    }
+
+    // Release the oldest bytes, held ones first, so exactly the last OTA_SIGNATURE_TRAILER stay
+    size_t release  = tailLen + len - OTA_SIGNATURE_TRAILER;
+    size_t fromTail = std::min(release, tailLen);
+    if (fromTail) {
+        if (!forward(tail, fromTail)) return false;
+        memmove(tail, tail + fromTail, tailLen - fromTail);
+        tailLen -= fromTail;
+    }
+    size_t fromData = release - fromTail;
+    if (fromData && !forward(data, fromData)) return false;
+    memcpy(tail + tailLen, data + fromData, len - fromData);
+    tailLen += len - fromData;
+    return true;
+}
+
+bool OTAVerifier::end() {
+    if (currentStatus != Status::OK) {
+        return false;
+    }
+    if (tailLen < OTA_SIGNATURE_TRAILER || memcmp(tail + OTA_SIGNATURE_SIZE, OTA_SIGNATURE_MAGIC, 4) != 0) {
+        currentStatus = Status::UNSIGNED;
+        return false;
+    }
+
+    uint8_t digest[OTA_PATCH_SHA256_SIZE];
+    hash.finish(digest);
+    if (!verify(digest, tail)) {
+        currentStatus = Status::BAD_SIGNATURE;
+        return false;
+    }
+    return true;
+}
+
+const char* OTAVerifier::statusString() const {
+    switch (currentStatus) {
+        case Status::OK:                return "OK";
+        case Status::UNSIGNED:          return "Firmware is not signed";
+        case Status::BAD_SIGNATURE:     return "Firmware signature is not valid";
+        case Status::NO_KEY:            return "No signing key built in, updates are disabled";
+        case Status::WRITE_FAILED:      return "Writing the new firmware failed";
+    }
+    return "Unknown";
+}
+
+bool OTAVerifier::forward(const uint8_t* data, size_t len) {
+    hash.update(data, len);
+    if (!writer(data, len)) {
+        currentStatus = Status::WRITE_FAILED;
+        return false;
+    }
+    return true;
+}
+
+bool OTAVerifier::verify(const uint8_t* digest, const uint8_t* signature) const {
+    uint8_t key[OTA_SIGNATURE_KEY_SIZE];
+    memcpy_P(key, publicKey, sizeof(key));
+
+    #if defined(ESP32)
+        mbedtls_ecp_group group;
+        mbedtls_ecp_point point;
+        mbedtls_mpi       r, s;
+        mbedtls_ecp_group_init(&group);
+        mbedtls_ecp_point_init(&point);
+        mbedtls_mpi_init(&r);
+        mbedtls_mpi_init(&s);
+
+        bool valid = mbedtls_ecp_group_load(&group, MBEDTLS_ECP_DP_SECP256R1) == 0
+                  && mbedtls_ecp_point_read_binary(&group, &point, key, sizeof(key)) == 0
+                  && mbedtls_mpi_read_binary(&r, signature, OTA_SIGNATURE_SIZE / 2) == 0
+                  && mbedtls_mpi_read_binary(&s, signature + OTA_SIGNATURE_SIZE / 2, OTA_SIGNATURE_SIZE / 2) == 0
+                  && mbedtls_ecdsa_verify(&group, digest, OTA_PATCH_SHA256_SIZE, &point, &r, &s) == 0;
+
+        mbedtls_mpi_free(&s);
+        mbedtls_mpi_free(&r);
+        mbedtls_ecp_point_free(&point);
+        mbedtls_ecp_group_free(&group);
+        return valid;
+    #elif defined(ESP8266)
+        br_ec_public_key pk;
+        pk.curve = BR_EC_secp256r1;
+        pk.q     = key;
+        pk.qlen  = sizeof(key);
+        return br_ecdsa_i15_vrfy_raw(&br_ec_p256_m15, digest, OTA_PATCH_SHA256_SIZE, &pk, signature, OTA_SIGNATURE_SIZE) == 1;
+    #endif
+}
@@ -0,0 +1,98 @@
+   /*
+ ====================================================================================================
+ * File:        OTAVerifier.h
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.0.0
+ * Date:        Oct 18 2025
+ * Brief:       Signed firmware, verified while the upload streams past
+ * 
+ ====================================================================================================
+ * License: 
+ * MIT License
+ * 
+ * Copyright (c) 2025 Hamas Saeed
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ * 
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+
+#ifndef OTAVERIFIER_H
+#define OTAVERIFIER_H
+
+#include <Arduino.h>
+#include <functional>
+#include "OTAPatch.h"
+
+#define OTA_SIGNATURE_MAGIC                 "ODS1"
+#define OTA_SIGNATURE_SIZE                  64             // ECDSA P-256, r and s
+#define OTA_SIGNATURE_TRAILER               68             // Signature, then the magic
+#define OTA_SIGNATURE_KEY_SIZE              65             // Uncompressed P-256 public key
+
+/*
+ * Signed uploads end in a trailer: the ECDSA P-256 signature over the SHA-256
+ * of everything before it, followed by "ODS1" (scripts/ota_sign.py). The
+ * verifier sits in the upload stream. It hashes what passes through, holds
+ * back the last bytes, which may turn out to be the trailer, and checks the
+ * signature when the stream ends, before the update is installed. Nothing is
+ * read back from flash and nothing extra is sent.
+ *
+ * The public key is one for the whole device, shared by every update path.
+ * Without a key nothing is installed: the verifier refuses the first write.
+ * Builds that define OTA_ALLOW_UNSIGNED accept images unsigned instead.
+ */
+class OTAVerifier {
+public:
+    enum class Status {
+        OK,
+        UNSIGNED,
+        BAD_SIGNATURE,
+        NO_KEY,
+        WRITE_FAILED
+    };
+
+    typedef std::function<bool(const uint8_t* data, size_t len)> Writer;
+
+    static void setPublicKey(const uint8_t* key);                                                                       // PROGMEM, OTA_SIGNATURE_KEY_SIZE bytes
+    static bool enabled()                               { return publicKey != nullptr;                              }
+    static bool acceptsUnsigned();                                                                                      // No key and built with OTA_ALLOW_UNSIGNED
+
+    void begin(Writer writer);
+    bool write(const uint8_t* data, size_t len);                                                                        // Passes on all but the trailer candidate
+    bool end();                                                                                                         // true once the signature checks out
+
+    Status      status()        const               { return currentStatus;                                     }
+    const char* statusString()  const;
+
+private:
+    static const uint8_t*                               publicKey;
+
+    Writer                                              writer;
+    OTASha256                                           hash;
+    Status                                              currentStatus           = Status::OK;
+    uint8_t                                             tail[OTA_SIGNATURE_TRAILER];
+    size_t                                              tailLen                 = 0;
+
+    bool forward(const uint8_t* data, size_t len);
+    bool verify(const uint8_t* digest, const uint8_t* signature) const;
+};
+
+#endif // OTAVERIFIER_H
@@ -1,27 +1,27 @@
-   /*
+/*
  ====================================================================================================
  * File:        WebPages.h
  * Author:      Hamas Saeed
- * Version:     Rev_1.0.0
+ * Version:     Rev_1.1.0
  * Date:        Feb 10 2025
- * Brief:       This File Contains HTML Templates For Web Pages Used In OTADash
- * 
+ * Brief:       Generated From "web pages/*.html" By scripts/build_web_pages.py, Do Not Edit
+ *
  ====================================================================================================
- * License: 
+ * License:
  * MIT License
- * 
+ *
  * Copyright (c) 2025 Hamas Saeed
- * 
+ *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
  * in the Software without restriction, including without limitation the rights
  * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
  * copies of the Software, and to permit persons to whom the Software is
  * furnished to do so, subject to the following conditions:
- * 
+ *
  * The above copyright notice and this permission notice shall be included in all
  * copies or substantial portions of the Software.
- * 
+ *
  * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
  * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
  * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
@@ -29,7 +29,7 @@
  * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
- * 
+ *
  * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
  *
  ====================================================================================================
@@ -40,892 +40,486 @@
 
 #include <Arduino.h>
 
-static const char index_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE HTML>
-<html>
-<head>
-  <title>Device Control Portal</title>
-  <meta name="viewport" content="width=device-width, initial-scale=1">
-  <style>
-    body {
-      display: flex;
-      justify-content: center; 
-      align-items: center;
-      text-align: center; 
-      font-family: "Arial"; 
-      background-color: #e0f7fa; 
-      color: #006064; 
-      margin: 0; 
-      padding: 0; 
-    }
-    .container {
-      width: 400px; 
-      height: auto; 
-      display: flex; 
-      flex-direction: column;
-      align-items: center;
-      margin-top: 50px; 
-      background: #ffffff; 
-      padding: 20px; 
-      border-radius: 10px; 
-      box-shadow: 0 0 10px rgba(0, 0, 0, 0.1); 
-    }
-    .button { 
-      padding: 10px 20px; 
-      font-size: 18px; 
-      margin: 10px; 
-      cursor: pointer; 
-      border: none; 
-      border-radius: 5px; 
-      background-color: #00838f; 
-      color: #ffffff; 
-      text-decoration: none; 
-      display: inline-block;
-      width: 160px; 
-      height: 20px;
-      text-align: center;
-      line-height: 20px;
-    }
-    .note {
-      margin-top: 10px; 
-      font-size: 14px; 
-      color: #004d40; 
-    }
-    .note h5 {
-      margin-bottom: 5px; 
-    }
-    .separator {
-      width: 100%; 
-      height: 1px;
-      background-color: #004d40; 
-      margin: 20px 0px;
-    }
-  </style>
-</head>
-<body>
-  <div class="container">
-    <h1>%PORTAL_HEADING%</h1>
-    <a href="/info" class="button">Device Info</a>
-    <a href="/wifimanage" class="button">Manage WIFI</a>
-    <a href="/debug" class="button">Wireless Debug</a>
-    <a href="/update" class="button">Update Firmware</a>
-    <a href="/erase" class="button">Erase Settings</a>
-    <a href="/restart" class="button">Restart Device</a>
-    <div class="separator"></div> 
-    <div class="note">
-      <h5>Note</h5>
-      If the update function isn't working, open the portal in your browser: <a href="http://%CUSTOM_DOMAIN%">%CUSTOM_DOMAIN%</a>
-    </div>
-  </div>
-</body>
-</html>
-)rawliteral";
-
-static const char device_info_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE HTML><html>
-<head>
-  <title>Device Info</title>
-  <meta name="viewport" content="width=device-width, initial-scale=1">
-  <style>
-    body {
-      display: flex;
-      justify-content: center; 
-      align-items: center;
-      text-align: center; 
-      font-family: "Arial"; 
-      background-color: #e0f7fa; 
-      color: #006064; 
-      margin: 0; 
-      padding: 0; 
-    }
-    .container {
-    width: 400px; 
-      height: auto;
-      display: flex; 
-      flex-direction: column;
-      align-items: center;
-      margin-top: 50px; 
-      background: #ffffff; 
-      padding: 20px; 
-      border-radius: 10px; 
-      box-shadow: 0 0 10px rgba(0, 0, 0, 0.1); 
-    }
-    .button { 
-      padding: 10px 20px; 
-      font-size: 18px; 
-      margin: 10px; 
-      cursor: pointer; 
-      border: none; 
-      border-radius: 5px; 
-      background-color: #00838f; 
-      color: #ffffff; 
-      text-decoration: none; 
-      display: inline-block;
-      width: 140px; 
-      height: 20px;
-      text-align: center;
-      line-height: 20px;
-    }
-    table {
-      width: 100%;
-      table-layout: fixed;
-      border-collapse: collapse;
-      border-collapse: collapse;
-      margin: 20px 0;
-    }
-    th, td {
-      padding: 10px;
-      border: 1px solid #ddd;
-      word-wrap: break-word;
-      word-break: break-word;
-      white-space: normal;
-      text-align: left;
-    }
-    th {
-      background-color: #f2f2f2;
-      text-align: center;
-    }
-    tr {
-      height: 50px; 
-    }
-  </style>
-</head>
-<body>
-  <div class="container">
-    <h1>Device Info</h1>
-    <table>
-      <tr><th>Property</th><th>Value</th></tr>
-      %DEVICE_INFO%
-    </table>
-    <a href="/" class="button">Back</a>
-  </div>
-</body>
-</html>
-)rawliteral";
-
-static const char wifi_manage_html[] PROGMEM  = R"rawliteral(
-<!DOCTYPE HTML>
-<html lang="en">
-<head>
-  <meta charset="UTF-8">
-  <meta name="viewport" content="width=device-width, initial-scale=1.0">
-  <title>WiFi Management</title>
-  <style>
-    body {
-      display: flex;
-      justify-content: center;
-      align-items: center;
-      text-align: center;
-      font-family: "Arial";
-      background-color: #e0f7fa;
-      color: #006064;
-      margin: 0;
-      padding: 0;
-    }
-    .container {
-      width: 400px;
-      height: auto;
-      display: flex;
-      flex-direction: column;
-      align-items: center;
-      margin-top: 50px;
-      background: #ffffff;
-      padding: 20px;
-      border-radius: 10px;
-      box-shadow: 0 0 10px rgba(0, 0, 0, 0.1);
-    }
-    .button {
-      padding: 10px 20px;
-      font-size: 18px;
-      margin: 10px;
-      cursor: pointer;
-      border: none;
-      border-radius: 5px;
-      background-color: #00838f;
-      color: #ffffff;
-      text-decoration: none;
-      display: inline-block;
-      width: 140px;
-      text-align: center;
-    }
-    h1 {
-      font-size: 24px;
-      margin-bottom: 20px;
-    }
-    .form-group {
-      width: 100%;
-      margin-bottom: 15px;
-    }
-    label {
-      display: block;
-      margin-bottom: 5px;
-      font-size: 16px;
-      color: #004d40;
-    }
-    input[type="text"], input[type="password"], button {
-      width: 100%;
-      padding: 10px;
-      margin-bottom: 10px;
-      border: 1px solid #ddd;
-      border-radius: 4px;
-      box-sizing: border-box;
-    }
-    .wifi-list {
-      margin-top: 20px;
-      width: 100%;
-      padding: 10px;
-      background-color: white;
-      border-radius: 8px;
-      box-shadow: 0 2px 4px rgba(0, 0, 0, 0.1);
-      max-height: 250px;
-      overflow-y: auto;
-      margin-bottom: 30px;
-    }
-    .wifi-item {
-      padding: 10px;
-      border-bottom: 1px solid #ddd;
-      cursor: pointer;
-    }
-    .wifi-item:last-child {
-      border-bottom: none;
-    }
-    .wifi-item:hover {
-      background-color: #f0f0f0;
-    }
-    .note {
-      margin-top: 10px;
-      font-size: 14px;
-      color: #004d40;
-    }
-    .note h5 {
-      margin-bottom: 5px;
-    }
-    .separator {
-      width: 100%;
-      height: 1px;
-      background-color: #004d40;
-      margin: 20px 0px;
-    }
-    .button-container {
-      display: flex;
-      justify-content: center;
-      gap: 20px;
-      width: 100%;
-    }
-  </style>
-</head>
-<body>
-  <div class="container">
-    <h1>WiFi Management</h1>
-    <div class="wifi-list" id="wifiList">
-        <p>Scanning for networks...</p>
-    </div>
-
-    <div class="form-group">
-      <label for="ssid">SSID</label>
-      <input type="text" id="ssid" placeholder="SSID" readonly>
-    </div>
-    <div class="form-group">
-      <label for="password">Password</label>
-      <input type="password" id="password" placeholder="Password">
-    </div>
-    <div class="button-container">
-      <button class="button" onclick="saveWifi()">Save</button>
-      <button class="button" onclick="window.location.href='/'">Back</button>     
-    </div>
-    <div class="separator"></div>
-    <div class="note">
-        <h5>Note</h5>
-        If the device is not connecting, ensure the credentials are correct.
-    </div>
-  </div>
-
-  <script>
-    let socket;
-    let isConnected = false;
-    let reconnectAttempts = 0;
-    const maxReconnectAttempts = 5;
-
-    const wifiListContainer = document.getElementById("wifiList");
-    const ssidInput = document.getElementById("ssid");
-    const passwordInput = document.getElementById("password");
-
-    function connectWebSocket() {
-      console.log('Attempting to connect WebSocket...');
-      socket = new WebSocket(`ws://${window.location.hostname}/ws`);
-
-      socket.onopen = function(event) {
-        console.log("WebSocket connection established.");
-        isConnected = true;
-        reconnectAttempts = 0;
-        
-        // Request fresh scan results when WebSocket connects
-        setTimeout(() => {
-            fetch('/wifimanage', {method: 'GET'}).then(() => {
-                console.log('Requested fresh WiFi scan');
-            });
-        }, 500);
-      };
-
-      socket.onmessage = function(event) {
-        console.log('WebSocket received:', event.data);
-        
-        try {
-          // Check if it's a JSON array (WiFi networks)
-          if (event.data.startsWith('[') && event.data.endsWith(']')) {
-            const networks = JSON.parse(event.data);
-            console.log('Parsed networks:', networks);
-            updateNetworkList(networks);
-          } else {
-            console.log('Non-network message:', event.data);
-          }
-        } catch (e) {
-          console.error('Failed to parse JSON:', e);
-          console.error('Raw data:', event.data);
-        }
-      };
-
-      socket.onclose = function(event) {
-        console.log('WebSocket closed:', event.code, event.reason);
-        isConnected = false;
-        
-        // Attempt to reconnect if not too many attempts
-        if (reconnectAttempts < maxReconnectAttempts) {
-          reconnectAttempts++;
-          console.log(`Reconnecting... Attempt ${reconnectAttempts}`);
-          setTimeout(connectWebSocket, 2000);
-        } else {
-          wifiListContainer.innerHTML = "<p>Connection lost. Please refresh the page.</p>";
-        }
-      };
-
-      socket.onerror = function(error) {
-        console.error('WebSocket Error:', error);
-        isConnected = false;
-      };
-    }
-
-    function updateNetworkList(networks) {
-      console.log('Updating network list with', networks.length, 'networks');
-      wifiListContainer.innerHTML = "";
-      
-      if (networks.length > 0) {
-        networks.forEach(network => {
-          addWifiNetwork(network);
-        });
-      } else {
-        wifiListContainer.innerHTML = "<p>No networks found. <button onclick='requestScan()'>Scan Again</button></p>";
-      }
-    }
-
-    function addWifiNetwork(network) {
-      const wifiItem = document.createElement("div");
-      wifiItem.classList.add("wifi-item");
-      
-      // Create a more informative display
-      const securityIcon = network.encryption === "Open" ? "🔓" : "🔒";
-      const signalStrength = getSignalStrength(network.rssi);
-      
-      wifiItem.innerHTML = `
-        <strong>${network.ssid}</strong> ${securityIcon}<br>
-        <small>Signal: ${signalStrength} (${network.rssi} dBm) | Channel: ${network.channel} | ${network.encryption}</small>
-      `;
-        
-      wifiItem.onclick = () => {
-        ssidInput.value = network.ssid;
-        // Clear previous selections
-        document.querySelectorAll('.wifi-item').forEach(item => {
-          item.style.backgroundColor = '';
-        });
-        // Highlight selected
-        wifiItem.style.backgroundColor = '#e3f2fd';
-      };
-      
-      wifiListContainer.appendChild(wifiItem);
-    }
-
-    function getSignalStrength(rssi) {
-      if (rssi >= -50) return "Excellent";
-      if (rssi >= -60) return "Good";
-      if (rssi >= -70) return "Fair";
-      return "Poor";
-    }
-
-    function requestScan() {
-      wifiListContainer.innerHTML = "<p>Scanning for networks...</p>";
-      fetch('/wifimanage', {method: 'GET'}).then(() => {
-        console.log('Scan requested');
-      }).catch(err => {
-        console.error('Scan request failed:', err);
-        wifiListContainer.innerHTML = "<p>Scan failed. Please try again.</p>";
-      });
-    }
-
-    function saveWifi() {
-      const ssid = ssidInput.value;
-      const password = passwordInput.value;
-
-      if (!ssid) {
-        alert("Please select a network.");
-        return;
-      }
-      if (password.length < 8) {
-        alert("Password must be at least 8 characters.");
-        return;
-      }
-
-      const formData = new FormData();
-      formData.append("ssid", ssid);
-      formData.append("password", password);
-
-      fetch('/save-wifi', {
-        method: 'POST',
-        body: formData
-      })
-      .then(response => {
-        if (response.ok) {
-          alert("WiFi settings saved. Restarting device...");
-          window.location.href = '/';
-        } else {
-          alert("Failed to save WiFi settings.");
-        }
-      })
-      .catch(error => {
-        console.error('Error:', error);
-        alert('Error saving WiFi settings.');
-      });
-    }
-
-    // Initialize WebSocket connection when page loads
-    document.addEventListener('DOMContentLoaded', function() {
-      console.log('Page loaded, connecting WebSocket...');
-      connectWebSocket();
-    });
-  </script>
-</body>
-</html>
-)rawliteral";
-
-static const char update_firmware_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE HTML>
-<html>
-<head>
-  <title>Firmware Update</title>
-  <meta name="viewport" content="width=device-width, initial-scale=1">
-  <style>
-    body {
-      display: flex;
-      justify-content: center; 
-      align-items: center;
-      text-align: center; 
-      font-family: "Arial"; 
-      background-color: #e0f7fa; 
-      color: #006064; 
-      margin: 0; 
-      padding: 0; 
-    }
-    .container {
-      width: 400px; 
-      height: auto; 
-      display: flex; 
-      flex-direction: column;
-      align-items: center;
-      margin-top: 50px; 
-      background: #ffffff; 
-      padding: 20px; 
-      border-radius: 10px; 
-      box-shadow: 0 0 10px rgba(0, 0, 0, 0.1); 
-    }
-    .button { 
-      padding: 10px 20px; 
-      font-size: 18px; 
-      margin: 10px; 
-      cursor: pointer; 
-      border: none; 
-      border-radius: 5px; 
-      background-color: #00838f; 
-      color: #ffffff; 
-      text-decoration: none; 
-      display: inline-block; 
-    }
-    input[type="submit"] {
-      padding: 10px 20px; 
-      font-size: 18px; 
-      margin: 20px; 
-      cursor: pointer; 
-      border: none; 
-      border-radius: 5px; 
-      background-color: #00838f; 
-      color: #ffffff; 
-      text-decoration: none; 
-      display: inline-block;
-      width: 180px; 
-      height: 40px; 
-      text-align: center;
-      line-height: 20px; 
-    }
-
-    input[type="file"] { 
-      padding: 10px; 
-      border: 2px dashed #00838f; 
-      border-radius: 5px; 
-      width: 200px; 
-      cursor: pointer; 
-    }
-    #progressContainer {
-      width: 100%;
-      margin-top: 20px;
-      display: none; /* Hidden initially */
-      border: 2px solid #00838f; /* Add border to make it more visible */
-      border-radius: 5px;
-      position: relative;
-    }
-    #progressBar {
-      width: 0%;
-      height: 20px;
-      background-color: #00838f;
-      border-radius: 5px;
-      transition: width 0.4s ease;
-      position: relative;
-    }
-    #progressText {
-      position: absolute;
-      width: 100%;
-      text-align: center;
-      top: 0;
-      left: 0;
-      color: #ffffff;
-      font-weight: bold;
-      line-height: 20px; /* Align text vertically */
-    }
-  </style>
-</head>
-<body>
-  <div class="container">
-    <h1>Firmware Update</h1>
-    <form id="updateForm" enctype="multipart/form-data">
-      <input type="file" id="firmwareFile" name="firmware" accept=".bin" required>
-      <input type="button" value="Update Firmware" class="button" id="updateButton" onclick="submitUpdate()">
-    </form>
-    <div id="progressContainer">
-      <div id="progressBar">
-        <div id="progressText">0%</div> <!-- Percentage text inside the progress bar -->
-      </div>
-    </div>
-    <a href="/" class="button">Back</a>
-    
-    <script>
-      function submitUpdate() {
-        var firmwareFile = document.getElementById('firmwareFile');
-        var updateButton = document.getElementById('updateButton');
-        var progressContainer = document.getElementById('progressContainer');
-        var progressBar = document.getElementById('progressBar');
-        var progressText = document.getElementById('progressText');
-        
-        // Check if a file is selected
-        if (!firmwareFile.files.length) {
-          alert('Please select a firmware file.');
-          return;
-        }
-
-        // Check if the selected file is a .bin file
-        var fileName = firmwareFile.files[0].name;
-        if (!fileName.endsWith('.bin')) {
-          alert('Invalid file selected. Please select a .bin file.');
-          return;
-        }
-    
-        var formData = new FormData(document.getElementById('updateForm'));
-    
-        // Hide the update button and show the progress bar
-        updateButton.style.display = 'none';
-        progressContainer.style.display = 'block';
-
-        // Create XMLHttpRequest object to handle the file upload
-        var xhr = new XMLHttpRequest();
-
-        // Track the upload progress
-        xhr.upload.onprogress = function(event) {
-          if (event.lengthComputable) {
-            var percentComplete = Math.round((event.loaded / event.total) * 100);
-            progressBar.style.width = percentComplete + '%';
-            progressText.textContent = percentComplete + '%'; // Update the percentage text
-          }
-        };
-
-        // Handle the response from the server
-        xhr.onload = function() {
-          if (xhr.status === 200) {
-            progressText.textContent = '100%'; // Ensure the text shows 100% on completion
-            alert('Firmware update successful! The device will now restart.');
-            setTimeout(() => {
-              location.reload();
-            }, 1000);
-          } else {
-            alert('Firmware update failed!');
-            resetUI();
-          }
-        };
-
-        // Handle errors
-        xhr.onerror = function() {
-          alert('Firmware update encountered an error!');
-          resetUI();
-        };
-
-        // Send the form data
-        xhr.open('POST', '/update', true);
-        xhr.send(formData);
-
-        function resetUI() {
-          updateButton.style.display = 'block';
-          progressContainer.style.display = 'none';
-          progressBar.style.width = '0%';
-          progressText.textContent = '0%'; // Reset percentage text
-        }
-      }
-    </script>
-  </div>
-</body>
-</html>
-)rawliteral";
-
-static const char erase_settings_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE HTML><html>
-<head>
-  <title>Erase Settings</title>
-  <meta name="viewport" content="width=device-width, initial-scale=1">
-  <style>
-    body {
-      display: flex;
-      justify-content: center; 
-      align-items: center;
-      text-align: center; 
-      font-family: "Arial"; 
-      background-color: #e0f7fa; 
-      color: #006064; 
-      margin: 0; 
-      padding: 0; 
-    }
-    .container {
-      width: 400px; 
-      height: auto; 
-      display: flex; 
-      flex-direction: column;
-      align-items: center;
-      margin-top: 50px; 
-      background: #ffffff; 
-      padding: 20px; 
-      border-radius: 10px; 
-      box-shadow: 0 0 10px rgba(0, 0, 0, 0.1); 
-    }
-    input[type="submit"] {
-      padding: 10px 20px; 
-      font-size: 18px; 
-      margin: 20px; 
-      cursor: pointer; 
-      border: none; 
-      border-radius: 5px; 
-      background-color: #d32f2f; 
-      color: #ffffff; 
-      text-decoration: none; 
-      display: inline-block;
-      width: 180px; 
-      height: 40px; 
-      text-align: center;
-      line-height: 20px; 
-    }
-    .button { 
-      padding: 10px 20px; 
-      font-size: 18px; 
-      margin: 10px; 
-      cursor: pointer; 
-      border: none; 
-      border-radius: 5px; 
-      background-color: #00838f; 
-      color: #ffffff; 
-      text-decoration: none; 
-      display: inline-block; 
-    }
-  </style>
-</head>
-<body>
-  <div class="container">
-    <h1>Erase Settings</h1>
-    <form method="POST" action="/erase">
-      <input type="submit" value="Erase Settings" class="button">
-    </form>
-    <a href="/" class="button">Back</a>
-  </div>
-</body>
-</html>
-)rawliteral";
-
-static const char restart_device_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE HTML><html>
-<head>
-  <title>Restart Device</title>
-  <meta name="viewport" content="width=device-width, initial-scale=1">
-  <style>
-    body {
-      display: flex;
-      justify-content: center; 
-      align-items: center;
-      text-align: center; 
-      font-family: "Arial"; 
-      background-color: #e0f7fa; 
-      color: #006064; 
-      margin: 0; 
-      padding: 0; 
-    }
-    .container {
-      width: 400px; 
-      height: auto; 
-      display: flex; 
-      flex-direction: column;
-      align-items: center;
-      margin-top: 50px; 
-      background: #ffffff; 
-      padding: 20px; 
-      border-radius: 10px; 
-      box-shadow: 0 0 10px rgba(0, 0, 0, 0.1); 
-    }
-    input[type="submit"] {
-      padding: 10px 20px; 
-      font-size: 18px; 
-      margin: 20px; 
-      cursor: pointer; 
-      border: none; 
-      border-radius: 5px; 
-      background-color: #f09c3d; 
-      color: #ffffff; 
-      text-decoration: none; 
-      display: inline-block;
-      width: 180px; 
-      height: 40px; 
-      text-align: center;
-      line-height: 20px; 
-    }
-    .button { 
-      padding: 10px 20px; 
-      font-size: 18px; 
-      margin: 10px; 
-      cursor: pointer; 
-      border: none; 
-      border-radius: 5px; 
-      background-color: #00838f; 
-      color: #ffffff; 
-      text-decoration: none; 
-      display: inline-block; 
-    }
-  </style>
-</head>
-<body>
-  <div class="container">
-    <h1>Restart Device</h1>
-    <form id="restartForm">
-      <input type="button" value="Restart Device" class="button" onclick="submitRestart()">
-    </form>
-    <a href="/" class="button">Back</a>
-    
-    <script>
-      function submitRestart() {
-        fetch('/restart', {
-          method: 'POST'
-        })
-        .then(response => {
-          if (response.ok) {
-            alert('Device is restarting...');
-            setTimeout(() => {
-              location.reload();
-            }, 1000);
-          } else {
-            alert('Device restart failed!');
-          }
-        })
-        .catch(error => {
-          console.error('Error:', error);
-          alert('Device restart encountered an error!');
-        });
-      }
-    </script>
-  </div>
-</body>
-</html>
-)rawliteral";
-
-const char debug_html[] PROGMEM = R"rawliteral(
-<!DOCTYPE HTML>
-<html lang="en">
-<head>
-  <meta charset="UTF-8">
-  <title>Wireless Debug</title>
-  <meta name="viewport" content="width=device-width, initial-scale=1">
-  <style>
-    body {
-      display: flex;
-      justify-content: center; 
-      align-items: center;
-      text-align: center; 
-      font-family: "Arial"; 
-      background-color: #e0f7fa; 
-      color: #006064; 
-      margin: 0; 
-      padding: 0; 
-    }
-    .container {
-      width: 400px; 
-      height: auto; 
-      display: flex; 
-      flex-direction: column;
-      align-items: center;
-      margin-top: 50px; 
-      background: #ffffff; 
-      padding: 20px; 
-      border-radius: 10px; 
-      box-shadow: 0 0 10px rgba(0, 0, 0, 0.1); 
-    }
-    .log-screen {
-      border: 1px solid #ccc;
-      background-color: #fff;
-      width: 300px;
-      height: 500px;
-      overflow-y: scroll;
-      padding: 10px;
-      text-align: left; 
-    }
-    .button { 
-      padding: 10px 20px; 
-      font-size: 18px; 
-      margin: 10px; 
-      cursor: pointer; 
-      border: none; 
-      border-radius: 5px; 
-      background-color: #00838f; 
-      color: #ffffff; 
-      text-decoration: none; 
-      display: inline-block; 
-    }
-  </style>
-</head>
-<body>
-  <div class="container">
-    <h1>%PORTAL_HEADING% Debug Logs</h1>
-    <div class="log-screen" id="logs">
-    </div>
-    <a href="/" class="button">Back</a>
-  </div>
-  <script>
-    var ws = new WebSocket(`ws://${window.location.hostname}/ws`);
-    ws.onmessage = function(event) {
-      var logsDiv = document.getElementById('logs');
-      logsDiv.innerHTML += event.data + "<br/>";
-      logsDiv.scrollTop = logsDiv.scrollHeight; // Auto-scroll to the bottom
-    };
-  </script>
-</body>
-</html>
-)rawliteral";
-
-
-#endif // WEBPAGES_H
\ No newline at end of file
+struct OTADashAsset {
+    const char*     type;
+    const uint8_t*  data;                                                                                   // gzip, in flash
+    size_t          length;
+    const char*     etag;
+    const char*     cacheControl;
+};
+
+enum OTADashField : uint8_t {
+    OTA_DASH_FIELD_CUSTOM_DOMAIN,
+    OTA_DASH_FIELD_PORTAL_HEADING,
+    OTA_DASH_FIELD_COUNT
+};
+
+struct OTADashSlot {
+    uint16_t            offset;                                                                             // Into the text, placeholders cut out
+    uint8_t             field;
+};
+
+struct OTADashTemplate {
+    const char*         text;                                                                               // In flash
+    size_t              length;
+    const OTADashSlot*  slots;                                                                              // In flash, ascending offsets
+    uint8_t             slotCount;
+};
+
+#define OTA_DASH_PORTAL_CSS                 "/portal.css"
+
+// Style rules shared by the pages
+static const uint8_t portal_css_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x75, 0x91, 0xf1, 0x6e, 0x83, 0x20, 0x10, 0xc6, 0x5f, 0xc5,
+    0x74, 0x59, 0xb2, 0x25, 0xc3, 0xe0, 0x66, 0xbb, 0x06, 0xff, 0xda, 0xa3, 0xa0, 0x80, 0xde, 0x8a, 0x9c, 0x41, 0x4c, 0x75,
+    0xc6, 0x77, 0x1f, 0x62, 0xe9, 0xd6, 0x66, 0x93, 0x48, 0xc2, 0xc1, 0x7d, 0xf7, 0xbb, 0xef, 0x4a, 0x14, 0xd3, 0x2c, 0xa0,
+    0xef, 0x34, 0x9f, 0x98, 0xd2, 0x72, 0x2c, 0x3e, 0x87, 0xde, 0x81, 0x9a, 0x48, 0x85, 0xc6, 0x49, 0xe3, 0x58, 0xe5, 0x37,
+    0x69, 0x0b, 0xae, 0xa1, 0x36, 0x04, 0x9c, 0x6c, 0xfb, 0x18, 0x72, 0x72, 0x74, 0x24, 0xc4, 0x63, 0x44, 0xf9, 0x1c, 0xa2,
+    0x78, 0x0b, 0x7a, 0x62, 0xbb, 0x0f, 0x0b, 0x5c, 0xef, 0x8a, 0x92, 0x57, 0xa7, 0xda, 0xe2, 0x60, 0x84, 0x97, 0xd4, 0x68,
+    0xd9, 0x83, 0xa4, 0xea, 0x5d, 0xf1, 0xe2, 0x72, 0xa2, 0xf4, 0x40, 0x0f, 0x79, 0xd1, 0x72, 0x5b, 0x83, 0x61, 0xb4, 0xe8,
+    0xb8, 0x10, 0x60, 0x6a, 0x46, 0x97, 0x74, 0x45, 0xe0, 0x60, 0xa4, 0x9d, 0xcf, 0x20, 0x5c, 0xc3, 0x72, 0x4a, 0xbb, 0xb1,
+    0x68, 0x24, 0xd4, 0x8d, 0x63, 0x7c, 0x70, 0x58, 0xdc, 0x90, 0xaf, 0x1b, 0x11, 0x60, 0x65, 0xe5, 0x00, 0x3d, 0x13, 0xea,
+    0xa1, 0x35, 0x7f, 0x81, 0x6f, 0xb5, 0x88, 0xc3, 0x8e, 0xed, 0x57, 0xc5, 0x1f, 0x44, 0xf6, 0xa0, 0xc2, 0x77, 0xa5, 0x78,
+    0x0d, 0xf7, 0x68, 0x85, 0xb4, 0xc4, 0x72, 0x01, 0x43, 0xcf, 0xb2, 0x2d, 0x34, 0x92, 0xbe, 0xe1, 0x02, 0xcf, 0x8c, 0x26,
+    0x34, 0x59, 0x63, 0x89, 0xad, 0x4b, 0xfe, 0x44, 0x5f, 0xc2, 0x4a, 0xb3, 0xe7, 0x25, 0x2d, 0x07, 0xe7, 0xd0, 0xcc, 0x51,
+    0x2b, 0x3c, 0x0a, 0x82, 0xc1, 0xa7, 0x1e, 0xbe, 0x24, 0xcb, 0x8e, 0xfe, 0x78, 0xe9, 0x3d, 0x08, 0x57, 0x83, 0xed, 0xbd,
+    0x2d, 0x1d, 0x42, 0x40, 0xdd, 0x4a, 0x33, 0x83, 0x46, 0xde, 0x61, 0xec, 0x6f, 0xc0, 0xc9, 0xd5, 0xcd, 0xe3, 0xdb, 0x51,
+    0x45, 0x6f, 0x2f, 0xcd, 0x84, 0x41, 0x09, 0x59, 0xa1, 0xe5, 0xc1, 0x99, 0xa0, 0x16, 0xad, 0x03, 0xa3, 0xbd, 0xc5, 0xa4,
+    0xd4, 0x58, 0x9d, 0x96, 0xd4, 0xa0, 0x93, 0xf3, 0x2f, 0x7f, 0xb2, 0x3b, 0xdc, 0x7c, 0x45, 0x8c, 0xa5, 0x72, 0x91, 0xd3,
+    0x2d, 0x25, 0x69, 0xf6, 0x31, 0xab, 0x44, 0xdf, 0x74, 0xbb, 0xe2, 0x2d, 0x69, 0x2f, 0x3b, 0xee, 0x6b, 0x62, 0x1c, 0x60,
+    0x46, 0xe9, 0x63, 0x9c, 0x5f, 0xf6, 0x0f, 0xff, 0x2a, 0x1a, 0x1d, 0x59, 0xcd, 0x4a, 0xfc, 0xbf, 0x7c, 0x03, 0xaa, 0xd2,
+    0x48, 0x44, 0xa7, 0x02, 0x00, 0x00,
+};
+static const OTADashAsset portal_css = { "text/css", portal_css_gz, sizeof(portal_css_gz), "\"924024cd1ab06668\"", "public, max-age=31536000, immutable" };
+
+// debug.html, template
+static const char debug_html_text[] PROGMEM = R"rawliteral(<!DOCTYPE HTML><html lang="en"><head><meta charset="UTF-8"><title>Wireless Debug</title><meta name="viewport" content="width=device-width, initial-scale=1"><link rel="stylesheet" href="/portal.css?v=924024cd1ab06668"><style>.log-screen{border:1px solid #ccc;background-color:#fff;width:300px;height:500px;overflow-y:scroll;padding:10px;text-align:left;font-family:monospace;white-space:pre-wrap;word-break:break-word}</style></head><body><div class="container"><h1> Debug Logs</h1><div class="log-screen" id="logs"></div><a href="/" class="button">Back</a></div><script>var logsDiv = document.getElementById('logs');
+var next = null;
+var pending = [];
+function addLine(text, note) {
+var line = document.createElement('div');
+line.textContent = text;
+if (note) line.style.color = '#999';
+logsDiv.appendChild(line);
+}
+function show(batch) {
+var stick = logsDiv.scrollTop + logsDiv.clientHeight >= logsDiv.scrollHeight - 5;
+if (next === null) next = batch.seq;
+if (batch.seq > next) addLine('... ' + (batch.seq - next) + ' lines dropped', true);
+batch.logs.slice(Math.max(0, next - batch.seq)).forEach(function(text) { addLine(text); });
+next = Math.max(next, batch.seq + batch.logs.length);
+while (logsDiv.childNodes.length > 1000) logsDiv.removeChild(logsDiv.firstChild);
+if (stick) logsDiv.scrollTop = logsDiv.scrollHeight; // Auto-scroll unless the user scrolled up
+}
+var ws = new WebSocket(`ws://${window.location.hostname}/ws`);
+ws.onopen = function() {
+ws.send('logs'); // Subscribe before reading the backlog, seq removes the overlap
+fetch('/api/logs').then(function(r) { return r.json(); }).then(function(backlog) {
+show(backlog);
+pending.forEach(show);
+pending = null;
+}).catch(function() { pending.forEach(show); pending = null; });
+};
+ws.onmessage = function(event) {
+var batch;
+try { batch = JSON.parse(event.data); } catch (e) { return; }
+if (!batch || !Array.isArray(batch.logs)) return; // Scan results and pairing replies share the socket
+if (pending) pending.push(batch); else show(batch);
+};</script></body></html>)rawliteral";
+static const OTADashSlot debug_html_slots[] PROGMEM = { { 465, OTA_DASH_FIELD_PORTAL_HEADING } };
+static const OTADashTemplate debug_html = { debug_html_text, sizeof(debug_html_text) - 1, debug_html_slots, 1 };
+
+// erase.html
+static const uint8_t erase_html_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x65, 0x52, 0x41, 0x6e, 0xdb, 0x30, 0x10, 0xfc, 0x0a, 0xcb,
+    0x5e, 0xab, 0xca, 0x76, 0x5d, 0x23, 0x91, 0x29, 0x15, 0x68, 0x1b, 0xa0, 0x87, 0x16, 0x09, 0x10, 0x5f, 0x82, 0xa2, 0x87,
+    0x15, 0xb9, 0xb2, 0x16, 0xa6, 0x48, 0x81, 0xa4, 0x94, 0xb8, 0x45, 0xff, 0x9e, 0x95, 0xe4, 0x1c, 0x82, 0xe8, 0xb0, 0xe0,
+    0x92, 0x3b, 0xc3, 0xe1, 0x8c, 0xd4, 0xbb, 0xef, 0xb7, 0xdf, 0x0e, 0x0f, 0x77, 0x37, 0xe2, 0xc7, 0xe1, 0xd7, 0xcf, 0x4a,
+    0xb5, 0xa9, 0xb3, 0x5c, 0x11, 0x4c, 0xa5, 0x12, 0x25, 0x8b, 0xd5, 0x4d, 0x80, 0x88, 0xe2, 0x1e, 0x53, 0x22, 0x77, 0x8c,
+    0x2a, 0x5f, 0x76, 0x55, 0x87, 0x09, 0x84, 0x83, 0x0e, 0x4b, 0x39, 0x12, 0x3e, 0xf6, 0x3e, 0x24, 0x29, 0xb4, 0x77, 0x09,
+    0x5d, 0x2a, 0xe5, 0x23, 0x99, 0xd4, 0x96, 0x06, 0x47, 0xd2, 0x98, 0xcd, 0xcd, 0x07, 0x41, 0x8e, 0x12, 0x81, 0xcd, 0xa2,
+    0x06, 0x8b, 0xe5, 0x5a, 0x56, 0xca, 0x92, 0x3b, 0x89, 0x80, 0xb6, 0x94, 0x31, 0x9d, 0x2d, 0xc6, 0x16, 0x91, 0x49, 0xda,
+    0x80, 0x4d, 0x29, 0xf3, 0x89, 0x11, 0xec, 0x47, 0x1d, 0xe3, 0x97, 0xb1, 0xbc, 0xde, 0x6c, 0x57, 0x9b, 0xad, 0x36, 0x6b,
+    0xa8, 0x57, 0xbb, 0xdd, 0xee, 0x8a, 0xc1, 0x33, 0xa4, 0x22, 0xd7, 0x0f, 0xe9, 0x77, 0x3a, 0xf7, 0xac, 0x23, 0x0e, 0x75,
+    0x47, 0x49, 0xfe, 0xf9, 0xd7, 0x83, 0x31, 0x2c, 0xb6, 0x58, 0xaf, 0xfa, 0x27, 0xb1, 0xe1, 0xb2, 0x6f, 0x58, 0x58, 0x16,
+    0xe9, 0x2f, 0x16, 0xeb, 0x2b, 0x6e, 0x3b, 0x08, 0x47, 0x72, 0xc5, 0x7c, 0xa4, 0x87, 0x10, 0x7d, 0x28, 0x7a, 0x4f, 0xac,
+    0x3d, 0xec, 0x6b, 0x1f, 0x0c, 0x86, 0xc2, 0x79, 0x87, 0x97, 0x75, 0x16, 0xc0, 0xd0, 0x10, 0x8b, 0xcf, 0x3c, 0x5c, 0x83,
+    0x3e, 0x1d, 0x83, 0x1f, 0x9c, 0xc9, 0xb4, 0xb7, 0x0c, 0x7b, 0x6f, 0x3e, 0x6d, 0x9a, 0x4d, 0xb3, 0xbf, 0x74, 0xcd, 0xfc,
+    0xed, 0x13, 0x3e, 0xa5, 0xcc, 0xa0, 0xf6, 0x01, 0x12, 0x79, 0xb7, 0xb0, 0x19, 0x8a, 0xbd, 0x85, 0x73, 0x41, 0x8e, 0xdf,
+    0x8d, 0x59, 0x6d, 0xbd, 0x3e, 0xed, 0x67, 0x6f, 0x58, 0xd4, 0xa4, 0xa4, 0x45, 0x3a, 0xb6, 0xa9, 0xd8, 0x4e, 0xeb, 0x99,
+    0x01, 0x2c, 0x1d, 0x5d, 0xa1, 0x71, 0x16, 0x36, 0x83, 0x2e, 0x23, 0x93, 0xf0, 0xff, 0x2a, 0x5f, 0x2c, 0x50, 0xf9, 0x12,
+    0x57, 0xed, 0xcd, 0xb9, 0x52, 0x86, 0x46, 0xa1, 0x2d, 0xc4, 0x58, 0xca, 0x29, 0x0d, 0x60, 0x54, 0x60, 0xb7, 0xda, 0xf5,
+    0x9b, 0x20, 0x79, 0x4b, 0x35, 0x3e, 0x74, 0x82, 0xa3, 0x6c, 0xbd, 0x29, 0xe5, 0xdd, 0xed, 0xfd, 0x41, 0x0a, 0xd0, 0x93,
+    0x64, 0x0e, 0x00, 0xa7, 0x79, 0x86, 0xce, 0x16, 0x8b, 0x57, 0x16, 0x8b, 0x11, 0xec, 0xc0, 0xed, 0x6b, 0x4a, 0xf9, 0x72,
+    0x71, 0x3d, 0xa4, 0xe4, 0x1d, 0x43, 0xf3, 0x89, 0xbf, 0x52, 0xf0, 0x92, 0xe9, 0x9b, 0x89, 0xaf, 0xec, 0xa7, 0xca, 0x81,
+    0x27, 0x59, 0x37, 0xd7, 0xe5, 0x0d, 0xf9, 0xfc, 0x17, 0x3e, 0x03, 0x75, 0x1f, 0xe5, 0x37, 0x9b, 0x02, 0x00, 0x00,
+};
+static const OTADashAsset erase_html = { "text/html", erase_html_gz, sizeof(erase_html_gz), "\"8638912d5d8e2d52\"", "no-cache" };
+
+// index.html, template
+static const char index_html_text[] PROGMEM = R"rawliteral(<!DOCTYPE HTML><html><head><title>Device Control Portal</title><meta name="viewport" content="width=device-width, initial-scale=1"><link rel="stylesheet" href="/portal.css?v=924024cd1ab06668"><style>.button{padding:10px 20px;font-size:18px;margin:10px;cursor:pointer;border:none;border-radius:5px;background-color:#00838f;color:#ffffff;text-decoration:none;display:inline-block;width:160px;height:20px;text-align:center;line-height:20px}</style></head><body><div class="container"><h1></h1><a href="/info" class="button">Device Info</a> <a href="/wifimanage" class="button">Manage WIFI</a> <a href="/debug" class="button">Wireless Debug</a> <a href="/update" class="button">Update Firmware</a> <a href="/erase" class="button">Erase Settings</a> <a href="/restart" class="button">Restart Device</a><div class="separator"></div><div class="note"><h5>Note</h5>If the update function isn't working, open the portal in your browser: <a href="http://"></a></div></div></body></html>)rawliteral";
+static const OTADashSlot index_html_slots[] PROGMEM = { { 485, OTA_DASH_FIELD_PORTAL_HEADING }, { 944, OTA_DASH_FIELD_CUSTOM_DOMAIN }, { 946, OTA_DASH_FIELD_CUSTOM_DOMAIN } };
+static const OTADashTemplate index_html = { index_html_text, sizeof(index_html_text) - 1, index_html_slots, 3 };
+
+// info.html
+static const uint8_t info_html_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x57, 0xff, 0x6e, 0xdb, 0x36, 0x10, 0xfe, 0xdf, 0x4f,
+    0xc1, 0xaa, 0x2d, 0x22, 0xaf, 0xfe, 0x99, 0xb5, 0x45, 0x26, 0xd9, 0x2e, 0x12, 0xb7, 0x41, 0x83, 0x35, 0x5d, 0x50, 0xa7,
+    0x05, 0x86, 0xae, 0x48, 0x68, 0xf1, 0x64, 0xb1, 0xa1, 0x25, 0x8d, 0xa4, 0xe2, 0xa4, 0xae, 0xdf, 0x69, 0xcf, 0xb0, 0x27,
+    0xdb, 0x91, 0xb2, 0x62, 0xc9, 0x96, 0xd7, 0xcd, 0x41, 0x1c, 0xf2, 0xf8, 0xdd, 0xdd, 0xc7, 0xbb, 0x23, 0x79, 0x19, 0x3c,
+    0x7a, 0xfd, 0xdb, 0xf8, 0xf2, 0xf7, 0x8b, 0x37, 0xe4, 0xed, 0xe5, 0xf9, 0xbb, 0xd1, 0x20, 0xd2, 0x73, 0x81, 0xdf, 0x40,
+    0xd9, 0x68, 0xa0, 0xb9, 0x16, 0x30, 0x7a, 0x0d, 0xb7, 0x3c, 0x00, 0x72, 0x16, 0x87, 0xc9, 0xa0, 0x9b, 0x8b, 0x06, 0x73,
+    0xd0, 0x94, 0xc4, 0x74, 0x0e, 0x43, 0xe7, 0x96, 0xc3, 0x22, 0x4d, 0xa4, 0x76, 0x48, 0x90, 0xc4, 0x1a, 0x62, 0x3d, 0x74,
+    0x16, 0x9c, 0xe9, 0x68, 0xc8, 0xac, 0x5e, 0xdb, 0x4e, 0x5a, 0x84, 0xc7, 0x5c, 0x73, 0x2a, 0xda, 0x2a, 0xa0, 0x02, 0x86,
+    0x7d, 0x67, 0x34, 0x10, 0x3c, 0xbe, 0x21, 0x12, 0xc4, 0xd0, 0x51, 0xfa, 0x5e, 0x80, 0x8a, 0x00, 0xd0, 0x48, 0x24, 0x21,
+    0x1c, 0x3a, 0x5d, 0x63, 0x91, 0x8a, 0x4e, 0xa0, 0xd4, 0xab, 0xdb, 0xe1, 0x2f, 0x87, 0xcf, 0x7b, 0x87, 0xcf, 0x03, 0xd6,
+    0xa7, 0xd3, 0xde, 0xcb, 0x97, 0x2f, 0x8f, 0x50, 0xd9, 0xaa, 0x8c, 0x3a, 0xd3, 0x4c, 0xeb, 0x24, 0x5e, 0xa6, 0x94, 0x31,
+    0x1e, 0xcf, 0xbc, 0x7e, 0x2f, 0xbd, 0x23, 0x87, 0xf8, 0xe5, 0x87, 0xc8, 0xa5, 0xad, 0xf8, 0x37, 0xf0, 0xfa, 0x47, 0x38,
+    0x9d, 0x53, 0x39, 0xe3, 0xb1, 0x5d, 0xf7, 0x83, 0x4c, 0xaa, 0x44, 0x7a, 0x69, 0xc2, 0x91, 0xae, 0xf4, 0xa7, 0x89, 0x64,
+    0x20, 0xbd, 0x38, 0x89, 0x61, 0x3d, 0x6e, 0x4b, 0xca, 0x78, 0xa6, 0xbc, 0x17, 0x08, 0x9e, 0xd2, 0xe0, 0x66, 0x26, 0x93,
+    0x2c, 0x66, 0xed, 0x20, 0x11, 0xa8, 0xf6, 0xb8, 0xd7, 0x3b, 0xfa, 0xf9, 0x28, 0xf4, 0xd7, 0xb3, 0xd0, 0x7e, 0x7c, 0x0d,
+    0x77, 0xba, 0xcd, 0x20, 0x48, 0x24, 0xd5, 0x3c, 0x89, 0x73, 0x6b, 0x8c, 0xab, 0x54, 0xd0, 0x7b, 0x8f, 0xc7, 0xb8, 0x55,
+    0x68, 0x4f, 0x45, 0x12, 0xdc, 0xf8, 0x36, 0x1c, 0x5e, 0xff, 0xb9, 0x61, 0x12, 0x01, 0x9f, 0x45, 0xda, 0xb3, 0x84, 0xad,
+    0x05, 0x2a, 0xf8, 0x2c, 0xf6, 0x02, 0xb0, 0xc4, 0xac, 0x52, 0x09, 0xb2, 0xd2, 0x74, 0x2a, 0x60, 0xb9, 0x36, 0xd0, 0xeb,
+    0x3d, 0xf5, 0xad, 0xa0, 0x8d, 0x2e, 0x92, 0x4c, 0x7b, 0x21, 0xbf, 0x03, 0x56, 0xec, 0x00, 0xd9, 0x09, 0x9a, 0x2a, 0xf0,
+    0x8a, 0xc1, 0xfe, 0x85, 0x75, 0x68, 0x8c, 0x07, 0xd2, 0x5b, 0x61, 0xaa, 0x34, 0xab, 0xc4, 0xb3, 0x08, 0x50, 0x1f, 0xd7,
+    0x55, 0x22, 0x38, 0x23, 0x8f, 0x19, 0x63, 0xfe, 0x02, 0xa5, 0xed, 0x85, 0xa4, 0xa9, 0x37, 0x95, 0x40, 0x6f, 0xda, 0x66,
+    0x9e, 0x0b, 0xed, 0xbc, 0x22, 0x8d, 0xb8, 0x86, 0xb6, 0x4a, 0x69, 0x00, 0x18, 0x18, 0x39, 0xa7, 0xa2, 0xbc, 0x5b, 0x01,
+    0xa1, 0x46, 0xb7, 0xcb, 0xdd, 0x48, 0x87, 0x87, 0xe6, 0x67, 0x37, 0x32, 0x2b, 0x2d, 0x97, 0xeb, 0xb8, 0xbc, 0xb0, 0x71,
+    0x61, 0xcb, 0xb2, 0x8b, 0x54, 0x62, 0x4c, 0x30, 0x76, 0xab, 0x41, 0x37, 0xaf, 0x92, 0x41, 0x37, 0x2f, 0xe7, 0x69, 0xc2,
+    0xee, 0x47, 0x03, 0xc6, 0x6f, 0x49, 0x20, 0xa8, 0x52, 0x43, 0xc7, 0x14, 0x2c, 0x45, 0xa4, 0xc4, 0x82, 0x8a, 0xfa, 0xd5,
+    0x42, 0xc7, 0xf9, 0xc0, 0xc6, 0x97, 0x70, 0x36, 0x74, 0x38, 0xca, 0x10, 0xa4, 0x25, 0xfe, 0x46, 0xa3, 0x0b, 0x99, 0xa4,
+    0x20, 0xf5, 0x3d, 0x1e, 0x87, 0xc8, 0x0a, 0x3e, 0x51, 0x91, 0x41, 0x3e, 0xeb, 0x1a, 0x4c, 0xd7, 0x6a, 0x8e, 0x06, 0xb4,
+    0x28, 0x67, 0xa7, 0x70, 0x99, 0x17, 0xac, 0x33, 0x3a, 0xc1, 0xdd, 0x0e, 0xba, 0x14, 0xa1, 0xc8, 0x07, 0xcb, 0x39, 0x90,
+    0x3c, 0xd5, 0x23, 0x24, 0xa4, 0x34, 0x39, 0x3f, 0x21, 0x43, 0xd2, 0xc7, 0x8a, 0x27, 0x3f, 0xd9, 0x3f, 0x7e, 0x23, 0x97,
+    0xcb, 0x64, 0xa1, 0x70, 0xe5, 0x73, 0xe3, 0xb3, 0x83, 0x0c, 0x58, 0x16, 0x68, 0xf2, 0x1e, 0x8f, 0xa0, 0xd3, 0x22, 0xa5,
+    0x0f, 0x23, 0xc3, 0x11, 0x61, 0x9d, 0xfc, 0xf0, 0x75, 0xd2, 0x1c, 0xf7, 0xa5, 0x85, 0x3a, 0xa7, 0x5c, 0xce, 0x17, 0x54,
+    0x02, 0xf9, 0x04, 0x52, 0x61, 0x91, 0x6e, 0xf4, 0xaa, 0x3a, 0xe1, 0x1a, 0x67, 0x95, 0xc6, 0x11, 0x4f, 0xc9, 0x79, 0xc2,
+    0x40, 0x54, 0xdd, 0x6c, 0x2b, 0x05, 0x88, 0xbb, 0x9a, 0x1b, 0xdc, 0x46, 0xed, 0xec, 0xf5, 0xb6, 0x4e, 0xbd, 0x1a, 0x67,
+    0x1b, 0x9d, 0x71, 0x22, 0x41, 0xfd, 0x07, 0x57, 0x81, 0xc1, 0x6d, 0xd4, 0x3e, 0xe0, 0x52, 0x75, 0x4f, 0xf5, 0x6a, 0x72,
+    0x8d, 0xcb, 0x35, 0x2f, 0x3e, 0x92, 0x53, 0x09, 0x7f, 0x66, 0x10, 0x07, 0xf7, 0xff, 0xa6, 0x99, 0x66, 0x57, 0xf3, 0xe8,
+    0x1b, 0x79, 0x46, 0x1c, 0x72, 0xfe, 0xf6, 0x9b, 0xb3, 0x71, 0x7b, 0x09, 0x73, 0x2c, 0x04, 0xaa, 0x33, 0x09, 0x3b, 0xd1,
+    0x54, 0x1a, 0xe5, 0xaa, 0xa3, 0x37, 0x10, 0xf2, 0x68, 0x38, 0x24, 0x58, 0xdf, 0x10, 0x62, 0xcd, 0x31, 0xf2, 0xaa, 0x16,
+    0xd4, 0xd1, 0xc9, 0xa9, 0x39, 0xc9, 0x6e, 0xbf, 0x69, 0x1d, 0xfe, 0xfd, 0xd7, 0xd8, 0x21, 0xde, 0x46, 0xcd, 0x3a, 0x3f,
+    0x0e, 0x02, 0x50, 0x8a, 0x5c, 0x98, 0x2b, 0x8c, 0x4c, 0x26, 0xa5, 0x40, 0x57, 0x9d, 0xd3, 0xf4, 0x4a, 0x29, 0x5e, 0xa3,
+    0x73, 0x76, 0x41, 0x8e, 0x19, 0xc3, 0x10, 0x9a, 0x58, 0xef, 0xe8, 0xf0, 0x34, 0xdf, 0x62, 0x12, 0xc7, 0x10, 0x68, 0xa4,
+    0x3a, 0x16, 0x1c, 0x4f, 0x9e, 0xda, 0xef, 0x25, 0xc8, 0x01, 0x56, 0x6d, 0xa2, 0xed, 0x1d, 0x58, 0xf5, 0x51, 0xa3, 0xa6,
+    0x72, 0x5c, 0xe1, 0x6d, 0x82, 0x07, 0x9c, 0x0a, 0x32, 0xd1, 0x12, 0xe2, 0x99, 0x8e, 0x4a, 0xf9, 0xa8, 0xaa, 0x49, 0xdc,
+    0xd1, 0xfe, 0x48, 0xda, 0x55, 0x13, 0x37, 0x76, 0x32, 0xdf, 0x8d, 0xdb, 0x29, 0x1e, 0xc2, 0x88, 0x4c, 0xf0, 0x59, 0xa8,
+    0x2d, 0x31, 0x77, 0x73, 0x06, 0x0c, 0xf0, 0xca, 0xbc, 0x1f, 0xa4, 0x8b, 0xe7, 0xb1, 0xf9, 0x90, 0x95, 0x5e, 0x9e, 0x95,
+    0xf3, 0x13, 0xa7, 0x6c, 0x30, 0x05, 0x60, 0x5b, 0x16, 0xeb, 0x0d, 0x1a, 0x20, 0x5a, 0xc4, 0xdb, 0xdb, 0x7c, 0x76, 0xcd,
+    0x16, 0xd5, 0x35, 0xb9, 0x01, 0x1d, 0xd4, 0x32, 0xdd, 0xb2, 0xab, 0x2c, 0xb0, 0x60, 0x6a, 0x6e, 0x8b, 0x1d, 0xa3, 0xbf,
+    0x16, 0x5c, 0x25, 0x00, 0x29, 0x0c, 0x9b, 0x9b, 0xb2, 0x9a, 0xce, 0x12, 0x57, 0x04, 0x5e, 0x15, 0x86, 0x0d, 0xf0, 0x47,
+    0x96, 0xdf, 0x02, 0x4d, 0x6b, 0xa3, 0xba, 0x75, 0x90, 0xf0, 0x1a, 0x4e, 0x73, 0xaa, 0xdb, 0xf9, 0x73, 0x6b, 0x30, 0xfb,
+    0x9d, 0xee, 0xe6, 0xd5, 0x6c, 0xcd, 0xb0, 0xa8, 0x27, 0xe0, 0x3e, 0x94, 0x87, 0xdd, 0x9a, 0x71, 0xb1, 0x63, 0xbd, 0x5f,
+    0xdd, 0xd2, 0x3b, 0x7c, 0x15, 0x01, 0xef, 0x5c, 0x6b, 0xf9, 0xc4, 0xbc, 0xdc, 0x95, 0x22, 0xde, 0x58, 0x9c, 0xd3, 0xbb,
+    0x2b, 0x6b, 0xd5, 0x3e, 0xef, 0x3f, 0x32, 0x6b, 0x23, 0x75, 0x2a, 0xe9, 0x6c, 0x8e, 0xc7, 0xc5, 0x96, 0x7f, 0xfd, 0xd9,
+    0xb0, 0x51, 0x08, 0xcb, 0xb8, 0xfd, 0x25, 0x5f, 0x83, 0x35, 0x2e, 0x9f, 0xee, 0x86, 0xe9, 0x62, 0xf2, 0xe1, 0xf8, 0x7c,
+    0x7f, 0xf9, 0x6f, 0x5e, 0x0d, 0x25, 0xe9, 0x3c, 0x4f, 0x42, 0x39, 0x35, 0x25, 0xf1, 0xbe, 0x43, 0x51, 0x9f, 0x19, 0xeb,
+    0xf7, 0xff, 0xb9, 0x2c, 0xe7, 0xcb, 0xae, 0x6d, 0xb9, 0xec, 0xef, 0x77, 0x79, 0x61, 0x5b, 0x47, 0xf2, 0x09, 0xfb, 0x52,
+    0x7c, 0xe8, 0xca, 0x6e, 0xab, 0x31, 0x5e, 0xa8, 0xe2, 0xda, 0xc2, 0x24, 0xa6, 0x6e, 0x60, 0x16, 0xaf, 0x1f, 0x3f, 0x59,
+    0x06, 0x1d, 0xce, 0x56, 0x1e, 0xc1, 0x67, 0x21, 0x03, 0x62, 0xa6, 0x76, 0xb4, 0x6a, 0x11, 0x85, 0x58, 0x2b, 0x30, 0x03,
+    0x9c, 0x33, 0x6c, 0x03, 0x52, 0xcc, 0x85, 0x11, 0xad, 0xc7, 0x28, 0xe5, 0x4c, 0xe4, 0x6a, 0x66, 0xb0, 0x22, 0xea, 0xba,
+    0xd9, 0xf9, 0x8a, 0x77, 0xae, 0xeb, 0xfc, 0x11, 0x3b, 0x4d, 0xf2, 0xfd, 0x3b, 0x71, 0xde, 0x63, 0x73, 0x98, 0x97, 0xc3,
+    0x9a, 0x23, 0xb9, 0xcc, 0xa4, 0x49, 0xea, 0xf1, 0x82, 0x16, 0xef, 0xd0, 0x0e, 0x55, 0x09, 0x5f, 0xf3, 0xbb, 0xf8, 0x59,
+    0x45, 0x6c, 0xa2, 0xa7, 0x6d, 0x3d, 0x5c, 0x3f, 0x59, 0xd6, 0xe1, 0x57, 0xa4, 0x18, 0xb5, 0x48, 0x15, 0xb1, 0x56, 0x5d,
+    0x61, 0x6b, 0x92, 0x28, 0x34, 0x61, 0xf8, 0x5e, 0xef, 0x44, 0xf3, 0x63, 0xaa, 0xf9, 0x1c, 0x6a, 0x1e, 0xf2, 0x2d, 0x8a,
+    0x99, 0xc5, 0xd9, 0xa4, 0x28, 0xec, 0x83, 0x63, 0xa6, 0xcc, 0x16, 0xbf, 0xf8, 0x8d, 0x30, 0x8b, 0x03, 0x5b, 0x94, 0x78,
+    0xaf, 0x63, 0x1f, 0xe9, 0x32, 0xaa, 0x69, 0x93, 0x2c, 0xd7, 0x3d, 0x4d, 0xde, 0x62, 0x0d, 0x09, 0x4b, 0x82, 0xcc, 0xd4,
+    0x6f, 0x67, 0x06, 0xfa, 0x8d, 0x00, 0x33, 0x3c, 0xb9, 0x3f, 0x63, 0x6e, 0xde, 0x79, 0x35, 0xfd, 0x06, 0x76, 0x78, 0x08,
+    0x74, 0x2d, 0xbe, 0x63, 0x3a, 0xa1, 0x8e, 0xb0, 0xef, 0x04, 0x19, 0x11, 0xac, 0x85, 0x5c, 0x8c, 0xdd, 0x07, 0x68, 0xf8,
+    0x90, 0x2c, 0xb0, 0x3c, 0xfc, 0x86, 0x05, 0x85, 0x89, 0x7c, 0x43, 0x83, 0xc8, 0x75, 0x3f, 0x0b, 0x3a, 0x05, 0xd1, 0x22,
+    0xb7, 0xa6, 0x55, 0xfb, 0xd2, 0x34, 0xdc, 0x1f, 0x38, 0x60, 0x83, 0x89, 0x14, 0xec, 0x4a, 0x4e, 0xcf, 0x6f, 0xf0, 0x10,
+    0x7d, 0x59, 0x79, 0xe5, 0xd8, 0x61, 0xfa, 0x1e, 0xa4, 0x71, 0x26, 0x44, 0x45, 0xe0, 0x60, 0x7e, 0x25, 0xe0, 0x23, 0x1e,
+    0x97, 0x3a, 0x36, 0x34, 0x9c, 0x93, 0xe3, 0xb1, 0xc2, 0x9e, 0xd1, 0x90, 0xcb, 0xb9, 0xad, 0x05, 0x63, 0x10, 0xc2, 0xc5,
+    0xba, 0x46, 0x23, 0xe3, 0xfc, 0xff, 0x27, 0xd4, 0xb0, 0x5c, 0x7f, 0x88, 0x32, 0x33, 0xbf, 0xb1, 0x42, 0x73, 0xab, 0x72,
+    0x94, 0xf1, 0xcc, 0xa8, 0xc8, 0x35, 0x21, 0x0e, 0xcd, 0x15, 0xee, 0x1e, 0x74, 0x69, 0xca, 0xbb, 0x26, 0x8e, 0x07, 0xcd,
+    0x46, 0x47, 0x47, 0x10, 0xbb, 0x88, 0x48, 0x91, 0x20, 0x98, 0x28, 0x14, 0xe3, 0xce, 0x57, 0x95, 0xc4, 0x6e, 0x73, 0x03,
+    0x31, 0xd9, 0xc2, 0x59, 0x40, 0x8d, 0x11, 0x90, 0x32, 0x91, 0x06, 0x6e, 0x36, 0x96, 0xe0, 0x76, 0xac, 0xc0, 0x3d, 0x58,
+    0xf7, 0xcc, 0xc6, 0x3a, 0x09, 0x29, 0xa6, 0x88, 0x79, 0x07, 0x2d, 0x62, 0x17, 0x9b, 0x96, 0xd8, 0x03, 0x1f, 0xbf, 0xa1,
+    0x40, 0x9f, 0x99, 0xfe, 0x1d, 0x03, 0xed, 0xae, 0xc5, 0x2d, 0xf2, 0xc2, 0xbc, 0x83, 0x3e, 0xb6, 0xea, 0x79, 0x07, 0x3c,
+    0xe8, 0xe6, 0x5d, 0x7a, 0xd7, 0xfe, 0x1f, 0xfa, 0x0f, 0xde, 0xa2, 0x01, 0xa1, 0x9d, 0x0e, 0x00, 0x00,
+};
+static const OTADashAsset info_html = { "text/html", info_html_gz, sizeof(info_html_gz), "\"765b785250de3fe8\"", "no-cache" };
+
+// restart.html
+static const uint8_t restart_html_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x6d, 0x53, 0x51, 0x6f, 0xd3, 0x30, 0x10, 0x7e, 0xef, 0xaf,
+    0xf0, 0xc2, 0x43, 0x3a, 0x69, 0x49, 0xda, 0x31, 0xa6, 0x2d, 0x4d, 0x82, 0x04, 0x03, 0xf1, 0x00, 0xda, 0x04, 0x7d, 0x41,
+    0x88, 0x07, 0xc7, 0xbe, 0x34, 0xa7, 0x3a, 0x76, 0x64, 0x3b, 0xdd, 0xca, 0xd4, 0xff, 0xce, 0xc5, 0x69, 0x91, 0x18, 0x44,
+    0x8a, 0xe3, 0x3b, 0x7f, 0xf7, 0xdd, 0xf9, 0xee, 0x4b, 0x71, 0x76, 0x77, 0xff, 0x7e, 0xfd, 0xfd, 0xe1, 0x03, 0xfb, 0xb4,
+    0xfe, 0xf2, 0xb9, 0x2a, 0x5a, 0xdf, 0x29, 0x5a, 0x81, 0xcb, 0xaa, 0xf0, 0xe8, 0x15, 0x54, 0x5f, 0xc1, 0x79, 0x6e, 0x3d,
+    0xbb, 0x83, 0x1d, 0x0a, 0x28, 0xb2, 0xc9, 0x5b, 0x74, 0xe0, 0x39, 0xd3, 0xbc, 0x83, 0x32, 0xda, 0x21, 0x3c, 0xf6, 0xc6,
+    0xfa, 0x88, 0x09, 0xa3, 0x3d, 0x68, 0x5f, 0x46, 0x8f, 0x28, 0x7d, 0x5b, 0xca, 0x10, 0x92, 0x04, 0xe3, 0x82, 0xa1, 0x46,
+    0x8f, 0x5c, 0x25, 0x4e, 0x70, 0x05, 0xe5, 0x32, 0xaa, 0x0a, 0x85, 0x7a, 0xcb, 0x2c, 0xa8, 0x32, 0x72, 0x7e, 0xaf, 0xc0,
+    0xb5, 0x00, 0x44, 0xd2, 0x5a, 0x68, 0xca, 0x28, 0x1b, 0x19, 0xb9, 0x4a, 0x85, 0x73, 0x6f, 0x77, 0xe5, 0xed, 0xe5, 0xd5,
+    0xe2, 0xf2, 0x4a, 0xc8, 0x25, 0xaf, 0x17, 0xd7, 0xd7, 0xd7, 0x37, 0x14, 0x1c, 0x42, 0x2a, 0xd4, 0xfd, 0xe0, 0x7f, 0xf8,
+    0x7d, 0x4f, 0x75, 0xb8, 0xa1, 0xee, 0xd0, 0x47, 0x3f, 0x9f, 0x7b, 0x2e, 0x25, 0xea, 0x4d, 0xbe, 0x5c, 0xf4, 0x4f, 0xec,
+    0x92, 0x96, 0x55, 0x43, 0x85, 0x25, 0x0e, 0x7f, 0x41, 0xbe, 0xbc, 0x21, 0xb3, 0xe3, 0x76, 0x83, 0x3a, 0x0f, 0x47, 0x62,
+    0xb0, 0xce, 0xd8, 0xbc, 0x37, 0x48, 0xb5, 0xdb, 0x55, 0x6d, 0xac, 0x04, 0x9b, 0x6b, 0xa3, 0xe1, 0xb8, 0x4f, 0x2c, 0x97,
+    0x38, 0xb8, 0xfc, 0x0d, 0x81, 0x6b, 0x2e, 0xb6, 0x1b, 0x6b, 0x06, 0x2d, 0x13, 0x61, 0x14, 0x85, 0xbd, 0x6a, 0x16, 0xb7,
+    0xe2, 0xb5, 0x5c, 0x9d, 0xac, 0xf0, 0xac, 0x3c, 0x3c, 0xf9, 0x44, 0x82, 0x30, 0x96, 0x7b, 0x34, 0x7a, 0x62, 0x93, 0xe8,
+    0x7a, 0xc5, 0xf7, 0x39, 0x6a, 0xba, 0x37, 0x24, 0xb5, 0x32, 0x62, 0xbb, 0x0a, 0xbd, 0xa1, 0xa2, 0xc6, 0x4a, 0x5a, 0xc0,
+    0x4d, 0xeb, 0xf3, 0xab, 0x71, 0x1f, 0x18, 0xb8, 0xc2, 0x8d, 0xce, 0x05, 0x84, 0xc2, 0x42, 0xd0, 0x11, 0x32, 0x16, 0x7e,
+    0x28, 0xb2, 0xa9, 0x05, 0x45, 0x36, 0x8d, 0xab, 0x36, 0x72, 0x5f, 0x15, 0x12, 0x77, 0x4c, 0x28, 0xee, 0x5c, 0x19, 0x8d,
+    0xd3, 0xe0, 0x14, 0x65, 0xa9, 0x5b, 0xed, 0xf2, 0x9f, 0x41, 0x92, 0xab, 0x68, 0x8c, 0xed, 0x18, 0xca, 0x32, 0xb2, 0xd3,
+    0xe1, 0x47, 0xb2, 0x09, 0x1d, 0xba, 0xca, 0xa6, 0xae, 0xd6, 0x83, 0xf7, 0x46, 0x47, 0x6c, 0xc7, 0xd5, 0x40, 0xe6, 0xdf,
+    0x2c, 0xd1, 0x29, 0xd7, 0x09, 0x65, 0xb4, 0x50, 0x28, 0xb6, 0xa7, 0x61, 0x1c, 0xd1, 0xf3, 0x73, 0x22, 0xcd, 0xc6, 0x64,
+    0x55, 0xc1, 0x4f, 0x03, 0x7e, 0x19, 0x5b, 0xbd, 0xa3, 0xe6, 0x16, 0x19, 0xa7, 0xd1, 0x0a, 0x8b, 0xbd, 0xaf, 0x9a, 0x41,
+    0x8b, 0xb1, 0x7d, 0xec, 0x05, 0x17, 0x7b, 0x9e, 0x35, 0xe0, 0x45, 0x3b, 0x8f, 0xb3, 0x63, 0xd9, 0xf1, 0x05, 0xf9, 0x48,
+    0x91, 0xad, 0x91, 0x39, 0x8b, 0x1f, 0xee, 0xbf, 0xad, 0xe3, 0xd9, 0xe1, 0x7c, 0x96, 0xfa, 0x16, 0xf4, 0x9c, 0x30, 0xbd,
+    0xd1, 0x0e, 0x58, 0x59, 0x11, 0x0a, 0x1b, 0xf6, 0xc7, 0x93, 0x9a, 0xed, 0x48, 0x46, 0x72, 0x24, 0xda, 0x78, 0xba, 0x11,
+    0x43, 0xc7, 0x8e, 0xac, 0x24, 0xa1, 0x34, 0x4d, 0xe3, 0xf3, 0xd5, 0xcc, 0x81, 0x5f, 0x63, 0x07, 0x66, 0xf0, 0x73, 0x4a,
+    0x1f, 0x78, 0x68, 0x7a, 0x61, 0xb6, 0x29, 0xe9, 0xd7, 0x70, 0x39, 0x27, 0xd4, 0xe1, 0x82, 0x2d, 0x17, 0x8b, 0xc5, 0xb8,
+    0x63, 0xa0, 0x28, 0xe1, 0x4b, 0xea, 0x23, 0x2f, 0x6b, 0x38, 0x2a, 0x90, 0x67, 0x23, 0xf3, 0x21, 0xd4, 0x49, 0x54, 0x74,
+    0x1d, 0xb0, 0xd6, 0xd8, 0x89, 0x9d, 0x46, 0xe7, 0x8c, 0x82, 0x34, 0xb8, 0xe6, 0xf1, 0x87, 0xf1, 0x93, 0xd3, 0x2d, 0x83,
+    0x4d, 0x61, 0xff, 0xe7, 0x05, 0x2d, 0x48, 0x9a, 0x24, 0x16, 0x90, 0x8c, 0xeb, 0x09, 0x3c, 0x65, 0x19, 0x5f, 0xd2, 0xcb,
+    0xd4, 0xd7, 0x22, 0x23, 0x91, 0xd0, 0x3a, 0x09, 0x26, 0x0b, 0xbf, 0xfc, 0x6f, 0x3c, 0xca, 0x20, 0x6c, 0x08, 0x04, 0x00,
+    0x00,
+};
+static const OTADashAsset restart_html = { "text/html", restart_html_gz, sizeof(restart_html_gz), "\"fe323979c58074b7\"", "no-cache" };
+
+// update.html
+static const uint8_t update_html_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x8d, 0x58, 0x6d, 0x73, 0xdb, 0x36, 0x12, 0xfe, 0xee, 0x5f,
+    0x81, 0xa8, 0x93, 0x90, 0xba, 0xc8, 0x14, 0xad, 0x38, 0x1e, 0x9f, 0xde, 0x32, 0x76, 0x62, 0x5f, 0x33, 0xd3, 0x34, 0xb9,
+    0x5a, 0x9e, 0xbb, 0x4c, 0x26, 0xed, 0x40, 0x24, 0x28, 0xa2, 0xa6, 0x08, 0x1e, 0x08, 0x5a, 0x56, 0x5d, 0xf7, 0xb7, 0xdf,
+    0xb3, 0x00, 0x29, 0xd3, 0x96, 0xe2, 0xc6, 0x1f, 0x6c, 0x02, 0x58, 0xec, 0xfb, 0x3e, 0xbb, 0xf0, 0xf8, 0xd9, 0xbb, 0x8f,
+    0x6f, 0x67, 0x9f, 0x3f, 0x9d, 0xb1, 0x1f, 0x67, 0x1f, 0x7e, 0x9a, 0x8e, 0x53, 0xb3, 0xcc, 0xf0, 0x5b, 0xf0, 0x78, 0x3a,
+    0x36, 0xd2, 0x64, 0x62, 0x7a, 0x2e, 0xf5, 0x72, 0xc5, 0xb5, 0x60, 0x97, 0x45, 0xcc, 0x8d, 0x18, 0xf7, 0xdd, 0xf6, 0x78,
+    0x29, 0x0c, 0x67, 0x39, 0x5f, 0x8a, 0x49, 0xe7, 0x5a, 0x8a, 0x55, 0xa1, 0xb4, 0xe9, 0xb0, 0x48, 0xe5, 0x46, 0xe4, 0x66,
+    0xd2, 0x59, 0xc9, 0xd8, 0xa4, 0x93, 0x58, 0x5c, 0xcb, 0x48, 0xec, 0xdb, 0x45, 0x8f, 0xc9, 0x5c, 0x1a, 0xc9, 0xb3, 0xfd,
+    0x32, 0xe2, 0x99, 0x98, 0x1c, 0x74, 0xa6, 0xe3, 0x4c, 0xe6, 0x57, 0x4c, 0x8b, 0x6c, 0xd2, 0x29, 0xcd, 0x3a, 0x13, 0x65,
+    0x2a, 0x04, 0x98, 0xa4, 0x5a, 0x24, 0x93, 0x4e, 0x9f, 0x38, 0xf2, 0x2c, 0x88, 0xca, 0xf2, 0xcd, 0xf5, 0xe4, 0x9f, 0x83,
+    0xc3, 0x70, 0x70, 0x18, 0xc5, 0x07, 0x7c, 0x1e, 0x1e, 0x1d, 0x1d, 0x1d, 0xe3, 0xb2, 0xbd, 0x32, 0x95, 0x79, 0x51, 0x99,
+    0x2f, 0x66, 0x5d, 0x40, 0x8f, 0xb2, 0x9a, 0x2f, 0xa5, 0xe9, 0x7c, 0xbd, 0x2d, 0x78, 0x1c, 0xcb, 0x7c, 0x31, 0x3c, 0x08,
+    0x8b, 0x1b, 0x36, 0xc0, 0xaf, 0x51, 0x02, 0xc5, 0xf6, 0x4b, 0xf9, 0x87, 0x18, 0x1e, 0x1c, 0x63, 0xb9, 0xe4, 0x7a, 0x21,
+    0xf3, 0xa1, 0x3d, 0x8a, 0x2a, 0x5d, 0x2a, 0x3d, 0x2c, 0x94, 0x84, 0xee, 0x7a, 0x34, 0x57, 0x3a, 0x16, 0x7a, 0x98, 0xab,
+    0x5c, 0xd4, 0xdf, 0xfb, 0x9a, 0xc7, 0xb2, 0x2a, 0x87, 0xaf, 0x41, 0x3c, 0xe7, 0xd1, 0xd5, 0x42, 0xab, 0x2a, 0x8f, 0xf7,
+    0x23, 0x95, 0xe1, 0xda, 0x0f, 0x61, 0x78, 0xfc, 0xea, 0x38, 0x19, 0xd5, 0xab, 0xc4, 0xfe, 0x8c, 0x8c, 0xb8, 0x31, 0xfb,
+    0xb1, 0x88, 0x94, 0xe6, 0x46, 0xaa, 0xdc, 0x71, 0x8b, 0x65, 0x59, 0x64, 0x7c, 0x3d, 0x94, 0x39, 0xec, 0x16, 0xfb, 0xf3,
+    0x4c, 0x45, 0x57, 0x23, 0xeb, 0x1b, 0x28, 0x45, 0x9a, 0xa4, 0x42, 0x2e, 0x52, 0x33, 0x3c, 0xa4, 0x6f, 0xcb, 0x81, 0x67,
+    0x72, 0x91, 0x0f, 0x23, 0x61, 0x15, 0xb3, 0x97, 0x6a, 0x12, 0x52, 0xfc, 0xae, 0x6d, 0x7a, 0x22, 0x33, 0xf1, 0xc8, 0xf0,
+    0xc6, 0x92, 0x01, 0x7c, 0x10, 0x73, 0xf8, 0x36, 0x66, 0x8d, 0xb2, 0xdb, 0x76, 0x39, 0x35, 0x06, 0xe1, 0xb6, 0x43, 0xee,
+    0x7e, 0x28, 0xb4, 0x5a, 0x68, 0x51, 0x96, 0x6f, 0xe1, 0x43, 0x0e, 0x25, 0xf4, 0x6d, 0xad, 0x74, 0x18, 0x3e, 0xaf, 0x3d,
+    0xb9, 0x6f, 0x54, 0xe1, 0xbc, 0xd9, 0x18, 0xd9, 0xf2, 0x9f, 0xd5, 0xa0, 0x54, 0x99, 0x7c, 0x4a, 0x81, 0x42, 0x95, 0xd2,
+    0xba, 0x0a, 0xe9, 0x00, 0x9f, 0x5d, 0x8b, 0x7b, 0xb9, 0xa7, 0xbc, 0x91, 0x08, 0x79, 0x2d, 0x07, 0x7c, 0x3b, 0x18, 0xdb,
+    0xec, 0x8d, 0xe6, 0x79, 0x2d, 0xc0, 0xb2, 0x62, 0x61, 0x70, 0x58, 0x32, 0xc1, 0x4b, 0xf1, 0x94, 0xe4, 0x19, 0x82, 0x70,
+    0xbb, 0x39, 0xe7, 0x73, 0x18, 0x51, 0x19, 0x31, 0x6a, 0x99, 0xbf, 0x1d, 0x26, 0xf2, 0x44, 0x38, 0xca, 0x44, 0x62, 0xf0,
+    0xe7, 0x61, 0x56, 0xd8, 0x24, 0x5c, 0x39, 0x03, 0xe6, 0x2a, 0x8b, 0xb7, 0x43, 0x3a, 0xee, 0xbb, 0xac, 0x1e, 0xf7, 0x5d,
+    0x09, 0xce, 0x55, 0xbc, 0x9e, 0x8e, 0x63, 0x79, 0xcd, 0xa2, 0x8c, 0x97, 0xe5, 0xa4, 0x13, 0x35, 0x31, 0x40, 0x01, 0xa4,
+    0x07, 0xdb, 0xc5, 0x89, 0xbd, 0x71, 0xa2, 0xf4, 0x92, 0xc9, 0x78, 0xd2, 0xa9, 0xec, 0xe6, 0x39, 0x96, 0xa0, 0xb6, 0xd9,
+    0xc2, 0x5a, 0xd9, 0x62, 0x49, 0x92, 0x9a, 0xc1, 0xb9, 0xdd, 0x71, 0xe5, 0xdc, 0xec, 0x75, 0x18, 0x8f, 0x22, 0x51, 0xa0,
+    0x9a, 0x83, 0xb9, 0xcc, 0x7b, 0xc1, 0xe2, 0x8f, 0x5e, 0x50, 0x70, 0x13, 0xa5, 0x1d, 0xd4, 0xec, 0xff, 0x2a, 0xa9, 0x45,
+    0xfc, 0x90, 0xed, 0xbc, 0x32, 0x46, 0xe5, 0x1d, 0x76, 0xcd, 0xb3, 0x0a, 0x4b, 0xa7, 0x13, 0x3b, 0xdf, 0xb0, 0xab, 0x6d,
+    0x68, 0xc8, 0xee, 0x55, 0x3c, 0xad, 0x77, 0x54, 0x1e, 0x65, 0x32, 0xba, 0x6a, 0x2a, 0xd9, 0x31, 0xf0, 0xbb, 0xd0, 0xbe,
+    0x4f, 0x46, 0x39, 0x4f, 0xd0, 0xb5, 0xad, 0x94, 0xec, 0x6c, 0x9f, 0x21, 0x6d, 0x76, 0xec, 0x52, 0x48, 0x3b, 0xd3, 0xf0,
+    0xf9, 0xb8, 0x8f, 0x93, 0xe9, 0x83, 0xdf, 0xbc, 0x41, 0x9e, 0xc7, 0x9a, 0x4e, 0x4f, 0x91, 0x68, 0xe3, 0x3e, 0x07, 0xe6,
+    0x44, 0x5a, 0x16, 0x66, 0x7a, 0xcd, 0x35, 0xfb, 0xe5, 0x6c, 0xf6, 0xcb, 0xe7, 0xdf, 0xde, 0x9d, 0xfd, 0x74, 0xf2, 0x99,
+    0x4d, 0x18, 0x92, 0x21, 0x1c, 0xb1, 0xc7, 0x3f, 0xfd, 0x3e, 0x3b, 0x49, 0x90, 0x14, 0x8c, 0xb3, 0x58, 0xab, 0xa2, 0x40,
+    0x09, 0x92, 0xe7, 0x44, 0x69, 0x7a, 0x6c, 0x2e, 0x60, 0x92, 0x60, 0x46, 0xaf, 0x51, 0xb0, 0x8c, 0x2f, 0x60, 0xc6, 0xde,
+    0x3d, 0xdf, 0x0f, 0x27, 0xff, 0x25, 0xae, 0x83, 0x1d, 0x4c, 0x1d, 0x5f, 0x58, 0x5e, 0x8a, 0xa8, 0xa2, 0x7c, 0x65, 0x09,
+    0x47, 0xf4, 0x36, 0xac, 0xcb, 0x86, 0xf5, 0x42, 0x5e, 0x13, 0xeb, 0xaa, 0xa8, 0xf9, 0xfe, 0xfb, 0xf2, 0xec, 0x62, 0xf6,
+    0xdb, 0xec, 0xfd, 0x87, 0xb3, 0x8f, 0x97, 0xb3, 0x5a, 0xe7, 0x70, 0x64, 0x0f, 0x23, 0x1d, 0xcd, 0xf8, 0x3c, 0x13, 0xd8,
+    0xcd, 0xab, 0x2c, 0x1b, 0xed, 0x25, 0x55, 0x1e, 0x51, 0xd2, 0xd3, 0xc9, 0xab, 0x81, 0x3f, 0x5f, 0x1b, 0x51, 0xf6, 0x68,
+    0xd1, 0x65, 0xb7, 0x7b, 0x32, 0x61, 0xfe, 0xb3, 0xe6, 0x0a, 0x6d, 0xb4, 0xaf, 0x8b, 0x15, 0xbb, 0x04, 0x70, 0xbc, 0x1a,
+    0x9c, 0x68, 0xcd, 0xd7, 0xfe, 0xe0, 0xf5, 0x51, 0x17, 0xec, 0x94, 0x66, 0x3e, 0x09, 0xca, 0x41, 0x02, 0x9b, 0x72, 0x36,
+    0x66, 0x38, 0xc1, 0xc7, 0xcb, 0x97, 0xc4, 0xc0, 0xea, 0x40, 0xb7, 0x5b, 0xa4, 0x57, 0x8e, 0xf4, 0x0a, 0xa4, 0xc7, 0xf8,
+    0xe3, 0x08, 0x89, 0x28, 0x62, 0x2f, 0xd8, 0x01, 0x7b, 0xc3, 0xc2, 0x9b, 0xb3, 0x77, 0xa7, 0xc7, 0xc7, 0xaf, 0x06, 0x21,
+    0xfb, 0x95, 0xf9, 0x11, 0x9b, 0x4e, 0xa7, 0xec, 0xa0, 0xcb, 0x86, 0xac, 0xfe, 0x1c, 0xed, 0xdd, 0x6d, 0x34, 0xfb, 0x92,
+    0x7f, 0xa5, 0x9b, 0xb4, 0x65, 0x37, 0xb1, 0xf8, 0x0b, 0x7f, 0x5a, 0xe2, 0xa4, 0x13, 0x27, 0x21, 0xce, 0x5a, 0x1b, 0x64,
+    0x22, 0x5f, 0x98, 0x14, 0x3b, 0xb5, 0x64, 0x7b, 0x69, 0xc3, 0xcf, 0xa7, 0xf5, 0xaf, 0x8e, 0xf4, 0x8b, 0xfc, 0xda, 0x85,
+    0x4e, 0xe1, 0xcd, 0xf9, 0xf9, 0x57, 0xab, 0x8a, 0x76, 0x1a, 0x1c, 0x77, 0x49, 0x9e, 0x16, 0xa6, 0xd2, 0xb9, 0x15, 0x67,
+    0x77, 0x43, 0xda, 0xdc, 0xf8, 0x77, 0xc5, 0xa5, 0xf1, 0x97, 0x25, 0x49, 0xa8, 0x09, 0xc9, 0x83, 0x9f, 0xb4, 0x5a, 0xca,
+    0x52, 0xf8, 0xc8, 0x58, 0x95, 0x21, 0xc2, 0x93, 0x29, 0x2b, 0x85, 0x99, 0xc9, 0xa5, 0x50, 0x95, 0x69, 0x76, 0x7b, 0x0c,
+    0xf7, 0xac, 0x08, 0x5e, 0xae, 0xf3, 0x88, 0xdd, 0xc7, 0x8c, 0x67, 0x99, 0x8f, 0xfe, 0x9c, 0xaa, 0xb8, 0xc7, 0x2a, 0x9d,
+    0x21, 0xd9, 0x80, 0x23, 0x24, 0x62, 0x63, 0x2d, 0x37, 0x46, 0x2c, 0x0b, 0x43, 0x59, 0x30, 0x62, 0xa3, 0x66, 0xe9, 0x2c,
+    0x45, 0x4a, 0xd6, 0x21, 0x81, 0xa0, 0x82, 0xf2, 0x0c, 0x64, 0x9c, 0x14, 0x65, 0x89, 0x40, 0xf9, 0xfb, 0x96, 0xe5, 0xed,
+    0x9e, 0x93, 0x30, 0x64, 0xb5, 0xa4, 0x3d, 0x12, 0x32, 0xb4, 0xa2, 0x7a, 0x7b, 0x04, 0x5f, 0x42, 0x97, 0x6e, 0x89, 0x58,
+    0xdd, 0x32, 0xef, 0xad, 0x9b, 0x0d, 0xf6, 0x67, 0xc0, 0x0a, 0x6f, 0xc8, 0x3c, 0x5e, 0x14, 0x28, 0x76, 0xdb, 0x1f, 0xfb,
+    0x2a, 0x32, 0x02, 0xfd, 0xd9, 0x68, 0xc1, 0x97, 0x1e, 0xbb, 0x43, 0x0c, 0x6f, 0xef, 0x7a, 0x7b, 0x25, 0x60, 0x95, 0x67,
+    0x43, 0x76, 0x02, 0x3c, 0x37, 0x17, 0x76, 0x11, 0x98, 0xda, 0x07, 0x8f, 0xd2, 0xb9, 0xbb, 0x77, 0x07, 0x4f, 0xd4, 0x1e,
+    0xbc, 0x65, 0xa5, 0xe1, 0x06, 0xc8, 0xbf, 0x31, 0x20, 0x70, 0x1b, 0x3d, 0x34, 0x42, 0xc3, 0x87, 0xb5, 0x31, 0x9b, 0xc3,
+    0xdf, 0x4b, 0x95, 0xfb, 0x5d, 0x76, 0x07, 0x57, 0xc2, 0x77, 0xb0, 0x90, 0xf9, 0xa2, 0xc9, 0xf3, 0xc6, 0x51, 0xd3, 0xc9,
+    0x7d, 0x65, 0x5a, 0x27, 0xa5, 0x5a, 0xad, 0x6c, 0xac, 0xce, 0xb4, 0x56, 0xda, 0xf7, 0xde, 0xd9, 0x59, 0x87, 0xe5, 0x8a,
+    0x18, 0xf3, 0x28, 0xa5, 0x2c, 0xf1, 0x6c, 0x74, 0x10, 0xb9, 0x0b, 0x2b, 0xde, 0x27, 0x1f, 0xe4, 0xc2, 0x05, 0x29, 0x53,
+    0x84, 0x02, 0xd0, 0xa1, 0x5a, 0xa2, 0x4a, 0x83, 0x20, 0x20, 0x62, 0xa7, 0x98, 0xcd, 0x89, 0x16, 0xbe, 0x74, 0x5d, 0xda,
+    0xb6, 0xb2, 0xe6, 0x9e, 0x25, 0x35, 0x20, 0xd2, 0x27, 0x56, 0x51, 0xb5, 0x84, 0x7b, 0x83, 0x85, 0x30, 0x67, 0x99, 0xa0,
+    0xcf, 0xd3, 0xf5, 0xfb, 0xd8, 0xf7, 0xda, 0xc0, 0xe7, 0x75, 0x03, 0xa2, 0xaf, 0x23, 0x81, 0xa8, 0xd2, 0x6a, 0xf4, 0x88,
+    0xf1, 0xa7, 0xfa, 0x82, 0x1f, 0xa3, 0x85, 0xf7, 0x98, 0x51, 0x98, 0xc2, 0x9a, 0x1a, 0x2d, 0x84, 0xa6, 0x36, 0xf7, 0x56,
+    0x2d, 0x8b, 0x4c, 0x18, 0xca, 0x8b, 0x0f, 0xdc, 0xa4, 0x41, 0x92, 0x29, 0xb8, 0xc0, 0x5e, 0x60, 0xfd, 0xe6, 0xc6, 0x3f,
+    0x08, 0x60, 0xa0, 0xfa, 0xdf, 0x6a, 0x06, 0xa0, 0x86, 0x62, 0xb6, 0xf1, 0x05, 0xae, 0x39, 0x4f, 0xb6, 0x04, 0xbd, 0x64,
+    0xde, 0x73, 0x6f, 0xd4, 0x72, 0xe5, 0x4e, 0x82, 0x5d, 0xc5, 0x50, 0x15, 0x99, 0xe2, 0xb1, 0x2f, 0x97, 0x7c, 0x21, 0x1a,
+    0x33, 0x80, 0x93, 0xc8, 0xf1, 0x09, 0xf3, 0xde, 0xd0, 0x48, 0x38, 0xf1, 0x70, 0xdb, 0x9e, 0xd7, 0x35, 0x4f, 0xcc, 0x5e,
+    0xa0, 0x5c, 0xed, 0x81, 0x03, 0x40, 0x7b, 0xdc, 0x63, 0x64, 0x0f, 0x65, 0xc5, 0x4a, 0xe6, 0xb1, 0x5a, 0x05, 0x91, 0x5e,
+    0x17, 0x46, 0xb1, 0x17, 0x2f, 0x98, 0xfb, 0x0a, 0xd0, 0xb7, 0x8c, 0x85, 0xc4, 0x36, 0x54, 0x5f, 0x00, 0xa7, 0x01, 0xc7,
+    0x76, 0x36, 0xbe, 0x01, 0x3c, 0xab, 0x3c, 0x5b, 0xc3, 0xaf, 0xa9, 0x60, 0x6e, 0x3e, 0xa6, 0x4f, 0x14, 0x6d, 0x2a, 0xa2,
+    0xab, 0xd2, 0x6e, 0xaf, 0x52, 0x05, 0x2c, 0xb5, 0x22, 0xe1, 0x4c, 0x65, 0x55, 0x8e, 0xe5, 0x02, 0xd8, 0xde, 0x02, 0xd8,
+    0x63, 0x87, 0xaf, 0x2e, 0x63, 0x1e, 0x88, 0x0f, 0x1c, 0xad, 0xef, 0x5d, 0xfc, 0x78, 0xb2, 0x0f, 0x94, 0xf5, 0x7a, 0x8e,
+    0x17, 0x61, 0x85, 0xb3, 0xfc, 0x25, 0x4c, 0x7f, 0x51, 0xa6, 0x1c, 0x87, 0xd6, 0x46, 0xcb, 0x2a, 0x48, 0x00, 0x3a, 0xbe,
+    0xbb, 0x0b, 0xc4, 0x20, 0xcc, 0x99, 0x07, 0x46, 0x5d, 0x18, 0x8d, 0xfc, 0xf4, 0x0f, 0x8e, 0xba, 0x68, 0xfe, 0x31, 0xbc,
+    0xaf, 0x8d, 0x3f, 0xe8, 0x31, 0x2f, 0xf4, 0xba, 0xdd, 0xe0, 0x77, 0xcc, 0x88, 0xbe, 0xe7, 0xfc, 0x4e, 0x5a, 0x52, 0x99,
+    0xdd, 0xa3, 0x85, 0xc5, 0x21, 0xef, 0xd3, 0xc7, 0x8b, 0x19, 0x54, 0xf0, 0xfa, 0xbc, 0x90, 0x7d, 0x17, 0x8d, 0xfe, 0x5c,
+    0x60, 0x68, 0x24, 0xc9, 0x56, 0x9f, 0xda, 0xa9, 0xf6, 0x72, 0x5d, 0xa9, 0xec, 0xd9, 0x64, 0x82, 0xc9, 0x3d, 0xdc, 0x55,
+    0x6a, 0x8e, 0x8e, 0x2a, 0x39, 0x10, 0xb4, 0xc1, 0xfe, 0xfc, 0x93, 0x79, 0x97, 0x96, 0x31, 0xea, 0x29, 0xa9, 0x4a, 0x11,
+    0x3b, 0x8d, 0x56, 0x29, 0xfa, 0x22, 0x5a, 0x55, 0xeb, 0x02, 0xa5, 0x68, 0x53, 0xda, 0x8f, 0xf9, 0x7c, 0x8f, 0xac, 0x8d,
+    0xa5, 0x2a, 0x49, 0x90, 0x8c, 0x30, 0xb5, 0x45, 0xe1, 0xf6, 0x9c, 0x31, 0xf5, 0xf9, 0xf8, 0x41, 0x62, 0x6d, 0x5a, 0x5d,
+    0x5a, 0xe5, 0xd4, 0xde, 0xdc, 0x19, 0xa2, 0xc6, 0x6d, 0x2c, 0xdd, 0x9d, 0x5e, 0xc3, 0xfb, 0x65, 0x9b, 0xb7, 0xbd, 0x02,
+    0xe9, 0xdf, 0xeb, 0x61, 0x4b, 0xff, 0xc6, 0x71, 0xb2, 0x31, 0xde, 0x30, 0x7d, 0x9c, 0xda, 0x96, 0x92, 0x52, 0xbb, 0xc7,
+    0x1a, 0x21, 0x77, 0x4c, 0x64, 0x40, 0xfd, 0xdb, 0x36, 0x1e, 0x51, 0x30, 0x46, 0x3b, 0x47, 0x91, 0xb3, 0x6b, 0xc4, 0xd0,
+    0xa4, 0x34, 0x6b, 0x94, 0x28, 0x49, 0x97, 0xda, 0x18, 0xa0, 0x0c, 0x96, 0x91, 0x51, 0xba, 0x64, 0x34, 0xa1, 0x96, 0x46,
+    0x66, 0x19, 0x46, 0x13, 0x22, 0x5b, 0x69, 0x09, 0x58, 0xcd, 0x77, 0x1a, 0xf3, 0xaf, 0xb3, 0x2d, 0x5b, 0x5c, 0x4a, 0xb8,
+    0x98, 0x6e, 0x25, 0xca, 0x04, 0x89, 0x72, 0x18, 0x1e, 0xee, 0xc4, 0xe4, 0xd9, 0x7d, 0x8d, 0x35, 0xf3, 0x17, 0xe9, 0xe6,
+    0xd8, 0x3e, 0xc1, 0xef, 0x75, 0xf8, 0xaa, 0xfb, 0xd0, 0xfa, 0xd7, 0x3b, 0x8d, 0x27, 0xeb, 0x4f, 0x15, 0x00, 0xc3, 0x19,
+    0xca, 0xe6, 0x55, 0x92, 0xa0, 0xeb, 0x01, 0x7c, 0x32, 0x74, 0xc8, 0x04, 0x3e, 0x48, 0x99, 0x2c, 0x5d, 0x4f, 0xa9, 0x47,
+    0x31, 0xdb, 0x0e, 0x36, 0x10, 0xbb, 0x95, 0x3c, 0x94, 0xcb, 0x61, 0xef, 0x61, 0xd2, 0x38, 0xf4, 0x7f, 0x04, 0x6b, 0x0f,
+    0x27, 0xe4, 0x3a, 0xaf, 0xda, 0xd3, 0x3c, 0xdc, 0xfa, 0x4d, 0xe4, 0x6d, 0xd3, 0x91, 0x1b, 0xe8, 0x6e, 0x7b, 0x12, 0x7f,
+    0xea, 0x6e, 0x9b, 0xae, 0xb9, 0xbb, 0x35, 0x8e, 0x3f, 0xc5, 0x60, 0x8b, 0xd8, 0xab, 0xeb, 0xff, 0x59, 0x5b, 0xad, 0x80,
+    0xde, 0x28, 0x65, 0xab, 0x6e, 0x78, 0x26, 0x80, 0x3c, 0xde, 0xa7, 0x8c, 0x1e, 0x6d, 0x70, 0x78, 0x06, 0x97, 0x63, 0xae,
+    0x6e, 0xee, 0x30, 0xa2, 0xb7, 0x3d, 0xd4, 0x0d, 0x01, 0x4d, 0x9d, 0xd2, 0xf6, 0xcf, 0x78, 0xd6, 0x40, 0xa3, 0x6d, 0xf6,
+    0x5f, 0xc2, 0xaf, 0x01, 0xbd, 0x79, 0x36, 0xf2, 0x1d, 0x6d, 0x20, 0xf2, 0xb8, 0xfc, 0x8f, 0x34, 0xa9, 0xef, 0xd1, 0xcb,
+    0xc7, 0xeb, 0x12, 0xc2, 0x7f, 0xeb, 0x14, 0xcf, 0xa2, 0x27, 0x08, 0xec, 0x7b, 0x09, 0x48, 0x79, 0x6f, 0xc0, 0xfb, 0x1c,
+    0xcf, 0x23, 0x3c, 0x85, 0x89, 0xba, 0x36, 0x43, 0xc4, 0x01, 0x7b, 0x6c, 0x97, 0x7d, 0x72, 0xb1, 0x5a, 0x00, 0x43, 0x6e,
+    0x39, 0x56, 0xbb, 0xcc, 0x6c, 0x47, 0xa4, 0x6e, 0xa3, 0xf5, 0x2b, 0x9c, 0x5a, 0x1c, 0x3d, 0xc4, 0xd1, 0x39, 0xb7, 0xbc,
+    0xbe, 0x4d, 0x69, 0xff, 0x21, 0xe1, 0x9a, 0xec, 0x26, 0x41, 0x91, 0x8b, 0x07, 0x10, 0xe6, 0x46, 0x42, 0x57, 0x0f, 0x75,
+    0x43, 0xdd, 0xd9, 0x87, 0x76, 0xbb, 0xd8, 0xa2, 0xdb, 0xa9, 0xad, 0x0d, 0xbf, 0x4b, 0x5d, 0xa8, 0x2d, 0xe1, 0xc0, 0x49,
+    0xa8, 0xbd, 0xb3, 0x79, 0xd0, 0x3a, 0xa3, 0x90, 0xe6, 0x78, 0x82, 0x96, 0x25, 0x0a, 0xea, 0x19, 0x6b, 0x55, 0xf3, 0x8a,
+    0xb0, 0x24, 0x47, 0xb1, 0x83, 0x05, 0x75, 0x24, 0xeb, 0x91, 0xd6, 0x84, 0x8c, 0x8a, 0x40, 0xfb, 0xba, 0xdd, 0x83, 0x45,
+    0x76, 0xc0, 0x0c, 0xf0, 0xb6, 0x27, 0xa5, 0xa9, 0x96, 0x7a, 0xf6, 0xe1, 0xd3, 0x7d, 0x3c, 0xec, 0x7d, 0x43, 0x01, 0xf7,
+    0xb6, 0xc2, 0xb8, 0x0a, 0xbc, 0x14, 0xc1, 0x12, 0xba, 0x50, 0x27, 0x1d, 0xfd, 0x8d, 0xd3, 0x1b, 0x57, 0x7e, 0x87, 0xd7,
+    0xeb, 0xf8, 0xec, 0x70, 0x3a, 0xaa, 0x7e, 0xdc, 0xaf, 0x5f, 0x9c, 0xcd, 0x43, 0xd5, 0xfd, 0x43, 0xa0, 0x6f, 0xff, 0x4d,
+    0xf7, 0x7f, 0x98, 0x13, 0xd8, 0xf6, 0xbc, 0x13, 0x00, 0x00,
+};
+static const OTADashAsset update_html = { "text/html", update_html_gz, sizeof(update_html_gz), "\"262122241e7eb96d\"", "no-cache" };
+
+// wifimanage.html
+static const uint8_t wifimanage_html_gz[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x59, 0xeb, 0x72, 0xdb, 0xba, 0x11, 0xfe, 0xef, 0xa7,
+    0xc0, 0x61, 0xd2, 0x21, 0x35, 0x47, 0xa2, 0x64, 0xc7, 0x4e, 0x5d, 0xdd, 0x32, 0x89, 0xe3, 0xb4, 0xee, 0xe4, 0xe2, 0x89,
+    0xd3, 0xc9, 0x74, 0xce, 0x9c, 0x19, 0x43, 0x24, 0x28, 0xe1, 0x18, 0x22, 0x78, 0x00, 0xc8, 0xb2, 0xaa, 0xe8, 0x25, 0xda,
+    0xfe, 0xef, 0x2b, 0xf6, 0x11, 0xba, 0x0b, 0x02, 0x14, 0x29, 0xc9, 0x4e, 0x13, 0xcf, 0xd8, 0x20, 0xb0, 0xbb, 0xd8, 0xcb,
+    0xb7, 0x8b, 0x05, 0x32, 0xfc, 0xe9, 0xed, 0xa7, 0x8b, 0x2f, 0x7f, 0xbf, 0xbe, 0x24, 0x7f, 0xf9, 0xf2, 0xe1, 0xfd, 0x78,
+    0x38, 0x33, 0x73, 0x41, 0x04, 0xcd, 0xa7, 0xa3, 0x80, 0xe5, 0x01, 0x7c, 0x33, 0x9a, 0x8e, 0x87, 0x73, 0x66, 0x28, 0x49,
+    0x66, 0x54, 0x69, 0x66, 0x46, 0xc1, 0xdf, 0xbe, 0xbc, 0xeb, 0x9c, 0x07, 0x6e, 0x36, 0xa7, 0x73, 0x36, 0x0a, 0xee, 0x39,
+    0x5b, 0x16, 0x52, 0x99, 0x80, 0x24, 0x32, 0x37, 0x2c, 0x07, 0xaa, 0x25, 0x4f, 0xcd, 0x6c, 0x94, 0xb2, 0x7b, 0x9e, 0xb0,
+    0x8e, 0xfd, 0x68, 0x13, 0x9e, 0x73, 0xc3, 0xa9, 0xe8, 0xe8, 0x84, 0x0a, 0x36, 0x3a, 0x8e, 0x7b, 0x20, 0xc5, 0x70, 0x23,
+    0xd8, 0xf8, 0x2b, 0x7f, 0xc7, 0xc9, 0x07, 0x9a, 0xd3, 0x29, 0x9b, 0x03, 0xfb, 0xb0, 0x5b, 0x4e, 0x0f, 0x05, 0xcf, 0xef,
+    0x88, 0x62, 0x62, 0x14, 0x68, 0xb3, 0x12, 0x4c, 0xcf, 0x18, 0x83, 0x4d, 0x66, 0x8a, 0x65, 0xa3, 0xa0, 0x8b, 0x3b, 0x52,
+    0x11, 0x27, 0x5a, 0xbf, 0xba, 0x1f, 0xfd, 0xe9, 0xe4, 0xb4, 0x77, 0x72, 0x9a, 0xa4, 0xc7, 0x74, 0xd2, 0x7b, 0xf9, 0xf2,
+    0x25, 0x2a, 0x68, 0x59, 0xc6, 0xf1, 0x64, 0x61, 0x8c, 0xcc, 0xd7, 0x05, 0x4d, 0x53, 0x9e, 0x4f, 0xfb, 0xc7, 0xbd, 0xe2,
+    0x81, 0x9c, 0xc0, 0xaf, 0x41, 0x06, 0xba, 0x76, 0x34, 0xff, 0x07, 0xeb, 0x1f, 0x9f, 0xc3, 0xe7, 0x9c, 0xaa, 0x29, 0xcf,
+    0xed, 0xfa, 0x20, 0x59, 0x28, 0x2d, 0x55, 0xbf, 0x90, 0x1c, 0xcc, 0x51, 0x83, 0x89, 0x54, 0x29, 0x53, 0xfd, 0x5c, 0xe6,
+    0xcc, 0x8d, 0x3b, 0x8a, 0xa6, 0x7c, 0xa1, 0xfb, 0x67, 0x40, 0x3c, 0xa1, 0xc9, 0xdd, 0x54, 0xc9, 0x45, 0x9e, 0x76, 0x12,
+    0x29, 0x80, 0xed, 0x59, 0xaf, 0x77, 0xfe, 0xe2, 0x3c, 0x1b, 0xb8, 0xaf, 0xcc, 0xfe, 0x1b, 0x18, 0xf6, 0x60, 0x3a, 0x29,
+    0x4b, 0xa4, 0xa2, 0x86, 0xcb, 0xbc, 0x94, 0x96, 0x72, 0x5d, 0x08, 0xba, 0xea, 0xf3, 0x1c, 0x4c, 0x65, 0x9d, 0x89, 0x90,
+    0xc9, 0xdd, 0xc0, 0xba, 0xab, 0x7f, 0x7c, 0x8a, 0x9a, 0x58, 0x2e, 0x2a, 0xf8, 0x34, 0xef, 0x27, 0x0c, 0x95, 0xd9, 0xcc,
+    0x8e, 0xd7, 0x5b, 0xcd, 0x4f, 0x4e, 0x2b, 0xcd, 0x3b, 0x13, 0x09, 0x86, 0xce, 0xfb, 0x68, 0xdb, 0x26, 0xce, 0xa4, 0x9a,
+    0x77, 0x50, 0xab, 0x62, 0xed, 0xc4, 0xf5, 0x7a, 0x7f, 0xd8, 0xa1, 0x3c, 0x06, 0xed, 0x37, 0x82, 0x4e, 0x98, 0x58, 0x7b,
+    0x3d, 0x4a, 0x05, 0x9a, 0x64, 0x67, 0x4d, 0x5f, 0xbd, 0x44, 0xff, 0x78, 0x3b, 0x4f, 0xd3, 0xd3, 0xde, 0x86, 0xe7, 0xc5,
+    0xc2, 0xfc, 0x62, 0x56, 0x05, 0x40, 0x01, 0xf5, 0x0d, 0x7e, 0x6d, 0xd7, 0xa7, 0x0a, 0xaa, 0xf5, 0x12, 0xbc, 0x06, 0xd3,
+    0x2e, 0x16, 0x35, 0x8d, 0xea, 0x61, 0xd9, 0x55, 0x0f, 0xa7, 0x9c, 0xeb, 0x8f, 0x21, 0x68, 0x5a, 0x0a, 0x9e, 0x92, 0x67,
+    0x69, 0x9a, 0xee, 0x04, 0xe1, 0xd4, 0xd2, 0x3d, 0xa0, 0x7e, 0x28, 0xca, 0x2d, 0xc2, 0xcc, 0x26, 0x5e, 0xf2, 0x8c, 0x77,
+    0x04, 0xd7, 0x66, 0xed, 0x64, 0x1b, 0x59, 0x58, 0x0f, 0x0d, 0x1e, 0xd3, 0x61, 0x2f, 0x9a, 0xcb, 0x19, 0x37, 0xbb, 0x61,
+    0x3f, 0xf7, 0x3b, 0xce, 0x68, 0x2a, 0x97, 0xfd, 0x1e, 0x39, 0x01, 0xfd, 0x40, 0x0d, 0xa2, 0xa6, 0x13, 0x1a, 0xf5, 0xda,
+    0xf6, 0x27, 0x3e, 0x6e, 0x81, 0x45, 0x0f, 0x9d, 0x19, 0xe3, 0xd3, 0x99, 0xe9, 0x9f, 0x9c, 0xa1, 0x78, 0x79, 0xcf, 0x54,
+    0x26, 0xe4, 0xb2, 0xb3, 0xea, 0xd3, 0x85, 0x91, 0x3b, 0x26, 0xbf, 0xb0, 0xb1, 0xb3, 0x4a, 0xc3, 0xa6, 0xf3, 0x75, 0x53,
+    0x33, 0x6f, 0x57, 0xe9, 0x9d, 0xa6, 0x47, 0x9a, 0x88, 0xad, 0xc9, 0xe8, 0x0b, 0xaa, 0x4d, 0x27, 0x99, 0x71, 0x91, 0xae,
+    0x9b, 0x12, 0x10, 0x80, 0x75, 0xc2, 0x19, 0xea, 0xb6, 0xde, 0x47, 0x73, 0xd6, 0xc3, 0x9f, 0x8d, 0x4b, 0xa4, 0x0e, 0xa6,
+    0x38, 0x05, 0xb0, 0xaa, 0x0a, 0x34, 0x99, 0x60, 0x0f, 0x83, 0xdf, 0x16, 0xda, 0xf0, 0x6c, 0xd5, 0x71, 0x15, 0xc0, 0xa1,
+    0x75, 0x30, 0xa5, 0x7b, 0xfe, 0xde, 0x0c, 0xbb, 0x65, 0x6a, 0x0e, 0xbb, 0x65, 0x7d, 0x99, 0xc8, 0x74, 0x35, 0x1e, 0xa6,
+    0xfc, 0x9e, 0x24, 0xa0, 0xac, 0x1e, 0x05, 0xd5, 0x16, 0x58, 0x82, 0x8e, 0xf7, 0xab, 0x03, 0xcc, 0xd5, 0xc9, 0xab, 0x20,
+    0x07, 0x84, 0xa7, 0xe5, 0xe7, 0x7b, 0xfc, 0x1a, 0x0f, 0x8b, 0xf1, 0x4d, 0x42, 0xf3, 0x1c, 0x5c, 0x48, 0x20, 0x21, 0x48,
+    0xce, 0x0c, 0x00, 0xf1, 0x4e, 0xc7, 0x71, 0x3c, 0xec, 0x16, 0xb0, 0x3f, 0x08, 0x69, 0x48, 0xca, 0xa5, 0x61, 0xa5, 0x10,
+    0xa8, 0x51, 0xf9, 0x8d, 0xa1, 0x66, 0xa1, 0x83, 0x03, 0x74, 0xdb, 0xec, 0x82, 0x55, 0x9b, 0x41, 0x28, 0x1f, 0xb8, 0x34,
+    0x4f, 0x83, 0xf1, 0xcd, 0xcd, 0xd5, 0xdb, 0x61, 0xd7, 0x4e, 0x8f, 0x87, 0x36, 0x13, 0x48, 0x2d, 0x39, 0x4a, 0xf1, 0x48,
+    0x48, 0xc0, 0x7b, 0x09, 0x9b, 0x49, 0x01, 0x41, 0x19, 0x05, 0xc8, 0x15, 0x40, 0xb1, 0x03, 0x44, 0xe5, 0x62, 0xf5, 0x03,
+    0x9b, 0x56, 0xf9, 0x35, 0xbe, 0x76, 0xa3, 0x83, 0x9b, 0x57, 0x64, 0x56, 0x81, 0xed, 0x57, 0x43, 0x89, 0xeb, 0x4a, 0xd6,
+    0xfe, 0xfe, 0xbb, 0xf1, 0x07, 0x9a, 0x72, 0xaa, 0x49, 0x10, 0x10, 0x99, 0x27, 0x82, 0x27, 0x77, 0x60, 0x25, 0xbd, 0x67,
+    0x5f, 0x21, 0x1a, 0x51, 0x0b, 0x9c, 0x02, 0xe3, 0x61, 0xb7, 0x24, 0xf9, 0x2e, 0xe3, 0x92, 0xe7, 0x90, 0x57, 0x31, 0x14,
+    0x23, 0x5b, 0x2b, 0x63, 0x5b, 0xf1, 0xc3, 0x6e, 0x18, 0x8c, 0xdf, 0x00, 0x3c, 0xb7, 0x62, 0xf6, 0x74, 0xd4, 0xac, 0xa0,
+    0x50, 0x5f, 0xa5, 0x0a, 0x1e, 0x8b, 0x2e, 0x20, 0xea, 0x6c, 0xfc, 0x11, 0x46, 0x00, 0xa3, 0xb3, 0xf1, 0x55, 0x46, 0xcc,
+    0x8c, 0x91, 0xf2, 0x9c, 0x22, 0x5c, 0x13, 0xa0, 0xc1, 0x43, 0x2c, 0x67, 0x89, 0x01, 0xd4, 0xb4, 0x09, 0xcb, 0xf5, 0x42,
+    0x31, 0x4b, 0x94, 0x28, 0x96, 0x02, 0xfc, 0xe0, 0x04, 0xd3, 0x84, 0xc2, 0x1c, 0x54, 0x72, 0x05, 0x64, 0xb1, 0xdb, 0xa8,
+    0xfc, 0xad, 0x13, 0xc5, 0x0b, 0x33, 0x16, 0xcc, 0x40, 0x76, 0x26, 0x77, 0xcc, 0x0c, 0x8e, 0x70, 0xcc, 0xf5, 0x45, 0x29,
+    0x94, 0xa5, 0x64, 0x44, 0x32, 0x10, 0xc1, 0xca, 0x05, 0x90, 0x50, 0x2e, 0xbc, 0x36, 0x90, 0x83, 0x85, 0xd1, 0xb0, 0xdc,
+    0x1b, 0x1c, 0xc1, 0xa4, 0x36, 0x04, 0xaa, 0xc7, 0xe7, 0x03, 0xeb, 0x67, 0x7e, 0xdd, 0x23, 0xfd, 0xc2, 0x87, 0x04, 0x16,
+    0x53, 0x99, 0x2c, 0x30, 0x4b, 0xe2, 0x29, 0x33, 0x97, 0xc2, 0x26, 0xcc, 0x9b, 0xd5, 0x55, 0x1a, 0x6d, 0xd3, 0xa2, 0xe5,
+    0xd9, 0xb7, 0x18, 0x7f, 0x8a, 0xaf, 0x96, 0x09, 0x5b, 0x4e, 0x80, 0xef, 0x95, 0xc5, 0xd6, 0x53, 0x8c, 0x88, 0xf1, 0x8a,
+    0xc5, 0x03, 0xee, 0xbb, 0x6c, 0x15, 0x32, 0x5b, 0xa5, 0x87, 0x7c, 0xd2, 0x02, 0x4f, 0xce, 0x96, 0x50, 0x07, 0x8a, 0xc8,
+    0xad, 0xf0, 0x3c, 0x91, 0x73, 0xcc, 0xed, 0xc6, 0x4a, 0xb6, 0xc8, 0x13, 0x04, 0x8d, 0x0f, 0xe3, 0x57, 0x36, 0xb9, 0xb1,
+    0x91, 0x88, 0x5a, 0x64, 0x6d, 0x95, 0x91, 0x82, 0x01, 0xb4, 0xa6, 0x51, 0xe8, 0x7c, 0x8a, 0x22, 0x8c, 0xf4, 0xf4, 0xa4,
+    0x62, 0x80, 0x32, 0x11, 0x82, 0xc0, 0x32, 0x8e, 0x6e, 0x93, 0xad, 0xb4, 0xdb, 0xa5, 0xee, 0x77, 0xbb, 0xcf, 0xd7, 0x7b,
+    0x58, 0x95, 0xda, 0x60, 0x5b, 0xb4, 0xe9, 0x2e, 0xf5, 0x6d, 0xc5, 0x1e, 0xcb, 0x5c, 0x16, 0x2c, 0xc7, 0xe0, 0x3b, 0xfd,
+    0x22, 0x76, 0x0f, 0x36, 0xef, 0xea, 0x14, 0x54, 0x1b, 0x54, 0x30, 0x04, 0x53, 0x98, 0x36, 0x74, 0x02, 0x15, 0x6e, 0xc6,
+    0xd2, 0x18, 0xfd, 0xd2, 0x84, 0x93, 0x51, 0x0b, 0x40, 0xd3, 0x23, 0x48, 0x12, 0x92, 0xa6, 0x1f, 0x9d, 0x0b, 0x23, 0x0b,
+    0xbc, 0xd6, 0x80, 0x74, 0xbb, 0xe4, 0x75, 0x06, 0xe5, 0xd9, 0xe2, 0xda, 0xd9, 0x07, 0xe0, 0x5f, 0x14, 0x6d, 0xf8, 0x22,
+    0x14, 0x50, 0x99, 0x29, 0xe8, 0xb6, 0x2c, 0x42, 0x60, 0x21, 0x0f, 0x01, 0x8b, 0x5c, 0x6b, 0x96, 0x1e, 0x6d, 0x6a, 0x06,
+    0xcd, 0x99, 0xd6, 0x50, 0x93, 0x0f, 0xda, 0x84, 0xf1, 0x71, 0xeb, 0x83, 0x23, 0xa3, 0x56, 0x30, 0xb5, 0x25, 0xff, 0xeb,
+    0xcd, 0xa7, 0x8f, 0x71, 0x81, 0xfd, 0x64, 0xc9, 0x10, 0xa7, 0xd4, 0x50, 0x30, 0x6b, 0x43, 0xc0, 0x87, 0xc9, 0x8c, 0x44,
+    0x0c, 0x45, 0x28, 0x66, 0x16, 0x2a, 0x87, 0xd9, 0x23, 0x9e, 0x91, 0xe8, 0x27, 0xcf, 0xfe, 0xed, 0x1b, 0xf9, 0xe9, 0xb5,
+    0x52, 0x74, 0x15, 0x73, 0x6d, 0xff, 0x46, 0x6e, 0x25, 0xf6, 0x48, 0x69, 0xb5, 0x88, 0xe3, 0x45, 0x43, 0xdf, 0xcb, 0x29,
+    0xe4, 0x6b, 0x9e, 0x02, 0x02, 0xb9, 0xc2, 0x50, 0x2b, 0x56, 0x08, 0xce, 0x34, 0x81, 0xc3, 0xdb, 0x65, 0x76, 0x69, 0x91,
+    0xdd, 0xc6, 0xcb, 0x62, 0x4a, 0x49, 0x85, 0x5a, 0x6c, 0xe1, 0x1f, 0x63, 0xf9, 0xbe, 0x28, 0x8f, 0x37, 0x30, 0x22, 0xc0,
+    0xa3, 0x05, 0x52, 0x99, 0x0b, 0x96, 0x82, 0xdb, 0x66, 0x72, 0x69, 0x71, 0x04, 0xe2, 0xf0, 0xc4, 0x85, 0x5d, 0xf4, 0x42,
+    0x18, 0x1d, 0x07, 0x83, 0xa3, 0x45, 0x01, 0xf6, 0x31, 0x17, 0x04, 0x4c, 0x41, 0x84, 0x69, 0xd3, 0x3a, 0xbf, 0xad, 0xcc,
+    0x32, 0x8d, 0x58, 0x1b, 0x41, 0xec, 0x5a, 0x8f, 0x00, 0x7c, 0xd7, 0x5c, 0xec, 0xf5, 0x2e, 0x69, 0x32, 0x8b, 0xdc, 0x04,
+    0x19, 0x8d, 0x41, 0x6f, 0xcf, 0x1b, 0x83, 0x3c, 0xbf, 0x12, 0x63, 0x4a, 0xb6, 0x7d, 0x46, 0x81, 0xa8, 0x4a, 0xc4, 0x53,
+    0x44, 0x1b, 0x04, 0x5c, 0x4d, 0x47, 0x38, 0x9f, 0x6c, 0x7c, 0x6a, 0x89, 0xe9, 0x37, 0x1b, 0x3c, 0xe1, 0xae, 0x00, 0x6d,
+    0x3d, 0xe8, 0x8a, 0x3a, 0xa6, 0x12, 0x21, 0x35, 0xfb, 0x6e, 0x96, 0x84, 0xb5, 0x2c, 0x41, 0x86, 0xb4, 0x1f, 0x42, 0xa9,
+    0xb6, 0x50, 0x4a, 0x64, 0xca, 0xfc, 0x18, 0x0e, 0x53, 0x2d, 0xf3, 0xbd, 0x7c, 0x71, 0xe5, 0x17, 0x6d, 0xda, 0x4f, 0x9a,
+    0xe1, 0xc1, 0xaa, 0x5b, 0xe2, 0x71, 0x67, 0xf2, 0xe7, 0x9f, 0x07, 0x0d, 0xad, 0x6e, 0x2b, 0x36, 0xf4, 0x7b, 0x1c, 0x13,
+    0x47, 0x48, 0x9e, 0xaf, 0xf7, 0x78, 0x37, 0xb6, 0x34, 0x30, 0xf3, 0x85, 0xcf, 0x99, 0x5c, 0x98, 0x68, 0xb7, 0x58, 0xb5,
+    0xe1, 0x8e, 0xd2, 0xeb, 0xd9, 0x9c, 0x60, 0xa0, 0x2d, 0x6c, 0xbf, 0x57, 0xec, 0x63, 0x0e, 0x2c, 0x0a, 0x2f, 0x6e, 0xe8,
+    0x5e, 0xe8, 0x75, 0x2e, 0xb6, 0x05, 0x03, 0x9c, 0x62, 0x62, 0x72, 0x2d, 0xc0, 0x01, 0xac, 0xca, 0x66, 0xc4, 0x66, 0x81,
+    0x11, 0xc4, 0xe6, 0xc7, 0x86, 0xa3, 0xee, 0x79, 0x8b, 0xf8, 0x86, 0xe7, 0x7d, 0x0a, 0x78, 0x1b, 0xed, 0x44, 0xdd, 0xf7,
+    0x97, 0x38, 0x61, 0x5d, 0x6f, 0x49, 0x1f, 0xf1, 0xf3, 0x06, 0x77, 0xaa, 0xaa, 0x72, 0xa3, 0x1e, 0x39, 0xcd, 0x70, 0x93,
+    0x8c, 0x41, 0xe6, 0xfb, 0x09, 0xf2, 0x8a, 0x84, 0x5d, 0x5a, 0xf0, 0xae, 0xc7, 0xd8, 0x2b, 0xb7, 0x30, 0x3a, 0x0e, 0x49,
+    0x7f, 0x67, 0x2d, 0x6c, 0x1d, 0xc5, 0x60, 0x5a, 0x0e, 0xcc, 0xba, 0x00, 0x55, 0x19, 0x26, 0x80, 0x1f, 0xc7, 0xbf, 0x01,
+    0x02, 0xa2, 0x96, 0x27, 0xc1, 0x42, 0x53, 0xe6, 0xc7, 0x81, 0x63, 0x05, 0x17, 0xb7, 0x59, 0x35, 0x87, 0x99, 0x5a, 0x46,
+    0xfd, 0x72, 0x30, 0x3d, 0x7e, 0x6d, 0xb5, 0x9e, 0xc0, 0xbc, 0x15, 0xa8, 0x7d, 0x07, 0xfa, 0x8a, 0x04, 0x9f, 0x4b, 0x2b,
+    0x4a, 0x78, 0x04, 0x60, 0x09, 0x66, 0x05, 0xe2, 0xb0, 0xb9, 0xb5, 0x60, 0xf9, 0xd4, 0xcc, 0x6c, 0xa5, 0x6b, 0x88, 0x68,
+    0x91, 0xc3, 0xf9, 0x03, 0xd6, 0xd9, 0xc2, 0x89, 0x21, 0x2b, 0xad, 0xdb, 0x09, 0x99, 0x63, 0x20, 0xd8, 0x24, 0xbb, 0x92,
+    0xe5, 0xc2, 0x06, 0xec, 0xdf, 0x07, 0x56, 0xad, 0xd2, 0x55, 0xa0, 0xc2, 0x9a, 0x4e, 0xa7, 0x40, 0x5f, 0xa1, 0xa9, 0xd5,
+    0x88, 0xf3, 0x01, 0x4d, 0x9d, 0x5e, 0xa6, 0x54, 0x63, 0x44, 0xca, 0x2a, 0x9e, 0x29, 0x39, 0x8f, 0x2a, 0xd3, 0xef, 0xa9,
+    0x58, 0x30, 0x0d, 0x01, 0x8b, 0xe1, 0x3a, 0x63, 0xa2, 0x88, 0xb6, 0xc9, 0xa4, 0x85, 0x36, 0x4d, 0x62, 0x05, 0x9e, 0x27,
+    0x1d, 0x42, 0xed, 0xe0, 0xfb, 0x7a, 0x3b, 0xcf, 0xe2, 0x5e, 0xde, 0xa1, 0x63, 0x2c, 0xaa, 0x70, 0x36, 0xe1, 0xd4, 0xc1,
+    0xa2, 0x09, 0xd7, 0x2d, 0xec, 0x57, 0x9d, 0xd6, 0x51, 0xb3, 0x06, 0xfe, 0x40, 0x26, 0x7e, 0x94, 0xdb, 0xb6, 0x25, 0xc3,
+    0xbb, 0x54, 0x4c, 0x7c, 0xcb, 0xeb, 0x7b, 0xdc, 0x50, 0xb1, 0xdf, 0xc1, 0x52, 0x83, 0xbe, 0x8d, 0x5a, 0x61, 0xe9, 0xe3,
+    0xd7, 0xe8, 0xd0, 0x5a, 0x7b, 0xeb, 0xd3, 0x74, 0xeb, 0xd6, 0x47, 0x34, 0xac, 0x5c, 0x8b, 0xba, 0x5d, 0x41, 0x89, 0xa9,
+    0x77, 0x58, 0xd0, 0xb8, 0x42, 0x28, 0x5c, 0x93, 0x15, 0x05, 0xd0, 0xa7, 0x06, 0xce, 0x7d, 0x48, 0x19, 0xdb, 0xee, 0x18,
+    0xed, 0x89, 0x41, 0x78, 0xd9, 0x27, 0xda, 0x0b, 0x61, 0xad, 0xdd, 0x63, 0x70, 0xbd, 0xe4, 0x66, 0x75, 0x05, 0x9f, 0x36,
+    0x5f, 0xca, 0x4c, 0x60, 0x79, 0xa2, 0x56, 0x85, 0x55, 0x0b, 0x0f, 0xac, 0xe0, 0x13, 0x34, 0x38, 0x01, 0xc2, 0xfc, 0xbf,
+    0xff, 0xf9, 0xf7, 0xbf, 0x2c, 0xba, 0x61, 0xf0, 0xcf, 0xa0, 0x92, 0xc2, 0xa7, 0x39, 0x15, 0x37, 0x46, 0x95, 0xc1, 0x18,
+    0x11, 0xe8, 0xfc, 0x6e, 0x1a, 0x73, 0xd5, 0x11, 0xe4, 0x22, 0x5c, 0xf2, 0x61, 0x33, 0xf5, 0x84, 0x39, 0xda, 0x28, 0x99,
+    0x4f, 0xb7, 0xca, 0xa6, 0x0c, 0x82, 0x22, 0xf4, 0x53, 0x1c, 0x73, 0x2a, 0x04, 0x32, 0xa0, 0xe4, 0x9d, 0x94, 0xad, 0x67,
+    0xf9, 0xe0, 0xc8, 0xc9, 0xda, 0xa1, 0xb9, 0x2d, 0xb5, 0xee, 0x43, 0x5d, 0x6f, 0xda, 0xb4, 0x21, 0xd1, 0xf3, 0x75, 0xdd,
+    0x86, 0x0d, 0x49, 0xdf, 0xcc, 0x5b, 0xe4, 0x1b, 0xb9, 0x98, 0x41, 0x06, 0x33, 0xcb, 0xe2, 0xd7, 0x93, 0x72, 0x6a, 0x03,
+    0xab, 0xdb, 0xc9, 0xad, 0x4b, 0x37, 0xb7, 0xb5, 0x10, 0xd1, 0x02, 0x5c, 0x9b, 0x46, 0xa8, 0x6f, 0x9b, 0xdc, 0xe2, 0xbe,
+    0xb5, 0x88, 0x6c, 0x6e, 0xdb, 0x8f, 0x9a, 0x3a, 0x51, 0x41, 0xab, 0xed, 0x5d, 0xe2, 0xce, 0xf1, 0xba, 0x89, 0x36, 0x70,
+    0x55, 0x37, 0x5f, 0x66, 0x5f, 0xab, 0x02, 0x51, 0x6c, 0xef, 0xe9, 0xf1, 0xf6, 0x49, 0xe0, 0x02, 0x5f, 0x04, 0xc0, 0x03,
+    0xe1, 0x33, 0xf6, 0x22, 0x3b, 0xc9, 0xd2, 0xb0, 0xa6, 0xa3, 0x03, 0x36, 0xac, 0x46, 0xad, 0x32, 0x9b, 0x76, 0xe4, 0xee,
+    0x7b, 0xd7, 0x2b, 0x0d, 0x89, 0xa0, 0x56, 0x37, 0x4c, 0xc0, 0xc1, 0x21, 0xd5, 0x6b, 0x21, 0xa2, 0x70, 0xfb, 0x2c, 0x11,
+    0xb6, 0xaa, 0x54, 0xe5, 0x16, 0xd7, 0xb6, 0xb9, 0x79, 0x52, 0xb9, 0xb0, 0xcc, 0xd7, 0x1f, 0xb1, 0x62, 0x73, 0xa8, 0x9c,
+    0x94, 0x5e, 0xbf, 0xc0, 0xa7, 0x93, 0xc8, 0x0b, 0x6b, 0x16, 0xb9, 0x7d, 0x04, 0x5b, 0xe4, 0xa2, 0x86, 0xd8, 0x5c, 0x60,
+    0xc1, 0x1a, 0x8f, 0x48, 0xe7, 0xac, 0xe7, 0x3b, 0x52, 0x12, 0x5c, 0x3e, 0x24, 0x4c, 0x40, 0x3d, 0x32, 0xae, 0x3e, 0x55,
+    0x44, 0x2f, 0x6b, 0x44, 0x7f, 0x96, 0x32, 0xdd, 0x5d, 0xff, 0x63, 0x6d, 0xfd, 0x1d, 0xb4, 0xb2, 0x81, 0xef, 0x21, 0x49,
+    0x70, 0x2d, 0xa5, 0x0a, 0x1a, 0x8a, 0x35, 0x8a, 0xcb, 0xff, 0x55, 0xb2, 0x9e, 0x7a, 0x28, 0x09, 0x76, 0xae, 0x11, 0x78,
+    0xe1, 0x68, 0x3a, 0x62, 0x7b, 0xd3, 0xaf, 0x2a, 0x51, 0x09, 0xaf, 0x5d, 0x70, 0xed, 0x5e, 0x07, 0x81, 0xa2, 0x71, 0x33,
+    0xf4, 0x54, 0xb6, 0xe5, 0x47, 0x5e, 0x14, 0x48, 0x05, 0x83, 0xb3, 0x20, 0x70, 0x27, 0x8f, 0xb6, 0x40, 0x81, 0x5b, 0x8a,
+    0x47, 0x53, 0xb0, 0xd7, 0x4e, 0x7b, 0x91, 0xbe, 0xf0, 0x0f, 0xc9, 0x79, 0x5d, 0x8e, 0xdf, 0x7b, 0xbe, 0x00, 0x4d, 0x26,
+    0x8c, 0x50, 0x38, 0x92, 0x18, 0x36, 0xed, 0xe7, 0xf6, 0x99, 0x9b, 0x42, 0xff, 0xa2, 0xf4, 0x8e, 0xd8, 0x52, 0x6d, 0x7c,
+    0x83, 0x79, 0x6b, 0x7b, 0x08, 0xdb, 0x35, 0xbc, 0x73, 0x9f, 0xf6, 0xde, 0xe9, 0xc6, 0x3e, 0x59, 0xcb, 0xfb, 0x6f, 0xdb,
+    0x3a, 0xe0, 0xd0, 0x72, 0x75, 0xcf, 0x6d, 0x57, 0x1e, 0x40, 0x32, 0xdb, 0x06, 0x85, 0x5d, 0x74, 0x68, 0x07, 0xa3, 0x06,
+    0xc7, 0x34, 0x5e, 0x9d, 0xcc, 0x4c, 0xa6, 0xd0, 0xf8, 0x5c, 0x7f, 0xba, 0xf9, 0x12, 0xb6, 0x8f, 0xf0, 0xc5, 0xac, 0x5f,
+    0x29, 0x63, 0x1b, 0x80, 0xbd, 0x0e, 0xc8, 0x61, 0xd0, 0xf7, 0x41, 0xf2, 0xae, 0xe6, 0x01, 0xfb, 0xa2, 0x06, 0xdd, 0x27,
+    0x36, 0xaa, 0xda, 0x06, 0x0f, 0x4e, 0xa8, 0xcf, 0x78, 0xcb, 0x54, 0xf6, 0x36, 0x5c, 0xbe, 0x87, 0x60, 0x8f, 0x62, 0xf3,
+    0x68, 0xff, 0x31, 0x06, 0xb3, 0xa7, 0x1b, 0xd6, 0xce, 0x44, 0x27, 0xf8, 0x9d, 0x6d, 0x12, 0xf0, 0x36, 0x8d, 0x42, 0x49,
+    0x63, 0x1f, 0x2b, 0x6c, 0xd3, 0xec, 0x56, 0xe4, 0xe1, 0x7e, 0x65, 0xaf, 0xb1, 0x2c, 0xc5, 0x97, 0xf3, 0x28, 0x1a, 0x95,
+    0x6c, 0x0a, 0x0f, 0xfd, 0x29, 0xbd, 0x2d, 0x2b, 0x70, 0x9c, 0x5d, 0xe2, 0x3d, 0x00, 0x81, 0xcf, 0x00, 0xed, 0x51, 0xf8,
+    0xf6, 0xd3, 0x07, 0x57, 0xc6, 0xdf, 0x03, 0x9e, 0x59, 0x0a, 0x3b, 0x54, 0xed, 0xee, 0xde, 0x1d, 0xe3, 0x1a, 0x6f, 0x9b,
+    0xc2, 0xd2, 0xb5, 0x6b, 0x6f, 0x42, 0x7b, 0xef, 0x03, 0xfb, 0xef, 0x0c, 0x56, 0x93, 0x61, 0xd7, 0xbd, 0x05, 0xc1, 0x79,
+    0x6e, 0x1f, 0x38, 0xbb, 0xf8, 0xbf, 0x2b, 0xe3, 0xff, 0x01, 0x85, 0x3c, 0x07, 0xb8, 0x73, 0x19, 0x00, 0x00,
+};
+static const OTADashAsset wifimanage_html = { "text/html", wifimanage_html_gz, sizeof(wifimanage_html_gz), "\"afd908c171c6aac0\"", "no-cache" };
+
+#endif // WEBPAGES_H
@@ -0,0 +1,289 @@
+# ESP01 Firmware/scripts/build_web_pages.py
+#
+# PlatformIO pre-build step: turns lib/OTA-Dash/web pages/*.html into
+# lib/OTA-Dash/src/WebPages.h. Pages are minified, style rules shared by
+# several pages move to one stylesheet (/portal.css), and everything without
+# a %PLACEHOLDER% is stored gzipped so the portal serves it straight from
+# flash with an ETag. Pages with placeholders become templates: the text with
+# the placeholders cut out plus a table of where each value goes.
+#
+# Also runs on its own: python scripts/build_web_pages.py
+
+import os
+import re
+import gzip
+import hashlib
+
+try:
+    Import("env")
+    PROJECT_DIR = env.subst("$PROJECT_DIR")
+except NameError:
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+PAGES_DIR = os.path.join(PROJECT_DIR, "lib", "OTA-Dash", "web pages")
+HEADER = os.path.join(PROJECT_DIR, "lib", "OTA-Dash", "src", "WebPages.h")
+
+PLACEHOLDER = re.compile(r"%[A-Z_]+%")
+SHARED_CSS_PATH = "/portal.css"
+SHARED_JS_PATH = "/portal.js"
+PAGE_CACHE = "no-cache"                                 # Revalidated on every load, answered with 304 while unchanged
+ASSET_CACHE = "public, max-age=31536000, immutable"     # Linked with ?v=<etag>, a new build gets a new URL
+
+# Whitespace next to these tags never renders
+BLOCK_TAGS = {
+    "html", "head", "body", "title", "meta", "link", "style", "script", "div", "form", "h1", "h2", "h3",
+    "h4", "h5", "h6", "p", "br", "ul", "ol", "li", "table", "thead", "tbody", "tr", "td", "th", "input",
+    "button", "select", "option", "label", "!doctype",
+}
+
+LICENSE = """/*
+ ====================================================================================================
+ * File:        WebPages.h
+ * Author:      Hamas Saeed
+ * Version:     Rev_1.1.0
+ * Date:        Feb 10 2025
+ * Brief:       Generated From "web pages/*.html" By scripts/build_web_pages.py, Do Not Edit
+ *
+ ====================================================================================================
+ * License:
+ * MIT License
+ *
+ * Copyright (c) 2025 Hamas Saeed
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * For any inquiries, contact Hamas Saeed at hamasaeed@gmail.com
+ *
+ ====================================================================================================
+ */
+"""
+
+
+def minify_css(css):
+    css = re.sub(r"/\*.*?\*/", "", css, flags=re.S)
+    css = re.sub(r"\s+", " ", css)
+    css = re.sub(r"\s*([{};,>])\s*", r"\1", css)
+    css = re.sub(r":\s+", ":", css)                     # Never before ':', "a :hover" differs from "a:hover"
+    return css.replace(";}", "}").strip()
+
+
+def minify_js(js):
+    # Line based: keeps every newline, so automatic semicolon insertion is unaffected
+    lines = (line.strip() for line in js.splitlines())
+    return "\n".join(line for line in lines if line and not line.startswith("//"))
+
+
+def tag_name(tag):
+    match = re.match(r"<\s*/?\s*([!\w]+)", tag)
+    return match.group(1).lower() if match else ""
+
+
+def minify_markup(html):
+    html = re.sub(r"<!--.*?-->", "", html, flags=re.S)
+    parts = re.split(r"(<[^>]+>)", html)
+    out = []
+    for i, part in enumerate(parts):
+        if part.startswith("<"):
+            out.append(re.sub(r"\s+", " ", part))
+            continue
+        before = tag_name(parts[i - 1]) if i > 0 else "html"
+        after = tag_name(parts[i + 1]) if i + 1 < len(parts) else "html"
+        text = re.sub(r"\s+", " ", part)
+        if before in BLOCK_TAGS:
+            text = text.lstrip()
+        if after in BLOCK_TAGS:
+            text = text.rstrip()
+        out.append(text)
+    return "".join(out)
+
+
+def css_rules(css):
+    css = re.sub(r"/\*.*?\*/", "", css, flags=re.S)
+    return [(minify_css(selector), minify_css(body).rstrip(";")) for selector, body in re.findall(r"([^{}]+)\{([^{}]*)\}", css)]
+
+
+class Page:
+    def __init__(self, path):
+        self.name = os.path.splitext(os.path.basename(path))[0]
+        with open(path, encoding="utf-8") as f:
+            self.source = f.read()
+        self.rules = []
+        for block in re.findall(r"<style>(.*?)</style>", self.source, flags=re.S):
+            self.rules += css_rules(block)
+        self.scripts = [minify_js(block) for block in re.findall(r"<script>(.*?)</script>", self.source, flags=re.S)]
+
+    def build(self, shared_rules, shared_scripts, css_url, js_url):
+        # Shared rules load first from the stylesheet; only rules whose selector is unique in the page move,
+        # so the page's own rules still come after anything they used to follow
+        selectors = [selector for selector, _ in self.rules]
+        local = "".join(f"{selector}{{{body}}}" for selector, body in self.rules
+                        if (selector, body) not in shared_rules or selectors.count(selector) > 1)
+        head = f'<link rel="stylesheet" href="{css_url}">' if css_url else ""
+        if local:
+            head += f"<style>{local}</style>"
+
+        html = self.source
+        html = re.sub(r"\s*<style>.*?</style>", "", html, count=0, flags=re.S)
+        html = html.replace("</head>", head + "</head>", 1)
+
+        body_scripts = []
+        for script in self.scripts:
+            body_scripts.append(f'<script src="{js_url}"></script>' if script in shared_scripts else f"<script>{script}</script>")
+        blocks = iter(body_scripts)
+        html = re.sub(r"<script>.*?</script>", "<script></script>", html, flags=re.S)
+        html = minify_markup(html)
+        return re.sub(r"<script></script>", lambda _: next(blocks), html)
+
+
+def shared(items_per_page):
+    counts = {}
+    for items in items_per_page:
+        for item in set(items):
+            counts[item] = counts.get(item, 0) + 1
+    return {item for item, count in counts.items() if count > 1}
+
+
+def etag(data):
+    return '"' + hashlib.sha256(data).hexdigest()[:16] + '"'
+
+
+def compress(text):
+    return gzip.compress(text.encode("utf-8"), compresslevel=9, mtime=0)
+
+
+def c_bytes(data):
+    rows = []
+    for i in range(0, len(data), 20):
+        rows.append("    " + ", ".join(f"0x{b:02x}" for b in data[i:i + 20]) + ",")
+    return "\n".join(rows)
+
+
+def emit_asset(name, mime, data, cache, comment):
+    return (
+        f"// {comment}\n"
+        f"static const uint8_t {name}_gz[] PROGMEM = {{\n{c_bytes(data)}\n}};\n"
+        f'static const OTADashAsset {name} = {{ "{mime}", {name}_gz, sizeof({name}_gz), "{etag(data).replace(chr(34), chr(92) + chr(34))}", "{cache}" }};\n'
+    )
+
+
+def field_name(placeholder):
+    return "OTA_DASH_FIELD_" + placeholder.strip("%")
+
+
+def emit_template(name, html, fields, comment):
+    text = bytearray()
+    slots = []
+    position = 0
+    for match in PLACEHOLDER.finditer(html):
+        text += html[position:match.start()].encode("utf-8")
+        slots.append(f"{{ {len(text)}, {field_name(match.group())} }}")
+        position = match.end()
+    text += html[position:].encode("utf-8")
+    assert len(text) < 0x10000, f"{name} is too large for 16 bit slot offsets"
+    return (
+        f"// {comment}, template\n"
+        f'static const char {name}_text[] PROGMEM = R"rawliteral({text.decode("utf-8")})rawliteral";\n'
+        f"static const OTADashSlot {name}_slots[] PROGMEM = {{ {', '.join(slots)} }};\n"
+        f"static const OTADashTemplate {name} = {{ {name}_text, sizeof({name}_text) - 1, {name}_slots, {len(slots)} }};\n"
+    )
+
+
+def main():
+    pages = [Page(os.path.join(PAGES_DIR, f)) for f in sorted(os.listdir(PAGES_DIR)) if f.endswith(".html")]
+
+    # A rule is shared when it appears verbatim in several pages and its selector is unique in each of them
+    unique = []
+    for page in pages:
+        selectors = [selector for selector, _ in page.rules]
+        unique.append([rule for rule in page.rules if selectors.count(rule[0]) == 1])
+    shared_rules = shared(unique)
+    shared_scripts = shared(page.scripts for page in pages)
+
+    body = []
+    css_url = js_url = None
+    if shared_rules:
+        ordered = [rule for rule in unique[0] if rule in shared_rules]
+        for rules in unique[1:]:
+            ordered += [rule for rule in rules if rule in shared_rules and rule not in ordered]
+        css = compress("".join(f"{selector}{{{style}}}" for selector, style in ordered))
+        css_url = f"{SHARED_CSS_PATH}?v={etag(css).strip(chr(34))}"
+        body.append(emit_asset("portal_css", "text/css", css, ASSET_CACHE, "Style rules shared by the pages"))
+    if shared_scripts:
+        js = compress("\n".join(sorted(shared_scripts)))
+        js_url = f"{SHARED_JS_PATH}?v={etag(js).strip(chr(34))}"
+        body.append(emit_asset("portal_js", "application/javascript", js, ASSET_CACHE, "Scripts shared by the pages"))
+
+    fields = sorted({field for page in pages for field in PLACEHOLDER.findall(page.source)})
+
+    summary = []
+    for page in pages:
+        html = page.build(shared_rules, shared_scripts, css_url, js_url)
+        name = f"{page.name}_html"
+        if PLACEHOLDER.search(html):
+            body.append(emit_template(name, html, fields, f"{page.name}.html"))
+            summary.append(f"{page.name} {len(page.source)} -> {len(html)}")
+        else:
+            data = compress(html)
+            body.append(emit_asset(name, "text/html", data, PAGE_CACHE, f"{page.name}.html"))
+            summary.append(f"{page.name} {len(page.source)} -> {len(data)} gz")
+
+    header = (
+        LICENSE
+        + "\n#ifndef WEBPAGES_H\n#define WEBPAGES_H\n\n#include <Arduino.h>\n\n"
+        + "struct OTADashAsset {\n"
+        + "    const char*     type;\n"
+        + "    const uint8_t*  data;                                                                                   // gzip, in flash\n"
+        + "    size_t          length;\n"
+        + "    const char*     etag;\n"
+        + "    const char*     cacheControl;\n"
+        + "};\n\n"
+        + "enum OTADashField : uint8_t {\n"
+        + "".join(f"    {field_name(field)},\n" for field in fields)
+        + "    OTA_DASH_FIELD_COUNT\n"
+        + "};\n\n"
+        + "struct OTADashSlot {\n"
+        + "    uint16_t            offset;                                                                             // Into the text, placeholders cut out\n"
+        + "    uint8_t             field;\n"
+        + "};\n\n"
+        + "struct OTADashTemplate {\n"
+        + "    const char*         text;                                                                               // In flash\n"
+        + "    size_t              length;\n"
+        + "    const OTADashSlot*  slots;                                                                              // In flash, ascending offsets\n"
+        + "    uint8_t             slotCount;\n"
+        + "};\n\n"
+        + (f'#define OTA_DASH_PORTAL_CSS                 "{SHARED_CSS_PATH}"\n' if css_url else "")
+        + (f'#define OTA_DASH_PORTAL_JS                  "{SHARED_JS_PATH}"\n' if js_url else "")
+        + "\n"
+        + "\n".join(body)
+        + "\n#endif // WEBPAGES_H\n"
+    )
+
+    # Unchanged output keeps its timestamp, so the library is not rebuilt every time
+    try:
+        with open(HEADER, encoding="utf-8") as f:
+            if f.read() == header:
+                return
+    except FileNotFoundError:
+        pass
+    with open(HEADER, "w", encoding="utf-8") as f:
+        f.write(header)
+    print("Web pages: " + ", ".join(summary))
+
+
+main()
@@ -0,0 +1,28 @@
+# ESP01 Firmware/scripts/compress_firmware.py
+#
+# PlatformIO post-build step: writes firmware.bin.gz next to firmware.bin.
+# Upload the .gz through the OTA portal (/update). ESP8266 stores it as is and
+# eboot expands it while installing, ESP32 inflates it on the fly.
+
+Import("env")
+
+import os
+import gzip
+import shutil
+
+
+def compress_firmware(source, target, env):
+    firmware = target[0].get_abspath()
+    compressed = firmware + ".gz"
+
+    # No file name or timestamp in the header: identical builds give identical archives
+    with open(firmware, "rb") as src, open(compressed, "wb") as raw:
+        with gzip.GzipFile(filename="", mode="wb", fileobj=raw, compresslevel=9, mtime=0) as dst:
+            shutil.copyfileobj(src, dst)
+
+    original = os.path.getsize(firmware)
+    packed = os.path.getsize(compressed)
+    print(f"Compressed firmware: {compressed} ({packed} of {original} bytes, {100 * packed // original}%)")
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.bin", compress_firmware)
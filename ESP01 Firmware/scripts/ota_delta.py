@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+"""
+Delta firmware updates for the OTA portal (/update)
+Builds a patch that turns one firmware build into another. The device applies
+it against its running image while streaming the result into the update
+partition (see lib/OTA-Dash/src/OTAPatch.h for the format).
+
+    python scripts/ota_delta.py make old/firmware.bin .pio/build/esp12e/firmware.bin update.patch
+    python scripts/ota_delta.py apply old/firmware.bin update.patch rebuilt.bin
+
+"old" must be the exact image the devices run. Every patch is applied back on
+the host and checked before it is written. --gzip shrinks it further, but
+only ESP32 devices inflate uploads: ESP8266's bootloader would install the
+compressed patch as an image, so --gzip needs --target esp32.
+
+    python scripts/ota_delta.py make --target esp32 --gzip old.bin new.bin update.patch.gz
+"""
+
+import sys
+import gzip
+import struct
+import hashlib
+import argparse
+
+MAGIC = b"ODP1"
+HEADER = struct.Struct("<4sII2sH32s32s")
+
+OP_END = 0x00
+OP_COPY = 0x01
+OP_ADD = 0x02
+OP_INSERT = 0x03
+OP_SEEK = 0x04
+
+SEED = 8                # Bytes hashed to find match candidates
+MAX_CANDIDATES = 16     # Source positions kept per seed
+MIN_MATCH = 16          # Shorter matches are sent as literals
+MIN_COPY_RUN = 6        # Unchanged bytes inside a match worth a COPY of their own
+GIVE_UP = 32            # Net mismatches past the best point before a match ends
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def zigzag(value):
+    return (value << 1) ^ (value >> 31) if value < 0 else value << 1
+
+
+class PatchWriter:
+    def __init__(self):
+        self.body = bytearray()
+
+    def op(self, opcode, length, data=b""):
+        self.body.append(opcode)
+        self.body += varint(length)
+        self.body += data
+
+    def copy(self, length):
+        self.op(OP_COPY, length)
+
+    def add(self, diff):
+        self.op(OP_ADD, len(diff), diff)
+
+    def insert(self, data):
+        self.op(OP_INSERT, len(data), data)
+
+    def seek(self, delta):
+        self.op(OP_SEEK, zigzag(delta))
+
+    def end(self):
+        self.body.append(OP_END)
+
+
+def build_index(old):
+    index = {}
+    for i in range(len(old) - SEED + 1):
+        key = old[i:i + SEED]
+        positions = index.get(key)
+        if positions is None:
+            index[key] = [i]
+        elif len(positions) < MAX_CANDIDATES:
+            positions.append(i)
+    return index
+
+
+def extend(old, new, o, n):
+    """Length of the best approximate match at old[o:], new[n:] (bsdiff style, more than half equal)"""
+    limit = min(len(old) - o, len(new) - n)
+    matches = length = best_score = best_len = 0
+    while length < limit:
+        if old[o + length:o + length + 64] == new[n + length:n + length + 64] and length + 64 <= limit:
+            matches += 64
+            length += 64
+        else:
+            matches += old[o + length] == new[n + length]
+            length += 1
+        score = 2 * matches - length
+        if score > best_score:
+            best_score, best_len = score, length
+        elif score < best_score - GIVE_UP:
+            break
+    return best_len
+
+
+def encode_match(writer, old, new, o, n, length):
+    """Unchanged runs become COPY, everything else ADD (byte-wise difference to the source)"""
+    diff = bytes((new[n + i] - old[o + i]) & 0xFF for i in range(length))
+    start = i = 0
+    while i < length:
+        if diff[i]:
+            i += 1
+            continue
+        run = i
+        while run < length and not diff[run]:
+            run += 1
+        if run - i >= MIN_COPY_RUN:
+            if i > start:
+                writer.add(diff[start:i])
+            writer.copy(run - i)
+            start = run
+        i = run
+    if start < length:
+        writer.add(diff[start:])
+
+
+def make_patch(old, new):
+    writer = PatchWriter()
+    index = build_index(old)
+    position = 0                # Source cursor on the device
+    offset = 0                  # Alignment of the last match, tried first
+    literal = i = 0
+
+    while i <= len(new) - SEED:
+        candidates = set(index.get(new[i:i + SEED], ()))
+        if 0 <= i + offset < len(old):
+            candidates.add(i + offset)
+
+        best_len, best_o = 0, 0
+        for o in candidates:
+            length = extend(old, new, o, i)
+            if length > best_len:
+                best_len, best_o = length, o
+
+        if best_len < MIN_MATCH:
+            i += 1
+            continue
+
+        if i > literal:
+            writer.insert(new[literal:i])
+        if best_o != position:
+            writer.seek(best_o - position)
+        encode_match(writer, old, new, best_o, i, best_len)
+        position = best_o + best_len
+        offset = best_o - i
+        i += best_len
+        literal = i
+
+    if literal < len(new):
+        writer.insert(new[literal:])
+    writer.end()
+
+    header = HEADER.pack(MAGIC, len(old), len(new), old[2:4], 0,
+                         hashlib.sha256(old).digest(), hashlib.sha256(new).digest())
+    return header + bytes(writer.body)
+
+
+def read_varint(data, pos):
+    value = shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+def apply_patch(old, patch):
+    """Reference implementation of the device side, used to check every patch"""
+    magic, source_size, target_size, _, _, source_sha, target_sha = HEADER.unpack_from(patch)
+    if magic != MAGIC:
+        raise ValueError("not a delta patch")
+    if source_size != len(old) or hashlib.sha256(old).digest() != source_sha:
+        raise ValueError("patch was made for a different firmware")
+
+    out = bytearray()
+    pos = HEADER.size
+    source = 0
+    while True:
+        opcode = patch[pos]
+        pos += 1
+        if opcode == OP_END:
+            break
+        length, pos = read_varint(patch, pos)
+        if opcode == OP_COPY:
+            out += old[source:source + length]
+            source += length
+        elif opcode == OP_ADD:
+            out += bytes((old[source + k] + patch[pos + k]) & 0xFF for k in range(length))
+            source += length
+            pos += length
+        elif opcode == OP_INSERT:
+            out += patch[pos:pos + length]
+            pos += length
+        elif opcode == OP_SEEK:
+            source += (length >> 1) ^ -(length & 1)
+        else:
+            raise ValueError(f"bad opcode {opcode:#x}")
+
+    if len(out) != target_size or hashlib.sha256(out).digest() != target_sha:
+        raise ValueError("patched firmware does not match its checksum")
+    return bytes(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Make or apply delta firmware patches")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    make = commands.add_parser("make", help="Create a patch from OLD to NEW")
+    make.add_argument("old")
+    make.add_argument("new")
+    make.add_argument("patch")
+    make.add_argument("--gzip", action="store_true", help="Compress the patch (needs --target esp32)")
+    make.add_argument("--target", choices=("esp8266", "esp32"), default="esp8266", help="Device family the patch is for")
+
+    apply = commands.add_parser("apply", help="Apply PATCH to OLD and write the result")
+    apply.add_argument("old")
+    apply.add_argument("patch")
+    apply.add_argument("out")
+
+    args = parser.parse_args()
+    if args.command == "make" and args.gzip and args.target != "esp32":
+        parser.error("--gzip only works on ESP32 (--target esp32); ESP8266 needs the plain patch")
+
+    with open(args.old, "rb") as f:
+        old = f.read()
+
+    if args.command == "make":
+        with open(args.new, "rb") as f:
+            new = f.read()
+        patch = make_patch(old, new)
+        if apply_patch(old, patch) != new:
+            sys.exit("Patch self-check failed")
+        if args.gzip:
+            patch = gzip.compress(patch, compresslevel=9, mtime=0)
+        with open(args.patch, "wb") as f:
+            f.write(patch)
+        print(f"Patch: {args.patch} ({len(patch)} bytes, firmware {len(new)} bytes, {len(new) / len(patch):.1f}x smaller)")
+    else:
+        with open(args.patch, "rb") as f:
+            patch = f.read()
+        if patch[:2] == b"\x1f\x8b":
+            patch = gzip.decompress(patch)
+        with open(args.out, "wb") as f:
+            f.write(apply_patch(old, patch))
+        print(f"Wrote {args.out}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""
+Signed firmware updates (portal and MQTT)
+Appends an ECDSA P-256 signature to an image, a .gz image or a delta patch.
+The device checks it while the upload streams in and refuses to install an
+image that is unsigned or signed with another key (see
+lib/OTA-Dash/src/OTAVerifier.h for the trailer format).
+
+    python scripts/ota_sign.py keygen
+    python scripts/ota_sign.py sign .pio/build/esp12e/firmware.bin.gz firmware.signed.gz
+
+keygen writes the private key (keep it out of the repository) and
+include/OTASigningKey.h with the public key. Firmware built with that header
+only accepts signed updates, so sign the first image flashed with it too.
+Needs the openssl command line tool.
+"""
+
+import os
+import sys
+import hashlib
+import argparse
+import subprocess
+import tempfile
+
+MAGIC = b"ODS1"
+COORD = 32              # P-256 coordinate and scalar size
+DEFAULT_KEY = "ota_signing.pem"
+DEFAULT_HEADER = os.path.join("include", "OTASigningKey.h")
+
+
+def openssl(*args, data=None):
+    try:
+        return subprocess.run(["openssl", *args], input=data, capture_output=True, check=True).stdout
+    except FileNotFoundError:
+        sys.exit("openssl not found")
+    except subprocess.CalledProcessError as e:
+        sys.exit(f"openssl {args[0]} failed: {e.stderr.decode().strip()}")
+
+
+def public_point(key):
+    """Uncompressed public key (0x04, X, Y), the last 65 bytes of the DER SubjectPublicKeyInfo"""
+    der = openssl("ec", "-in", key, "-pubout", "-outform", "DER")
+    point = der[-(2 * COORD + 1):]
+    if point[0] != 0x04:
+        sys.exit(f"{key} is not a P-256 key")
+    return point
+
+
+def der_length(data, pos):
+    length = data[pos]
+    pos += 1
+    if length & 0x80:
+        count = length & 0x7F
+        length = int.from_bytes(data[pos:pos + count], "big")
+        pos += count
+    return length, pos
+
+
+def der_to_raw(der):
+    """ECDSA-Sig-Value (SEQUENCE of two INTEGERs) to r || s"""
+    _, pos = der_length(der, 1)
+    raw = b""
+    for _ in range(2):
+        length, pos = der_length(der, pos + 1)
+        raw += der[pos:pos + length].lstrip(b"\0").rjust(COORD, b"\0")
+        pos += length
+    return raw
+
+
+def raw_to_der(raw):
+    ints = b""
+    for value in (raw[:COORD], raw[COORD:]):
+        value = value.lstrip(b"\0") or b"\0"
+        if value[0] & 0x80:
+            value = b"\0" + value
+        ints += bytes([0x02, len(value)]) + value
+    return bytes([0x30, len(ints)]) + ints
+
+
+def verify(key, payload, signature):
+    with tempfile.TemporaryDirectory() as tmp:
+        pub = os.path.join(tmp, "pub.pem")
+        sig = os.path.join(tmp, "sig.der")
+        with open(pub, "wb") as f:
+            f.write(openssl("ec", "-in", key, "-pubout"))
+        with open(sig, "wb") as f:
+            f.write(raw_to_der(signature))
+        try:
+            subprocess.run(["openssl", "dgst", "-sha256", "-verify", pub, "-signature", sig],
+                           input=payload, capture_output=True, check=True)
+            return True
+        except subprocess.CalledProcessError:
+            return False
+
+
+def keygen(args):
+    if os.path.exists(args.key):
+        sys.exit(f"{args.key} exists, not overwriting a signing key")
+    with open(args.key, "wb") as f:
+        f.write(openssl("ecparam", "-name", "prime256v1", "-genkey", "-noout"))
+    os.chmod(args.key, 0o600)
+
+    point = public_point(args.key)
+    rows = ",\n".join("    " + ", ".join(f"0x{b:02X}" for b in point[i:i + 13]) for i in range(0, len(point), 13))
+    with open(args.header, "w") as f:
+        f.write("// Generated by scripts/ota_sign.py keygen, the public half of " + os.path.basename(args.key) + "\n")
+        f.write("#ifndef OTA_SIGNING_KEY_H\n#define OTA_SIGNING_KEY_H\n\n#include <OTAVerifier.h>\n\n")
+        f.write(f"static const uint8_t OTA_SIGNING_KEY[OTA_SIGNATURE_KEY_SIZE] PROGMEM = {{\n{rows}\n}};\n\n")
+        f.write("#endif // OTA_SIGNING_KEY_H\n")
+    print(f"Private key: {args.key} (keep it secret), public key: {args.header}")
+
+
+def sign(args):
+    with open(args.image, "rb") as f:
+        payload = f.read()
+    if payload[-len(MAGIC):] == MAGIC:
+        sys.exit(f"{args.image} is signed already")
+
+    signature = der_to_raw(openssl("dgst", "-sha256", "-sign", args.key, data=payload))
+    if not verify(args.key, payload, signature):
+        sys.exit("Signature self-check failed")
+    with open(args.out, "wb") as f:
+        f.write(payload + signature + MAGIC)
+    print(f"Signed: {args.out} ({len(payload)} bytes, sha256 {hashlib.sha256(payload).hexdigest()[:16]}...)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Sign firmware updates")
+    parser.add_argument("--key", default=DEFAULT_KEY, help=f"Private key (default {DEFAULT_KEY})")
+    commands = parser.add_subparsers(dest="command", required=True)
+
+    gen = commands.add_parser("keygen", help="Create a signing key and the firmware header")
+    gen.add_argument("--header", default=DEFAULT_HEADER)
+
+    sig = commands.add_parser("sign", help="Append a signature to IMAGE")
+    sig.add_argument("image")
+    sig.add_argument("out")
+
+    args = parser.parse_args()
+    if args.command == "keygen":
+        keygen(args)
+    else:
+        sign(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,148 @@
+/**
+ * @file CommandAdmission.cpp
+ * @brief Downlink rate limiting and last-writer-wins coalescing of relay commands
+ * @author Your Name
+ * @date October 2025
+ */
+
+#include "CommandAdmission.h"
+
+TokenBucket::TokenBucket(uint16_t capacity, uint32_t refillMs)
+    : capacity(capacity)
+    , tokens(capacity)
+    , refillMs(refillMs)
+    , lastRefill(0)
+{
+}
+
+bool TokenBucket::take(uint32_t now) {
+    refill(now);
+    if (!tokens) return false;
+    tokens--;
+    return true;
+}
+
+uint32_t TokenBucket::wait(uint32_t now) {
+    refill(now);
+    if (tokens) return 0;
+    return refillMs - (now - lastRefill);
+}
+
+void TokenBucket::refill(uint32_t now) {
+    if (tokens >= capacity) {
+        lastRefill = now; // A full bucket does not bank time
+        return;
+    }
+
+    uint32_t earned = (now - lastRefill) / refillMs;
+    if (!earned) return;
+
+    if (earned >= (uint32_t)(capacity - tokens)) {
+        tokens = capacity;
+        lastRefill = now;
+    } else {
+        tokens += earned;
+        lastRefill += earned * refillMs;
+    }
+}
+
+CommandAdmission::CommandAdmission(TimerWheel& wheel)
+    : hasTarget(false)
+    , target(false)
+    , dropped(0)
+    , wheel(wheel)
+    , messages(ADMISSION_MSG_BURST, ADMISSION_MSG_REFILL_MS)
+    , actuations(ADMISSION_ACT_BURST, ADMISSION_ACT_REFILL_MS)
+    , current(nullptr)
+    , onApply(nullptr)
+    , onReport(nullptr)
+{
+}
+
+void CommandAdmission::begin(StateReader current, ApplyHandler onApply, ReportHandler onReport) {
+    this->current = current;
+    this->onApply = onApply;
+    this->onReport = onReport;
+
+    windowTimer.setCallback([this]() { closeWindow(); });
+    reportTimer.setCallback([this]() {
+        uint32_t count = dropped;
+        dropped = 0;
+        if (count && this->onReport) {
+            this->onReport(count);
+        }
+    });
+}
+
+bool CommandAdmission::acceptMessage() {
+    if (messages.take(millis())) {
+        return true;
+    }
+
+    // Summarise drops once per report period instead of acking each one
+    if (!dropped++) {
+        wheel.schedule(reportTimer, ADMISSION_REPORT_MS);
+    }
+    return false;
+}
+
+CommandAdmission::Verdict CommandAdmission::admitState(bool state, bool current) {
+    // Inside an open window the newest request replaces the pending one
+    if (windowTimer.isActive()) {
+        target = state;
+        hasTarget = true;
+        return ADMIT_COALESCED;
+    }
+
+    if (state == current) {
+        return ADMIT_APPLY; // Nothing to actuate, no budget spent
+    }
+
+    if (actuations.take(millis())) {
+        wheel.schedule(windowTimer, ADMISSION_COALESCE_MS);                 // Follow-ups inside the window merge
+        return ADMIT_APPLY;
+    }
+
+    return ADMIT_THROTTLED;
+}
+
+bool CommandAdmission::admitPulse() {
+    if (windowTimer.isActive() && hasTarget) {
+        return false; // A coalesced state change is still due
+    }
+    return actuations.take(millis());
+}
+
+uint32_t CommandAdmission::pendingMs() const {
+    if (!windowTimer.isActive()) return 0;
+    return windowTimer.expiresAt() - wheel.now();
+}
+
+uint32_t CommandAdmission::budgetMs() {
+    return actuations.wait(millis());
+}
+
+void CommandAdmission::closeWindow() {
+    if (!hasTarget) return;
+
+    // The burst ended where it started, settle it like an unchanged request
+    if (current && target == current()) {
+        hasTarget = false;
+        if (onApply) {
+            onApply(target);
+        }
+        return;
+    }
+
+    uint32_t now = millis();
+    if (!actuations.take(now)) {
+        wheel.schedule(windowTimer, actuations.wait(now));
+        return;
+    }
+
+    hasTarget = false;
+    wheel.schedule(windowTimer, ADMISSION_COALESCE_MS);                     // Keep merging while the stream lasts
+    if (onApply) {
+        onApply(target);
+    }
+}
@@ -0,0 +1,135 @@
+/**
+ * @file ConnectionManager.cpp
+ * @brief Event-driven station link with MQTT recovery on reconnect
+ * @author Your Name
+ * @date October 2025
+ */
+
+#include "ConnectionManager.h"
+#include "LoopWake.h"
+
+ConnectionManager::ConnectionManager()
+    : up(false)
+    , changed(false)
+    , retryMs(WIFI_RETRY_MIN_MS)
+    , logger("ConnectionManager", CHRONOLOG_LEVEL_DEBUG)
+    , timers(nullptr)
+    , onLink(nullptr)
+    #ifndef ESP8266
+    , eventId(0)
+    #endif
+{
+    retryTimer.setCallback([this]() { retry(); });
+}
+
+ConnectionManager::~ConnectionManager() {
+    #ifndef ESP8266
+        WiFi.removeEvent(eventId);
+    #endif
+}
+
+bool ConnectionManager::begin(const char* ssid, const char* password, uint32_t timeoutMs) {
+    this->ssid = ssid;
+    this->password = password;
+
+    if (!hasSsid()) {
+        logger.error("SSID is empty, WiFi stays idle until credentials are saved");
+        return false;
+    }
+
+    // Events may arrive outside the loop, they are only noted here and wake it
+    #ifdef ESP8266
+        gotIpHandler = WiFi.onStationModeGotIP([this](const WiFiEventStationModeGotIP&) {
+            changed = true;
+            LoopWake::notify();
+        });
+        disconnectedHandler = WiFi.onStationModeDisconnected([this](const WiFiEventStationModeDisconnected&) {
+            changed = true;
+            LoopWake::notify();
+        });
+    #else
+        eventId = WiFi.onEvent([this](WiFiEvent_t event, WiFiEventInfo_t info) {
+            if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP || event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+                changed = true;
+                LoopWake::notify();
+            }
+        });
+    #endif
+
+    logger.info("Connecting to WiFi SSID: %s", ssid);
+    WiFi.setAutoReconnect(true);
+    WiFi.begin(ssid, password);
+
+    uint32_t startTime = millis();
+    while (WiFi.status() != WL_CONNECTED && millis() - startTime < timeoutMs) {
+        delay(500);
+        logger.info("Attempting to connect...");
+    }
+
+    changed = false;
+    up = WiFi.status() == WL_CONNECTED;
+    if (!up) {
+        logger.error("Failed to connect to WiFi after %lu ms", (unsigned long)timeoutMs);
+        return false;
+    }
+
+    logger.info("Connected to WiFi! IP address: %s", WiFi.localIP().toString().c_str());
+
+    // The radio dozes between beacons while loop() sleeps. Light sleep would hold commands until the next DTIM.
+    #ifdef ESP8266
+        WiFi.setSleepMode(WIFI_MODEM_SLEEP);
+    #else
+        WiFi.setSleep(true);
+    #endif
+    return true;
+}
+
+void ConnectionManager::attach(TimerWheel& timers, LinkHandler handler) {
+    this->timers = &timers;
+    onLink = handler;
+
+    // Without an SSID there is nothing to rejoin, the portal saves credentials and restarts
+    if (!up && hasSsid()) {
+        timers.schedule(retryTimer, retryMs);
+    }
+    if (onLink) {
+        onLink(up);
+    }
+}
+
+void ConnectionManager::loop() {
+    if (!changed) return;
+
+    // Cleared before reading the status, an event arriving now is seen next pass
+    changed = false;
+    bool linked = WiFi.status() == WL_CONNECTED;
+    if (linked == up) return;
+    up = linked;
+
+    if (up) {
+        logger.info("WiFi link up, IP address: %s", WiFi.localIP().toString().c_str());
+        retryTimer.cancel();
+        retryMs = WIFI_RETRY_MIN_MS;
+    } else {
+        logger.warn("WiFi link lost, waiting for the access point");
+        if (timers) {
+            timers->schedule(retryTimer, retryMs);
+        }
+    }
+
+    if (onLink) {
+        onLink(up);
+    }
+}
+
+void ConnectionManager::retry() {
+    if (!hasSsid()) return;
+    if (WiFi.status() == WL_CONNECTED) return; // The got-IP event is on its way
+
+    // WiFi.disconnect() would clear the stored station config on ESP8266, begin() restarts the join
+    logger.info("Rejoining WiFi SSID: %s", ssid.c_str());
+    WiFi.begin(ssid.c_str(), password.c_str());
+
+    retryMs = std::min<uint32_t>(retryMs * 2, WIFI_RETRY_MAX_MS);
+    timers->schedule(retryTimer, retryMs);
+}
@@ -0,0 +1,48 @@
+/**
+ * @file LoopWake.cpp
+ * @brief Blocking loop() idle with event wake-ups
+ * @author Your Name
+ * @date October 2025
+ */
+
+#include "LoopWake.h"
+
+#ifdef ESP8266
+    #include <coredecls.h>
+#else
+    #include <freertos/FreeRTOS.h>
+    #include <freertos/task.h>
+
+    static TaskHandle_t loopTask = nullptr;
+#endif
+
+void LoopWake::begin() {
+    #ifndef ESP8266
+        loopTask = xTaskGetCurrentTaskHandle();
+    #endif
+}
+
+void LoopWake::notify() {
+    #ifdef ESP8266
+        esp_schedule();                                         // Resumes the suspended loop continuation
+    #else
+        if (loopTask) {
+            xTaskNotifyGive(loopTask);
+        }
+    #endif
+}
+
+void LoopWake::sleep(uint32_t ms, Condition wake) {
+    if (!ms || wake()) return;
+
+    #ifdef ESP8266
+        // Suspends the loop continuation; notify() resumes it, wake() is re-checked every interval
+        esp_delay(ms, [&wake]() { return !wake(); }, LOOP_WAKE_POLL_MS);
+    #else
+        uint32_t start = millis();
+        for (uint32_t elapsed = 0; elapsed < ms && !wake(); elapsed = millis() - start) {
+            TickType_t ticks = pdMS_TO_TICKS(min(ms - elapsed, (uint32_t)LOOP_WAKE_POLL_MS));
+            ulTaskNotifyTake(pdTRUE, ticks ? ticks : 1);        // A notification ends the wait at once
+        }
+    #endif
+}
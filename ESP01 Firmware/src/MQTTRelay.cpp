@@ -12,46 +12,119 @@
     #include <WiFiClientSecureBearSSL.h>
 #else
     #include <WiFi.h>
+    #include <esp_system.h>
 #endif
 
-// Static instance pointer for callback
-MQTTRelay* MQTTRelay::instance = nullptr;
+std::vector<MQTTRelay*> MQTTRelay::instances;
+
+static const char* const RELAY_CAPABILITIES[] = { "pulse", "timing", "schedule", "groups", "admission", "shadow" };
 
 MQTTRelay::MQTTRelay(uint8_t relayPin, const char* deviceUUID, const char* deviceName)
-    : relayPin(relayPin)
-    , relayState(false)
+    : relayState(false)
+    , ownsSession(true)
+    , ackSuppressed(false)
+    , pendingState(false)
+    , desiredState(false)
+    , pendingPersist(false)
+    , revertState(false)
+    , revertPersist(false)
+    , savedState(false)
+    , stateDirty(false)
+    , stateChanged(false)
+    , ownsOutput(true)
+    , outputChannel(0)
     , deviceUUID(deviceUUID)
     , deviceName(deviceName)
-    , mqttClient(nullptr)
-    , lastReconnectAttempt(0)
-    , lastHeartbeat(0)
-    , reconnectAttempts(0)
-    , autoReconnect(true)
+    , activeGroup(nullptr)
+    , admissionOutcome(nullptr)
     , logger("MQTTRelay", CHRONOLOG_LEVEL_DEBUG)
+    , session(new MQTTSession(deviceUUID))
+    , output(new GpioRelayOutput(relayPin))
+    , commandStart(0)
+    , lastChange(0)
+    , pendingPulseMs(0)
+    , appliedVersion(0)
+    , savedVersion(0)
+    , desiredVersion(0)
+    , supersededVersion(0)
+    , timers(this->session->getTimers())
+    , schedule(timers)
+    , admission(timers)
+    , firmwareUpdate(nullptr)
 {
-    // Set static instance for callback
-    instance = this;
-    
-    // Initialize topics
-    uplinkTopic = String(UPLINK_TOPIC_PREFIX) + this->deviceUUID;
-    downlinkTopic = String(DOWNLINK_TOPIC_PREFIX) + this->deviceUUID;
-    statusTopic = String(STATUS_TOPIC_PREFIX) + this->deviceUUID;
-    
-    // Initialize configuration with defaults
-    strncpy(config.brokerHost, MQTT_BROKER_HOST, sizeof(config.brokerHost) - 1);
-    config.brokerPort = MQTT_BROKER_PORT;
-    strncpy(config.deviceUUID, deviceUUID, sizeof(config.deviceUUID) - 1);
-    strncpy(config.deviceName, deviceName, sizeof(config.deviceName) - 1);
-    config.useSSL = true;
-    config.initialized = false;
+    stateSlot = session->allocateSlot();
+    initTopics();
+}
+
+MQTTRelay::MQTTRelay(MQTTSession& session, uint8_t relayPin, const char* deviceUUID, const char* deviceName)
+    : MQTTRelay(session, *new GpioRelayOutput(relayPin), 0, deviceUUID, deviceName)
+{
+    ownsOutput = true;
+}
+
+MQTTRelay::MQTTRelay(MQTTSession& session, RelayOutput& output, uint8_t channel, const char* deviceUUID, const char* deviceName)
+    : relayState(false)
+    , ownsSession(false)
+    , ackSuppressed(false)
+    , pendingState(false)
+    , desiredState(false)
+    , pendingPersist(false)
+    , revertState(false)
+    , revertPersist(false)
+    , savedState(false)
+    , stateDirty(false)
+    , stateChanged(false)
+    , ownsOutput(false)
+    , outputChannel(channel)
+    , deviceUUID(deviceUUID)
+    , deviceName(deviceName)
+    , activeGroup(nullptr)
+    , admissionOutcome(nullptr)
+    , logger("MQTTRelay", CHRONOLOG_LEVEL_DEBUG)
+    , session(&session)
+    , output(&output)
+    , commandStart(0)
+    , lastChange(0)
+    , pendingPulseMs(0)
+    , appliedVersion(0)
+    , savedVersion(0)
+    , desiredVersion(0)
+    , supersededVersion(0)
+    , timers(this->session->getTimers())
+    , schedule(timers)
+    , admission(timers)
+    , firmwareUpdate(nullptr)
+{
+    stateSlot = session.allocateSlot();
+    initTopics();
 }
 
 MQTTRelay::~MQTTRelay() {
-    if (mqttClient) {
-        mqttClient->disconnect();
-        delete mqttClient;
+    flush();
+    for (size_t i = 0; i < instances.size(); i++) {
+        if (instances[i] == this) {
+            instances.erase(instances.begin() + i);
+            break;
+        }
+    }
+    delete firmwareUpdate;
+    session->detach(this);
+    if (ownsSession) {
+        delete session;
+    }
+    if (ownsOutput) {
+        delete output;
     }
-    instance = nullptr;
+}
+
+void MQTTRelay::initTopics() {
+    uplinkTopic = String(UPLINK_TOPIC_PREFIX) + deviceUUID;
+    downlinkTopic = String(DOWNLINK_TOPIC_PREFIX) + deviceUUID;
+    statusTopic = String(STATUS_TOPIC_PREFIX) + deviceUUID;
+    desiredTopic = String(DESIRED_TOPIC_PREFIX) + deviceUUID;
+    
+    memset(&timing, 0, sizeof(timing));
+    instances.push_back(this);
 }
 
 bool MQTTRelay::begin() {
@@ -59,29 +132,103 @@ bool MQTTRelay::begin() {
     logger.info("Device UUID: %s", deviceUUID.c_str());
     logger.info("Device Name: %s", deviceName.c_str());
     
-    // Setup relay pin
-    pinMode(relayPin, OUTPUT);
-    
-    // Load configuration and state
-    loadConfig();
+    // Load relay state and timing rules
     loadRelayState();
+    loadTiming();
+    
+    // Timed transitions run on the session's wheel, independent of the network
+    pendingTimer.setCallback([this]() {
+        requestState(pendingState, pendingPersist, pendingPulseMs);
+        settleDesired();
+        sendAck("timer", true, relayState ? "on" : "off");
+    });
+    revertTimer.setCallback([this]() {
+        requestState(revertState, revertPersist, 0);
+        settleDesired();
+        sendAck("timer", true, relayState ? "on" : "off");
+    });
+    persistTimer.setCallback([this]() { flush(); });
+    desiredTimer.setCallback([this]() { reconcileDesired(); });
+    heartbeatTimer.setCallback([this]() {
+        sendHeartbeat();                                                    // Skipped while offline
+        timers.schedule(heartbeatTimer, HEARTBEAT_INTERVAL);
+    });
+    timers.schedule(heartbeatTimer, HEARTBEAT_INTERVAL);
+    
+    // Flood protection, coalesced targets are applied when their window closes
+    admission.begin([this]() {
+        return relayState;
+    }, [this](bool state) {
+        setRelayState(state);
+        settleDesired(); // A desired state merged into this window, claimed only if it won
+        sendAck("admission", true, relayState ? "on" : "off");
+    }, [this](uint32_t dropped) {
+        logger.warn("Dropped %lu downlink message(s), rate limit exceeded", (unsigned long)dropped);
+        sendThrottled(dropped);
+    });
+    
+    #ifndef ESP8266
+        static bool shutdownHooked = false;
+        if (!shutdownHooked) {
+            esp_register_shutdown_handler(flushAll); // Covers every ESP.restart() caller
+            shutdownHooked = true;
+        }
+    #endif
     
     // Apply loaded relay state
-    digitalWrite(relayPin, relayState ? LOW : HIGH);
+    if (relayState) {
+        releaseInterlock();
+    }
+    output->write(outputChannel, relayState);
+    if (!output->begin()) {
+        logger.error("Relay output driver not responding");
+        return false;
+    }
+    lastChange = millis();
+    if (relayState && timing.autoOffMs) {
+        revertState = false;
+        revertPersist = true;
+        timers.schedule(revertTimer, timing.autoOffMs);
+    }
     logger.info("Relay initialized to state: %s", relayState ? "ON" : "OFF");
     
-    // Setup MQTT client
-    if (config.useSSL) {
-        setupSSL();
-        mqttClient = new PubSubClient(wifiClientSecure);
-    } else {
-        mqttClient = new PubSubClient(wifiClient);
+    // Standalone controllers bring up their own session
+    if (ownsSession && !session->begin()) {
+        logger.error("Failed to initialize MQTT session");
+        return false;
     }
     
-    // Configure MQTT client
-    mqttClient->setServer(config.brokerHost, config.brokerPort);
-    mqttClient->setCallback(mqttCallback);
-    mqttClient->setKeepAlive(MQTT_KEEPALIVE);
+    // Register downlink route and refresh the retained state on every (re)connect
+    session->subscribe(downlinkTopic.c_str(), [this](const char* topic, byte* payload, unsigned int length) {
+        handleMessage(topic, payload, length);
+    }, this);
+    // The broker replays the retained desired state on every subscribe, so reconnects reconcile
+    session->subscribe(desiredTopic.c_str(), [this](const char* topic, byte* payload, unsigned int length) {
+        handleDesired(topic, payload, length);
+    }, this);
+    session->onConnect([this]() {
+        publishedState = ""; // Broker may hold our will instead
+        sendStatus("online");
+    }, this);
+    // Relays switched by one publish (a group command, say) share one bus write
+    session->onDispatch([](bool done) {
+        done ? RelayOutput::endBatch() : RelayOutput::beginBatch();
+    }, this);
+    
+    // The device has one firmware image, the first controller of the session owns its updates
+    if (stateSlot == 0) {
+        firmwareUpdate = new MQTTUpdate(*session, timers);
+        firmwareUpdate->begin(deviceUUID, prepareRestart);
+    }
+    
+    // Join the group topics this controller was configured with
+    loadGroups();
+    
+    // Local automation, rule actions are reported like normal acks
+    schedule.begin(stateSlot, [this](uint8_t rule, bool state) {
+        setRelayState(state);
+        sendAck("schedule", true, relayState ? "on" : "off");
+    });
     
     // Setup Last Will and Testament
     setupLastWill();
@@ -91,103 +238,175 @@ bool MQTTRelay::begin() {
 }
 
 void MQTTRelay::loop() {
-    if (!mqttClient) return;
-    
-    // Handle MQTT client loop
-    mqttClient->loop();
-    
-    // Handle reconnection if needed
-    if (!mqttClient->connected() && autoReconnect) {
-        handleReconnection();
+    // The session also runs due timers (schedules, pulses, heartbeat)
+    if (ownsSession) {
+        session->loop();
     }
     
-    // Send periodic heartbeat
-    unsigned long now = millis();
-    if (mqttClient->connected() && (now - lastHeartbeat > HEARTBEAT_INTERVAL)) {
-        sendHeartbeat();
-        lastHeartbeat = now;
+    // Republish the retained state off the command path, once per change
+    if (stateChanged && session->isConnected()) {
+        stateChanged = false;
+        sendStatus("online");
     }
 }
 
 bool MQTTRelay::connect() {
-    if (!mqttClient) {
-        logger.error("MQTT client not initialized");
+    return session->connect();
+}
+
+void MQTTRelay::disconnect() {
+    if (session->isConnected()) {
+        sendStatus("offline");
+        if (ownsSession) {
+            session->disconnect();
+        }
+    }
+}
+
+bool MQTTRelay::isConnected() {
+    return session->isConnected();
+}
+
+bool MQTTRelay::setRelayState(bool state, bool saveToEEPROM) {
+    return requestState(state, saveToEEPROM, 0);
+}
+
+bool MQTTRelay::pulse(bool state, uint32_t durationMs) {
+    if (!durationMs || durationMs > RELAY_MAX_PULSE_MS) {
+        logger.error("Invalid pulse duration: %lu ms", (unsigned long)durationMs);
         return false;
     }
     
-    if (mqttClient->connected()) {
+    // Momentary switching is not persisted, a reboot restores the resting state
+    return requestState(state, false, durationMs);
+}
+
+bool MQTTRelay::requestState(bool state, bool persist, uint32_t pulseMs) {
+    pendingTimer.cancel(); // Newest request replaces a deferred one
+    
+    uint32_t wait = dwellRemaining(state);
+    if (state) {
+        wait = max(wait, interlockRemaining());
+    }
+    
+    if (wait) {
+        pendingState = state;
+        pendingPersist = persist;
+        pendingPulseMs = pulseMs;
+        timers.schedule(pendingTimer, wait);
+        logger.info("Relay %s deferred by %lu ms", state ? "ON" : "OFF", (unsigned long)wait);
         return true;
     }
     
-    logger.info("Connecting to MQTT broker: %s:%d", config.brokerHost, config.brokerPort);
+    applyState(state, persist, pulseMs);
+    return true;
+}
+
+void MQTTRelay::applyState(bool state, bool persist, uint32_t pulseMs) {
+    // Break before make: interlocked peers are off before this one closes
+    if (state) {
+        releaseInterlock();
+    }
+    
+    revertTimer.cancel();
+    
+    if (relayState != state) {
+        // Actuate first, everything else is bookkeeping
+        relayState = state;
+        lastChange = millis();
+        output->write(outputChannel, relayState);
+        stateChanged = true;
+        logger.info("Relay state changed to: %s", relayState ? "ON" : "OFF");
+    }
     
-    // Generate client ID
-    String clientId = "ESP32-" + deviceUUID + "-" + String(random(0xffff), HEX);
+    // The flash commit is off the ack path, bursts collapse into one write
+    if (persist && savedState != state) {
+        savedState = state;
+        schedulePersist();
+    }
     
-    // Attempt connection
-    bool connected = mqttClient->connect(clientId.c_str());
+    // Arm the way back: pulse end, or auto-off for any turn-on
+    if (pulseMs) {
+        revertState = !state;
+        revertPersist = false;
+        timers.schedule(revertTimer, pulseMs);
+    } else if (state && timing.autoOffMs) {
+        revertState = false;
+        revertPersist = true;
+        timers.schedule(revertTimer, timing.autoOffMs);
+    }
+}
+
+void MQTTRelay::releaseInterlock() {
+    if (!timing.interlock) return;
     
-    if (connected) {
-        logger.info("Connected to MQTT broker with client ID: %s", clientId.c_str());
+    for (MQTTRelay* peer : instances) {
+        if (peer == this || peer->timing.interlock != timing.interlock) continue;
         
-        // Subscribe to downlink topic
-        if (mqttClient->subscribe(downlinkTopic.c_str(), MQTT_QOS)) {
-            logger.info("Subscribed to topic: %s", downlinkTopic.c_str());
-        } else {
-            logger.error("Failed to subscribe to topic: %s", downlinkTopic.c_str());
+        if (peer->pendingTimer.isActive() && peer->pendingState) {
+            peer->pendingTimer.cancel(); // Older request loses
+        }
+        if (peer->relayState) {
+            peer->applyState(false, true, 0);
+            peer->output->commit(); // Never merged into the same bus write as our turn-on
+            peer->sendAck("interlock", true, "off");
         }
-        
-        // Send hello message and online status
-        sendHello();
-        sendStatus("online");
-        
-        // Reset reconnect attempts
-        reconnectAttempts = 0;
-        
-    } else {
-        logger.error("Failed to connect to MQTT broker. Error: %d", mqttClient->state());
-        reconnectAttempts++;
     }
-    
-    return connected;
 }
 
-void MQTTRelay::disconnect() {
-    if (mqttClient && mqttClient->connected()) {
-        sendStatus("offline");
-        mqttClient->disconnect();
-        logger.info("Disconnected from MQTT broker");
+void MQTTRelay::schedulePersist() {
+    stateDirty = true;
+    if (!persistTimer.isActive()) {
+        timers.schedule(persistTimer, RELAY_PERSIST_DELAY);
     }
 }
 
-bool MQTTRelay::isConnected() {
-    return mqttClient && mqttClient->connected();
+void MQTTRelay::flush() {
+    persistTimer.cancel();
+    if (!stateDirty) return;
+    
+    stateDirty = false;
+    saveRelayState();
 }
 
-bool MQTTRelay::setRelayState(bool state, bool saveToEEPROM) {
-    if (relayState == state) {
-        return true; // No change needed
+void MQTTRelay::flushAll() {
+    for (MQTTRelay* relay : instances) {
+        relay->flush();
     }
+}
+
+void MQTTRelay::prepareRestart() {
+    flushAll();
+    for (MQTTRelay* relay : instances) {
+        relay->disconnect();                    // Retained offline status
+    }
+    for (MQTTRelay* relay : instances) {
+        relay->session->disconnect();           // Shared sessions too, a clean DISCONNECT holds the will back
+    }
+}
+
+uint32_t MQTTRelay::dwellRemaining(bool state) const {
+    if (state == relayState) return 0;
     
-    logger.info("Changing relay state from %s to %s", 
-                relayState ? "ON" : "OFF", 
-                state ? "ON" : "OFF");
-    
-    // Change relay state
-    relayState = state;
-    digitalWrite(relayPin, relayState ? LOW : HIGH);
+    uint32_t dwell = relayState ? timing.minOnMs : timing.minOffMs;
+    uint32_t elapsed = millis() - lastChange;
+    return elapsed < dwell ? dwell - elapsed : 0;
+}
+
+uint32_t MQTTRelay::interlockRemaining() const {
+    uint32_t wait = 0;
+    if (!timing.interlock) return wait;
     
-    // Save to EEPROM if requested
-    if (saveToEEPROM) {
-        saveRelayState();
+    // A peer still inside its minimum on time holds this one off
+    for (const MQTTRelay* peer : instances) {
+        if (peer == this || peer->timing.interlock != timing.interlock) continue;
+        wait = max(wait, peer->dwellRemaining(false));
     }
-    
-    logger.info("Relay state changed to: %s", relayState ? "ON" : "OFF");
-    return true;
+    return wait;
 }
 
 void MQTTRelay::sendHeartbeat() {
-    if (!mqttClient || !mqttClient->connected()) return;
+    if (!session->isConnected()) return;
     
     JsonDocument doc;
     doc["device_uuid"] = deviceUUID;
@@ -199,7 +418,7 @@ void MQTTRelay::sendHeartbeat() {
     String payload;
     serializeJson(doc, payload);
     
-    if (mqttClient->publish(uplinkTopic.c_str(), payload.c_str(), false)) {
+    if (session->publish(uplinkTopic.c_str(), payload.c_str(), false)) {
         logger.debug("Heartbeat sent - State: %s", relayState ? "ON" : "OFF");
     } else {
         logger.error("Failed to send heartbeat");
@@ -207,17 +426,44 @@ void MQTTRelay::sendHeartbeat() {
 }
 
 void MQTTRelay::sendStatus(const char* status, bool retained) {
-    if (!mqttClient || !mqttClient->connected()) return;
+    if (!session->isConnected()) return;
     
+    // Single retained document: late subscribers read identity and state from the broker
     JsonDocument doc;
     doc["device_uuid"] = deviceUUID;
     doc["status"] = status;
-    doc["timestamp"] = getCurrentTimestamp();
+    doc["session"] = session->getClientName();
+    if (strcmp(status, "offline") != 0) {
+        doc["device_name"] = deviceName;
+        doc["state"] = relayState ? "on" : "off";
+        doc["version"] = appliedVersion;
+        if (supersededVersion > appliedVersion) {
+            doc["superseded"] = supersededVersion;
+        }
+        doc["firmware"] = FIRMWARE_VERSION;
+        
+        JsonArray capabilities = doc["capabilities"].to<JsonArray>();
+        for (const char* capability : RELAY_CAPABILITIES) {
+            capabilities.add(capability);
+        }
+        if (firmwareUpdate) {
+            capabilities.add("ota");
+        }
+        JsonArray list = doc["groups"].to<JsonArray>();
+        for (const auto& group : groups) {
+            list.add(group);
+        }
+    }
     
     String payload;
     serializeJson(doc, payload);
     
-    if (mqttClient->publish(statusTopic.c_str(), payload.c_str(), retained)) {
+    if (payload == publishedState) {
+        return; // Unchanged, the broker already holds it
+    }
+    
+    if (session->publish(statusTopic.c_str(), payload.c_str(), retained)) {
+        publishedState = payload;
         logger.info("Status sent: %s", status);
     } else {
         logger.error("Failed to send status: %s", status);
@@ -225,64 +471,154 @@ void MQTTRelay::sendStatus(const char* status, bool retained) {
 }
 
 void MQTTRelay::setBrokerConfig(const char* host, int port, bool useSSL) {
-    strncpy(config.brokerHost, host, sizeof(config.brokerHost) - 1);
-    config.brokerPort = port;
-    config.useSSL = useSSL;
-    saveConfig();
+    session->setBrokerConfig(host, port, useSSL);
 }
 
-void MQTTRelay::setupSSL() {
-#ifdef ESP8266
-    // ESP8266 WiFiClientSecure API
-    wifiClientSecure.setTrustAnchors(new BearSSL::X509List(rootCACertificate));
+void MQTTRelay::handleMessage(const char* topic, byte* payload, unsigned int length) {
+    unsigned long received = micros();
     
-    // Optional: Set client certificate and key if provided
-    if (strlen(clientCertificate) > 0 && strlen(clientPrivateKey) > 0) {
-        wifiClientSecure.setClientRSACert(new BearSSL::X509List(clientCertificate), 
-                                         new BearSSL::PrivateKey(clientPrivateKey));
-    }
+    // Rate limit before any parsing work
+    if (!admission.acceptMessage()) return;
     
-    // For testing purposes - remove in production
-    wifiClientSecure.setInsecure();
+    // Copying parse straight from the client buffer, the ack publish reuses it
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, (const byte*)payload, length);
     
-    logger.info("ESP8266 SSL/TLS certificates configured");
-#else
-    // ESP32 WiFiClientSecure API
-    wifiClientSecure.setCACert(rootCACertificate);
-    wifiClientSecure.setCertificate(clientCertificate);
-    wifiClientSecure.setPrivateKey(clientPrivateKey);
-    wifiClientSecure.setInsecure(); // For testing - remove in production
+    if (error) {
+        logger.error("Failed to parse JSON message: %s", error.c_str());
+        return;
+    }
     
-    logger.info("ESP32 SSL/TLS certificates configured");
-#endif
+    logger.debug("Received command on topic %s", topic);
+    
+    // Process command
+    commandStart = received;
+    processCommand(doc);
+    commandStart = 0;
 }
 
-void MQTTRelay::mqttCallback(char* topic, byte* payload, unsigned int length) {
-    if (instance) {
-        instance->handleMessage(topic, payload, length);
+void MQTTRelay::handleGroupMessage(const char* topic, byte* payload, unsigned int length) {
+    unsigned long received = micros();
+    
+    if (!admission.acceptMessage()) return;
+    
+    // Copying parse: payload and topic live in the client buffer, which the ack publish reuses
+    JsonDocument doc;
+    DeserializationError error = deserializeJson(doc, (const byte*)payload, length);
+    
+    if (error) {
+        logger.error("Failed to parse group message: %s", error.c_str());
+        return;
     }
-}
-
-void MQTTRelay::handleMessage(char* topic, byte* payload, unsigned int length) {
-    // Convert payload to string
-    String message;
-    for (unsigned int i = 0; i < length; i++) {
-        message += (char)payload[i];
+    
+    const char* cmd = doc["command"];
+    if (cmd && strcmp(cmd, "set_groups") == 0) {
+        logger.warn("Ignoring set_groups received on group topic %s", topic);
+        return; // Membership is only changed through the device downlink
     }
     
-    logger.debug("Received message on topic %s: %s", topic, message.c_str());
+    logger.debug("Received group command on topic %s", topic);
+    
+    // Same command semantics as the downlink, only the ack policy differs
+    String group = topic + strlen(GROUP_TOPIC_PREFIX);
+    activeGroup = group.c_str();
+    ackSuppressed = !isAckSampled(doc);
+    commandStart = received;
+    processCommand(doc);
+    ackSuppressed = false;
+    activeGroup = nullptr;
+    commandStart = 0;
+}
+
+void MQTTRelay::handleDesired(const char* topic, byte* payload, unsigned int length) {
+    if (!length) return; // Retained shadow cleared
     
-    // Parse JSON
+    // Not rate limited: the broker sends one retained document per subscribe,
+    // dropping it would leave the shadow unreconciled until the next change
     JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, message);
+    DeserializationError error = deserializeJson(doc, (const byte*)payload, length);
     
     if (error) {
-        logger.error("Failed to parse JSON message: %s", error.c_str());
+        logger.error("Failed to parse desired state: %s", error.c_str());
         return;
     }
     
-    // Process command
-    processCommand(doc);
+    uint32_t version = doc["version"] | 0;
+    const char* state = doc["state"];
+    if (!version || !state || (strcmp(state, "on") != 0 && strcmp(state, "off") != 0)) {
+        logger.error("Invalid desired state on topic %s", topic);
+        return;
+    }
+    
+    // Replays and stale versions are no-ops, local actions since then are not undone
+    if (version <= appliedVersion || version <= desiredVersion || version <= supersededVersion) {
+        logger.debug("Desired version %lu already applied", (unsigned long)version);
+        return;
+    }
+    
+    desiredState = strcmp(state, "on") == 0;
+    desiredVersion = version;
+    desiredTimer.cancel();
+    reconcileDesired();
+}
+
+void MQTTRelay::reconcileDesired() {
+    if (!desiredVersion) return;
+    
+    // The version only advances once the relay has switched, or the window it joined has closed
+    CommandAdmission::Verdict verdict = admission.admitState(desiredState, relayState);
+    if (verdict == CommandAdmission::ADMIT_APPLY) {
+        setRelayState(desiredState);
+        settleDesired();
+    } else if (verdict == CommandAdmission::ADMIT_THROTTLED) {
+        uint32_t wait = max(admission.budgetMs(), (uint32_t)1);
+        timers.schedule(desiredTimer, wait);
+        logger.info("Desired version %lu waits %lu ms for actuation budget", (unsigned long)desiredVersion, (unsigned long)wait);
+    }
+}
+
+void MQTTRelay::settleDesired() {
+    // Still waiting for budget, a coalescing window or a dwell deferral of its own state
+    if (!desiredVersion || desiredTimer.isActive() || admission.hasPending()) return;
+    if (pendingTimer.isActive() && pendingState == desiredState) return;
+    
+    // Only a relay that ended in the desired state reports its version, the server sees anything else as superseded
+    if (relayState == desiredState && !pendingTimer.isActive()) {
+        appliedVersion = desiredVersion;
+        schedulePersist(); // Persisted with the relay state
+        logger.info("Desired state %s applied at version %lu", desiredState ? "on" : "off", (unsigned long)appliedVersion);
+    } else {
+        supersededVersion = desiredVersion;
+        logger.info("Desired version %lu superseded by a later command", (unsigned long)supersededVersion);
+    }
+    desiredVersion = 0;
+    stateChanged = true;
+}
+
+bool MQTTRelay::isAckSampled(JsonDocument& command) {
+    JsonVariant ack = command["ack"];
+    int percent = GROUP_ACK_SAMPLE_PERCENT;
+    
+    if (ack.is<const char*>()) {
+        const char* policy = ack;
+        if (strcmp(policy, "all") == 0) return true;
+        if (strcmp(policy, "none") == 0) return false;
+    } else if (ack.is<int>()) {
+        percent = ack;
+    }
+    
+    if (percent >= 100) return true;
+    if (percent <= 0) return false;
+    
+    // Deterministic per device and command sequence so the server can scale
+    // the sampled count back up, while different commands pick different members
+    uint32_t hash = 2166136261u;
+    for (unsigned int i = 0; i < deviceUUID.length(); i++) {
+        hash = (hash ^ (uint8_t)deviceUUID[i]) * 16777619u;
+    }
+    hash = (hash ^ command["seq"].as<uint32_t>()) * 16777619u;
+    
+    return (hash % 100) < (uint32_t)percent;
 }
 
 void MQTTRelay::processCommand(JsonDocument& command) {
@@ -318,17 +654,55 @@ void MQTTRelay::processCommand(JsonDocument& command) {
             return;
         }
         
-        // Set relay state
-        if (setRelayState(newState)) {
+        // Bursts collapse to the last request; dwell and interlock rules may defer it further
+        CommandAdmission::Verdict verdict = admission.admitState(newState, relayState);
+        if (verdict != CommandAdmission::ADMIT_THROTTLED) {
+            desiredTimer.cancel(); // Newer than a throttled desired state, which must not undo it
+        }
+        if (verdict == CommandAdmission::ADMIT_COALESCED) {
+            admissionOutcome = "coalesced";
+            sendAck(cmd, true, state);
+            admissionOutcome = nullptr;
+        } else if (verdict == CommandAdmission::ADMIT_THROTTLED) {
+            admissionOutcome = "throttled";
+            sendAck(cmd, false);
+            admissionOutcome = nullptr;
+        } else if (setRelayState(newState)) {
+            settleDesired();
             sendAck(cmd, true, state);
         } else {
             sendAck(cmd, false);
         }
         
+    } else if (strcmp(cmd, "pulse") == 0) {
+        startPulse(command);
+        
+    } else if (strcmp(cmd, "set_timing") == 0) {
+        setTiming(command);
+        
+    } else if (strcmp(cmd, "get_timing") == 0) {
+        sendTiming();
+        
     } else if (strcmp(cmd, "get_state") == 0) {
         const char* currentState = relayState ? "on" : "off";
         sendAck(cmd, true, currentState);
         
+    } else if (strcmp(cmd, "set_groups") == 0) {
+        setGroups(command);
+        
+    } else if (strcmp(cmd, "set_schedule") == 0) {
+        setSchedule(command);
+        
+    } else if (strcmp(cmd, "get_schedule") == 0) {
+        sendSchedule();
+        
+    } else if (strcmp(cmd, "clear_schedule") == 0) {
+        schedule.clear();
+        sendAck(cmd, true);
+        
+    } else if (firmwareUpdate && !activeGroup && strncmp(cmd, "ota_", 4) == 0 && firmwareUpdate->handleCommand(cmd, command)) {
+        // Firmware transfer control, acked by the updater itself
+        
     } else {
         logger.warn("Unknown command: %s", cmd);
         sendAck(cmd, false);
@@ -336,7 +710,10 @@ void MQTTRelay::processCommand(JsonDocument& command) {
 }
 
 void MQTTRelay::sendAck(const char* command, bool success, const char* state) {
-    if (!mqttClient || !mqttClient->connected()) return;
+    if (!session->isConnected() || ackSuppressed) return;
+    
+    // An ack must not overtake the switch it reports, even inside a batch
+    output->commit();
     
     JsonDocument doc;
     doc["device_uuid"] = deviceUUID;
@@ -346,90 +723,339 @@ void MQTTRelay::sendAck(const char* command, bool success, const char* state) {
     if (state) {
         doc["state"] = state;
     }
+    if (pendingTimer.isActive()) {
+        doc["pending"] = pendingState ? "on" : "off";
+        doc["pending_ms"] = pendingTimer.expiresAt() - timers.now();
+    }
+    if (admissionOutcome) {
+        doc["admission"] = admissionOutcome;
+        if (admission.hasPending()) {
+            doc["admission_ms"] = admission.pendingMs();
+        }
+    }
+    if (activeGroup) {
+        doc["group"] = activeGroup;
+    }
+    if (commandStart) {
+        doc["proc_us"] = micros() - commandStart; // Receive to ack, excluding the network
+    }
     doc["timestamp"] = getCurrentTimestamp();
     
     String payload;
     serializeJson(doc, payload);
     
-    if (mqttClient->publish(uplinkTopic.c_str(), payload.c_str(), false)) {
+    if (session->publish(uplinkTopic.c_str(), payload.c_str(), false)) {
         logger.debug("ACK sent for command: %s, success: %s", command, success ? "true" : "false");
     } else {
         logger.error("Failed to send ACK for command: %s", command);
     }
 }
 
-void MQTTRelay::sendHello() {
-    if (!mqttClient || !mqttClient->connected()) return;
+bool MQTTRelay::loadRelayState() {
+    if (stateSlot >= MQTT_MAX_SLOTS) return false;
+    
+    EEPROM.begin(MQTT_EEPROM_SIZE);
+    // Relay states are stored after the config structure, one slot per controller
+    EEPROM.get(MQTT_EEPROM_ADDR + sizeof(MQTTConfig) + stateSlot, relayState);
+    EEPROM.get(MQTT_VERSION_EEPROM_ADDR + stateSlot * MQTT_VERSION_EEPROM_LEN, appliedVersion);
+    EEPROM.end();
+    savedState = relayState;
+    if (appliedVersion == 0xFFFFFFFF) {
+        appliedVersion = 0; // Erased flash
+    }
+    savedVersion = appliedVersion;
+    
+    logger.info("Relay state loaded from EEPROM: %s", relayState ? "ON" : "OFF");
+    return true;
+}
+
+bool MQTTRelay::saveRelayState() {
+    if (stateSlot >= MQTT_MAX_SLOTS) return false;
+    
+    EEPROM.begin(MQTT_EEPROM_SIZE);
+    EEPROM.put(MQTT_EEPROM_ADDR + sizeof(MQTTConfig) + stateSlot, savedState);
+    if (savedVersion != appliedVersion) {
+        savedVersion = appliedVersion;
+        EEPROM.put(MQTT_VERSION_EEPROM_ADDR + stateSlot * MQTT_VERSION_EEPROM_LEN, savedVersion);
+    }
+    bool success = EEPROM.commit();
+    EEPROM.end();
+    
+    if (success) {
+        logger.debug("Relay state saved to EEPROM: %s", savedState ? "ON" : "OFF");
+    } else {
+        logger.error("Failed to save relay state to EEPROM");
+    }
+    
+    return success;
+}
+
+bool MQTTRelay::addGroup(const char* group, bool persist) {
+    if (!group || !*group || strchr(group, ';')) {
+        logger.error("Invalid group name");
+        return false;
+    }
+    
+    for (const auto& existing : groups) {
+        if (existing == group) return true;
+    }
+    
+    if (groups.size() >= MQTT_MAX_GROUPS) {
+        logger.error("Group limit reached, cannot join %s", group);
+        return false;
+    }
+    
+    String filter = String(GROUP_TOPIC_PREFIX) + group;
+    if (!session->subscribe(filter.c_str(), [this](const char* topic, byte* payload, unsigned int length) {
+        handleGroupMessage(topic, payload, length);
+    }, this)) {
+        return false;
+    }
+    
+    groups.push_back(String(group));
+    logger.info("Joined group: %s", group);
+    
+    return persist ? saveGroups() : true;
+}
+
+void MQTTRelay::clearGroups(bool persist) {
+    for (const auto& group : groups) {
+        String filter = String(GROUP_TOPIC_PREFIX) + group;
+        session->unsubscribe(filter.c_str(), this);
+    }
+    groups.clear();
+    
+    if (persist) {
+        saveGroups();
+    }
+}
+
+void MQTTRelay::setGroups(JsonDocument& command) {
+    JsonArray list = command["groups"];
+    if (!command["groups"].is<JsonArray>()) {
+        logger.error("No groups array in set_groups command");
+        sendAck("set_groups", false);
+        return;
+    }
+    
+    clearGroups(false);
+    
+    bool success = true;
+    for (JsonVariant group : list) {
+        success &= addGroup(group.as<const char*>(), false);
+    }
+    success &= saveGroups();
+    stateChanged = true;
+    
+    sendAck("set_groups", success);
+}
+
+void MQTTRelay::setSchedule(JsonDocument& command) {
+    if (!command["rules"].is<JsonArray>()) {
+        logger.error("No rules array in set_schedule command");
+        sendAck("set_schedule", false);
+        return;
+    }
+    
+    String error;
+    if (!schedule.set(command["rules"].as<JsonArray>(), error)) {
+        logger.error("Rejected schedule: %s", error.c_str());
+        sendAck("set_schedule", false);
+        return;
+    }
+    
+    sendAck("set_schedule", true);
+}
+
+void MQTTRelay::sendSchedule() {
+    if (!session->isConnected() || ackSuppressed) return;
     
     JsonDocument doc;
     doc["device_uuid"] = deviceUUID;
-    doc["message"] = "hello";
-    doc["device_name"] = deviceName;
-    doc["state"] = relayState ? "on" : "off";
+    doc["command"] = "ack";
+    doc["original_command"] = "get_schedule";
+    doc["success"] = true;
+    doc["clock_synced"] = RelaySchedule::clockSynced();
+    schedule.toJson(doc["rules"].to<JsonArray>());
     doc["timestamp"] = getCurrentTimestamp();
     
     String payload;
     serializeJson(doc, payload);
     
-    if (mqttClient->publish(uplinkTopic.c_str(), payload.c_str(), false)) {
-        logger.info("Hello message sent");
-    } else {
-        logger.error("Failed to send hello message");
+    if (!session->publish(uplinkTopic.c_str(), payload.c_str(), false)) {
+        logger.error("Failed to send schedule");
+    }
+}
+
+void MQTTRelay::startPulse(JsonDocument& command) {
+    const char* state = command["state"] | "on";
+    uint32_t duration = command["duration"] | 0;
+    
+    if (strcmp(state, "on") != 0 && strcmp(state, "off") != 0) {
+        logger.error("Invalid pulse state: %s", state);
+        sendAck("pulse", false);
+        return;
+    }
+    
+    if (!admission.admitPulse()) {
+        admissionOutcome = "throttled";
+        sendAck("pulse", false);
+        admissionOutcome = nullptr;
+        return;
+    }
+    
+    if (!pulse(strcmp(state, "on") == 0, duration)) {
+        sendAck("pulse", false);
+        return;
+    }
+    
+    sendAck("pulse", true, relayState ? "on" : "off");
+}
+
+void MQTTRelay::setTiming(JsonDocument& command) {
+    // Fields that are left out keep their current value
+    timing.autoOffMs = command["auto_off"] | timing.autoOffMs;
+    timing.minOnMs = command["min_on"] | timing.minOnMs;
+    timing.minOffMs = command["min_off"] | timing.minOffMs;
+    timing.interlock = command["interlock"] | timing.interlock;
+    
+    // Apply a new auto-off to a relay that is already on
+    if (relayState && !revertTimer.isActive() && timing.autoOffMs) {
+        revertState = false;
+        revertPersist = true;
+        timers.schedule(revertTimer, timing.autoOffMs);
     }
+    
+    logger.info("Timing set: auto_off=%lu min_on=%lu min_off=%lu interlock=%d",
+                (unsigned long)timing.autoOffMs, (unsigned long)timing.minOnMs,
+                (unsigned long)timing.minOffMs, timing.interlock);
+    
+    sendAck("set_timing", saveTiming());
 }
 
-bool MQTTRelay::loadConfig() {
+void MQTTRelay::sendTiming() {
+    if (!session->isConnected() || ackSuppressed) return;
+    
+    JsonDocument doc;
+    doc["device_uuid"] = deviceUUID;
+    doc["command"] = "ack";
+    doc["original_command"] = "get_timing";
+    doc["success"] = true;
+    doc["auto_off"] = timing.autoOffMs;
+    doc["min_on"] = timing.minOnMs;
+    doc["min_off"] = timing.minOffMs;
+    doc["interlock"] = timing.interlock;
+    doc["timestamp"] = getCurrentTimestamp();
+    
+    String payload;
+    serializeJson(doc, payload);
+    
+    if (!session->publish(uplinkTopic.c_str(), payload.c_str(), false)) {
+        logger.error("Failed to send timing");
+    }
+}
+
+void MQTTRelay::sendThrottled(uint32_t dropped) {
+    if (!session->isConnected()) return;
+    
+    JsonDocument doc;
+    doc["device_uuid"] = deviceUUID;
+    doc["command"] = "ack";
+    doc["original_command"] = "throttled";
+    doc["success"] = false;
+    doc["admission"] = "throttled";
+    doc["dropped"] = dropped;
+    doc["timestamp"] = getCurrentTimestamp();
+    
+    String payload;
+    serializeJson(doc, payload);
+    
+    if (!session->publish(uplinkTopic.c_str(), payload.c_str(), false)) {
+        logger.error("Failed to send throttle report");
+    }
+}
+
+bool MQTTRelay::loadGroups() {
+    if (stateSlot >= MQTT_MAX_SLOTS) return false;
+    
+    char stored[MQTT_GROUPS_EEPROM_LEN];
+    
     EEPROM.begin(MQTT_EEPROM_SIZE);
-    EEPROM.get(MQTT_EEPROM_ADDR, config);
+    EEPROM.get(MQTT_GROUPS_EEPROM_ADDR + stateSlot * MQTT_GROUPS_EEPROM_LEN, stored);
     EEPROM.end();
+    stored[sizeof(stored) - 1] = '\0';
     
-    if (!config.initialized) {
-        logger.warn("No MQTT configuration found in EEPROM, using defaults");
-        config.initialized = true;
-        saveConfig();
+    // Erased flash reads back as 0xFF, treat anything non-printable as empty
+    if ((uint8_t)stored[0] < 0x20 || (uint8_t)stored[0] > 0x7E) {
         return false;
     }
     
-    logger.info("MQTT configuration loaded from EEPROM");
+    char* context = nullptr;
+    for (char* group = strtok_r(stored, ";", &context); group; group = strtok_r(nullptr, ";", &context)) {
+        addGroup(group, false);
+    }
+    
+    logger.info("Loaded %d group(s) from EEPROM", (int)groups.size());
     return true;
 }
 
-bool MQTTRelay::saveConfig() {
-    config.initialized = true;
+bool MQTTRelay::saveGroups() {
+    if (stateSlot >= MQTT_MAX_SLOTS) return false;
+    
+    char stored[MQTT_GROUPS_EEPROM_LEN];
+    memset(stored, 0, sizeof(stored));
+    
+    size_t used = 0;
+    for (const auto& group : groups) {
+        size_t needed = group.length() + (used ? 1 : 0);
+        if (used + needed >= sizeof(stored)) {
+            logger.error("Group list too long, %s not persisted", group.c_str());
+            break;
+        }
+        if (used) stored[used++] = ';';
+        memcpy(stored + used, group.c_str(), group.length());
+        used += group.length();
+    }
+    
     EEPROM.begin(MQTT_EEPROM_SIZE);
-    EEPROM.put(MQTT_EEPROM_ADDR, config);
+    EEPROM.put(MQTT_GROUPS_EEPROM_ADDR + stateSlot * MQTT_GROUPS_EEPROM_LEN, stored);
     bool success = EEPROM.commit();
     EEPROM.end();
     
-    if (success) {
-        logger.info("MQTT configuration saved to EEPROM");
-    } else {
-        logger.error("Failed to save MQTT configuration to EEPROM");
+    if (!success) {
+        logger.error("Failed to save groups to EEPROM");
     }
     
     return success;
 }
 
-bool MQTTRelay::loadRelayState() {
+bool MQTTRelay::loadTiming() {
+    if (stateSlot >= MQTT_MAX_SLOTS) return false;
+    
     EEPROM.begin(MQTT_EEPROM_SIZE);
-    // Relay state is stored after the config structure
-    EEPROM.get(MQTT_EEPROM_ADDR + sizeof(MQTTConfig), relayState);
+    EEPROM.get(MQTT_TIMING_EEPROM_ADDR + stateSlot * MQTT_TIMING_EEPROM_LEN, timing);
     EEPROM.end();
     
-    logger.info("Relay state loaded from EEPROM: %s", relayState ? "ON" : "OFF");
+    if (timing.magic != RELAY_TIMING_MAGIC) {
+        memset(&timing, 0, sizeof(timing));
+        return false;
+    }
+    
+    logger.info("Timing loaded from EEPROM");
     return true;
 }
 
-bool MQTTRelay::saveRelayState() {
+bool MQTTRelay::saveTiming() {
+    if (stateSlot >= MQTT_MAX_SLOTS) return false;
+    
+    timing.magic = RELAY_TIMING_MAGIC;
     EEPROM.begin(MQTT_EEPROM_SIZE);
-    EEPROM.put(MQTT_EEPROM_ADDR + sizeof(MQTTConfig), relayState);
+    EEPROM.put(MQTT_TIMING_EEPROM_ADDR + stateSlot * MQTT_TIMING_EEPROM_LEN, timing);
     bool success = EEPROM.commit();
     EEPROM.end();
     
-    if (success) {
-        logger.debug("Relay state saved to EEPROM: %s", relayState ? "ON" : "OFF");
-    } else {
-        logger.error("Failed to save relay state to EEPROM");
+    if (!success) {
+        logger.error("Failed to save timing to EEPROM");
     }
     
     return success;
@@ -440,38 +1066,18 @@ String MQTTRelay::getCurrentTimestamp() {
     return String(millis());
 }
 
-void MQTTRelay::handleReconnection() {
-    unsigned long now = millis();
-    
-    if (now - lastReconnectAttempt < MQTT_RECONNECT_DELAY) {
-        return; // Too soon to retry
-    }
-    
-    if (reconnectAttempts >= MQTT_MAX_RECONNECT_ATTEMPTS) {
-        logger.error("Max reconnection attempts reached. Stopping auto-reconnect.");
-        autoReconnect = false;
-        return;
-    }
-    
-    lastReconnectAttempt = now;
-    logger.info("Attempting MQTT reconnection (attempt %d/%d)", 
-                reconnectAttempts + 1, MQTT_MAX_RECONNECT_ATTEMPTS);
-    
-    if (connect()) {
-        logger.info("Reconnection successful");
-    }
-}
-
 void MQTTRelay::setupLastWill() {
     JsonDocument doc;
     doc["device_uuid"] = deviceUUID;
     doc["status"] = "offline";
-    doc["timestamp"] = getCurrentTimestamp();
+    doc["session"] = session->getClientName();
     
     String payload;
     serializeJson(doc, payload);
     
-    // Set Last Will and Testament (this should be called before connect())
-    // Note: This is typically set during connection, handled in connect() method
-    logger.info("Last Will and Testament configured");
+    // Set Last Will and Testament (must happen before connect()). A shared session
+    // carries one will; the other controllers are covered through "session".
+    if (session->setWill(statusTopic.c_str(), payload.c_str())) {
+        logger.info("Last Will and Testament configured");
+    }
 }
\ No newline at end of file
@@ -0,0 +1,391 @@
+/**
+ * @file MQTTSession.cpp
+ * @brief Shared MQTT broker connection for one or more relay controllers
+ * @author Your Name
+ * @date October 2025
+ */
+
+#include "MQTTSession.h"
+
+MQTTSession::MQTTSession(const char* clientName)
+    : reconnectAttempts(0)
+    , autoReconnect(true)
+    , linkUp(true)
+    , slotCount(0)
+    , clientName(clientName)
+    , logger("MQTTSession", CHRONOLOG_LEVEL_DEBUG)
+    , lastReconnectAttempt(0)
+    , mqttClient(nullptr)
+{
+    reconnectTimer.setCallback([this]() { handleReconnection(); });
+
+    // Initialize configuration with defaults
+    memset(&config, 0, sizeof(config));
+    strncpy(config.brokerHost, MQTT_BROKER_HOST, sizeof(config.brokerHost) - 1);
+    config.brokerPort = MQTT_BROKER_PORT;
+    strncpy(config.deviceUUID, clientName, sizeof(config.deviceUUID) - 1);
+    config.useSSL = true;
+    config.initialized = false;
+}
+
+MQTTSession::~MQTTSession() {
+    if (mqttClient) {
+        mqttClient->disconnect();
+        delete mqttClient;
+    }
+}
+
+bool MQTTSession::begin() {
+    if (mqttClient) {
+        return true; // Already initialized by another controller
+    }
+
+    logger.info("Initializing MQTT session");
+
+    loadConfig();
+
+    // Setup MQTT client
+    if (config.useSSL) {
+        setupSSL();
+        mqttClient = new PubSubClient(wifiClientSecure);
+    } else {
+        mqttClient = new PubSubClient(wifiClient);
+    }
+
+    // Configure MQTT client, every publish goes through the topic router
+    mqttClient->setServer(config.brokerHost, config.brokerPort);
+    mqttClient->setCallback([this](char* topic, byte* payload, unsigned int length) {
+        // Listeners detached by a handler still see the end of the dispatch they saw start
+        std::vector<DispatchListener> listeners(dispatchListeners);
+        for (const auto& listener : listeners) {
+            listener.handler(false);
+        }
+        if (router.dispatch(topic, payload, length) == 0) {
+            logger.warn("No handler registered for topic: %s", topic);
+        }
+        for (const auto& listener : listeners) {
+            listener.handler(true);
+        }
+    });
+    mqttClient->setKeepAlive(MQTT_KEEPALIVE);
+    mqttClient->setBufferSize(MQTT_BUFFER_SIZE);
+
+    logger.info("MQTT session initialized successfully");
+    return true;
+}
+
+void MQTTSession::loop() {
+    if (mqttClient) {
+        // Handle MQTT client loop
+        mqttClient->loop();
+
+        // Arm the next reconnect attempt, MQTT_RECONNECT_DELAY after the last one
+        if (!mqttClient->connected() && autoReconnect && linkUp && !reconnectTimer.isActive()) {
+            uint32_t since = millis() - lastReconnectAttempt;
+            bool tried = lastReconnectAttempt && since < MQTT_RECONNECT_DELAY;
+            timers.schedule(reconnectTimer, tried ? MQTT_RECONNECT_DELAY - since : 0);
+        }
+    }
+
+    // Run due timers of every controller on this session
+    timers.advance(millis());
+}
+
+uint32_t MQTTSession::nextDeadline(uint32_t limit) {
+    // The wheel counts from its next tick, loop() left it one past millis()
+    int64_t wait = (int64_t)timers.nextDeadline(limit) + (int32_t)(timers.now() - millis());
+    return wait < 0 ? 0 : std::min<int64_t>(wait, limit);
+}
+
+bool MQTTSession::connect() {
+    if (!mqttClient) {
+        logger.error("MQTT client not initialized");
+        return false;
+    }
+
+    if (mqttClient->connected()) {
+        return true;
+    }
+
+    logger.info("Connecting to MQTT broker: %s:%d", config.brokerHost, config.brokerPort);
+
+    // Generate client ID
+    String clientId = "ESP32-" + clientName + "-" + String(random(0xffff), HEX);
+
+    // Attempt connection, the broker publishes the will (retained) if we drop off
+    bool connected = willTopic.length()
+        ? mqttClient->connect(clientId.c_str(), willTopic.c_str(), MQTT_QOS, true, willPayload.c_str())
+        : mqttClient->connect(clientId.c_str());
+
+    if (connected) {
+        logger.info("Connected to MQTT broker with client ID: %s", clientId.c_str());
+
+        // Replay every registered subscription on the fresh session
+        for (size_t i = 0; i < subscriptions.size(); i++) {
+            const String& filter = subscriptions[i].filter;
+
+            bool duplicate = false;
+            for (size_t j = 0; j < i && !duplicate; j++) {
+                duplicate = subscriptions[j].filter == filter;              // Filter shared by several controllers
+            }
+            if (duplicate) continue;
+
+            if (mqttClient->subscribe(filter.c_str(), MQTT_QOS)) {
+                logger.info("Subscribed to topic: %s", filter.c_str());
+            } else {
+                logger.error("Failed to subscribe to topic: %s", filter.c_str());
+            }
+        }
+
+        // Reset reconnect attempts
+        reconnectAttempts = 0;
+
+        for (size_t i = 0; i < connectListeners.size(); i++) {
+            ConnectHandler handler = connectListeners[i].handler;
+            handler();
+        }
+
+    } else {
+        logger.error("Failed to connect to MQTT broker. Error: %d", mqttClient->state());
+        reconnectAttempts++;
+    }
+
+    return connected;
+}
+
+void MQTTSession::disconnect() {
+    if (mqttClient && mqttClient->connected()) {
+        mqttClient->disconnect();
+        logger.info("Disconnected from MQTT broker");
+    }
+}
+
+bool MQTTSession::isConnected() {
+    return mqttClient && mqttClient->connected();
+}
+
+void MQTTSession::setLinkUp(bool up) {
+    linkUp = up;
+
+    if (!up) {
+        reconnectTimer.cancel();
+        if (isConnected()) {
+            mqttClient->disconnect(); // The socket is dead, don't wait for the keepalive to notice
+        }
+        return;
+    }
+
+    // A fresh link gets a full set of attempts, even after the session gave up
+    reconnectAttempts = 0;
+    lastReconnectAttempt = 0;
+    autoReconnect = true;
+    if (mqttClient && !mqttClient->connected()) {
+        timers.schedule(reconnectTimer, 0);
+    }
+}
+
+bool MQTTSession::hasInput() {
+    if (!isConnected()) return false;
+    return config.useSSL ? wifiClientSecure.available() > 0 : wifiClient.available() > 0;
+}
+
+bool MQTTSession::subscribe(const char* filter, TopicRouter::Handler handler, void* owner) {
+    if (!router.add(filter, handler, owner)) {
+        logger.error("Invalid topic filter: %s", filter ? filter : "(null)");
+        return false;
+    }
+
+    bool shared = isSubscribed(filter);
+    subscriptions.push_back({String(filter), owner});
+
+    if (shared || !isConnected()) {
+        return true; // Broker subscription already exists or is replayed on connect
+    }
+
+    if (mqttClient->subscribe(filter, MQTT_QOS)) {
+        logger.info("Subscribed to topic: %s", filter);
+        return true;
+    }
+
+    logger.error("Failed to subscribe to topic: %s", filter);
+    return false;
+}
+
+void MQTTSession::unsubscribe(const char* filter, void* owner) {
+    router.remove(filter, owner);
+
+    for (size_t i = 0; i < subscriptions.size(); ) {
+        if (subscriptions[i].owner == owner && subscriptions[i].filter == filter) {
+            subscriptions.erase(subscriptions.begin() + i);
+        } else {
+            i++;
+        }
+    }
+
+    if (!isSubscribed(filter) && isConnected()) {
+        mqttClient->unsubscribe(filter);
+        logger.info("Unsubscribed from topic: %s", filter);
+    }
+}
+
+void MQTTSession::detach(void* owner) {
+    std::vector<String> released;
+
+    for (size_t i = 0; i < subscriptions.size(); ) {
+        if (subscriptions[i].owner == owner) {
+            released.push_back(subscriptions[i].filter);
+            subscriptions.erase(subscriptions.begin() + i);
+        } else {
+            i++;
+        }
+    }
+
+    for (size_t i = 0; i < connectListeners.size(); ) {
+        if (connectListeners[i].owner == owner) {
+            connectListeners.erase(connectListeners.begin() + i);
+        } else {
+            i++;
+        }
+    }
+
+    for (size_t i = 0; i < dispatchListeners.size(); ) {
+        if (dispatchListeners[i].owner == owner) {
+            dispatchListeners.erase(dispatchListeners.begin() + i);
+        } else {
+            i++;
+        }
+    }
+
+    router.remove(owner);
+
+    for (const auto& filter : released) {
+        if (!isSubscribed(filter.c_str()) && isConnected()) {
+            mqttClient->unsubscribe(filter.c_str());
+        }
+    }
+}
+
+void MQTTSession::onConnect(ConnectHandler handler, void* owner) {
+    connectListeners.push_back({handler, owner});
+}
+
+void MQTTSession::onDispatch(DispatchHandler handler, void* owner) {
+    dispatchListeners.push_back({handler, owner});
+}
+
+bool MQTTSession::publish(const char* topic, const char* payload, bool retained) {
+    if (!mqttClient || !mqttClient->connected()) return false;
+    return mqttClient->publish(topic, payload, retained);
+}
+
+bool MQTTSession::setWill(const char* topic, const char* payload) {
+    if (willTopic.length()) {
+        return false; // One will per connection, the first controller owns it
+    }
+
+    willTopic = topic;
+    willPayload = payload;
+    return true;
+}
+
+uint8_t MQTTSession::allocateSlot() {
+    if (slotCount >= MQTT_MAX_SLOTS) {
+        logger.error("Out of controller slots (%d), state will not be persisted", MQTT_MAX_SLOTS);
+        return MQTT_MAX_SLOTS;
+    }
+    return slotCount++;
+}
+
+void MQTTSession::setBrokerConfig(const char* host, int port, bool useSSL) {
+    strncpy(config.brokerHost, host, sizeof(config.brokerHost) - 1);
+    config.brokerPort = port;
+    config.useSSL = useSSL;
+    saveConfig();
+}
+
+void MQTTSession::setupSSL() {
+#ifdef ESP8266
+    // ESP8266 WiFiClientSecure API
+    wifiClientSecure.setTrustAnchors(new BearSSL::X509List(rootCACertificate));
+
+    // Optional: Set client certificate and key if provided
+    if (strlen(clientCertificate) > 0 && strlen(clientPrivateKey) > 0) {
+        wifiClientSecure.setClientRSACert(new BearSSL::X509List(clientCertificate),
+                                         new BearSSL::PrivateKey(clientPrivateKey));
+    }
+
+    // For testing purposes - remove in production
+    wifiClientSecure.setInsecure();
+
+    logger.info("ESP8266 SSL/TLS certificates configured");
+#else
+    // ESP32 WiFiClientSecure API
+    wifiClientSecure.setCACert(rootCACertificate);
+    wifiClientSecure.setCertificate(clientCertificate);
+    wifiClientSecure.setPrivateKey(clientPrivateKey);
+    wifiClientSecure.setInsecure(); // For testing - remove in production
+
+    logger.info("ESP32 SSL/TLS certificates configured");
+#endif
+}
+
+bool MQTTSession::loadConfig() {
+    EEPROM.begin(MQTT_EEPROM_SIZE);
+    EEPROM.get(MQTT_EEPROM_ADDR, config);
+    EEPROM.end();
+
+    if (!config.initialized) {
+        logger.warn("No MQTT configuration found in EEPROM, using defaults");
+        config.initialized = true;
+        saveConfig();
+        return false;
+    }
+
+    logger.info("MQTT configuration loaded from EEPROM");
+    return true;
+}
+
+bool MQTTSession::saveConfig() {
+    config.initialized = true;
+    EEPROM.begin(MQTT_EEPROM_SIZE);
+    EEPROM.put(MQTT_EEPROM_ADDR, config);
+    bool success = EEPROM.commit();
+    EEPROM.end();
+
+    if (success) {
+        logger.info("MQTT configuration saved to EEPROM");
+    } else {
+        logger.error("Failed to save MQTT configuration to EEPROM");
+    }
+
+    return success;
+}
+
+void MQTTSession::handleReconnection() {
+    if (!mqttClient || mqttClient->connected()) {
+        return; // Came back on its own
+    }
+
+    if (reconnectAttempts >= MQTT_MAX_RECONNECT_ATTEMPTS) {
+        logger.error("Max reconnection attempts reached. Stopping auto-reconnect.");
+        autoReconnect = false;
+        return;
+    }
+
+    lastReconnectAttempt = millis();
+    logger.info("Attempting MQTT reconnection (attempt %d/%d)",
+                reconnectAttempts + 1, MQTT_MAX_RECONNECT_ATTEMPTS);
+
+    if (connect()) {
+        logger.info("Reconnection successful");
+    }
+}
+
+bool MQTTSession::isSubscribed(const char* filter) const {
+    for (const auto& subscription : subscriptions) {
+        if (subscription.filter == filter) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,337 @@
+/**
+ * @file MQTTUpdate.cpp
+ * @brief Chunked, resumable firmware transfer over the MQTT session
+ * @author Your Name
+ * @date October 2025
+ */
+
+#include "MQTTUpdate.h"
+
+#ifdef ESP8266
+    #include <Updater.h>
+#else
+    #include <Update.h>
+#endif
+
+MQTTUpdate::MQTTUpdate(MQTTSession& session, TimerWheel& timers)
+    : active(false)
+    , verified(false)
+    , autoReboot(true)
+    , gapReported(false)
+    , sinceAck(0)
+    , chunkSize(0)
+    , imageSize(0)
+    , written(0)
+    , nextChunk(0)
+    , logger("MQTTUpdate", CHRONOLOG_LEVEL_DEBUG)
+    , session(session)
+    , timers(timers)
+    , onRestart(nullptr)
+{
+    memset(expectedHash, 0, sizeof(expectedHash));
+}
+
+MQTTUpdate::~MQTTUpdate() {
+    if (active) {
+        abort("shutdown");
+    }
+    session.detach(this);
+}
+
+void MQTTUpdate::begin(const String& deviceUUID, RestartHandler onRestart) {
+    this->deviceUUID = deviceUUID;
+    this->onRestart = onRestart;
+    uplinkTopic = String(UPLINK_TOPIC_PREFIX) + deviceUUID;
+    chunkTopic = String(OTA_TOPIC_PREFIX) + deviceUUID;
+
+    abandonTimer.setCallback([this]() { abort("timeout"); });
+    rebootTimer.setCallback([this]() { restart(); });
+
+    // Binary chunks skip JSON parsing and command admission, they are only taken while a transfer is open
+    session.subscribe(chunkTopic.c_str(), [this](const char* topic, byte* payload, unsigned int length) {
+        handleChunk(topic, payload, length);
+    }, this);
+}
+
+bool MQTTUpdate::handleCommand(const char* cmd, JsonDocument& command) {
+    if (strcmp(cmd, "ota_begin") == 0) {
+        start(command);
+
+    } else if (strcmp(cmd, "ota_status") == 0) {
+        report(cmd, active || verified, active || verified ? nullptr : "idle");
+
+    } else if (strcmp(cmd, "ota_abort") == 0) {
+        if (active) {
+            abort("aborted");
+        }
+        verified = false;
+        rebootTimer.cancel();
+        report(cmd, true);
+
+    } else if (strcmp(cmd, "ota_reboot") == 0) {
+        if (!verified) {
+            report(cmd, false, "not_ready");
+            return true;
+        }
+        report(cmd, true);
+        timers.schedule(rebootTimer, OTA_REBOOT_DELAY);
+
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void MQTTUpdate::start(JsonDocument& manifest) {
+    const char* id = manifest["id"];
+    const char* sha = manifest["sha256"];
+    uint32_t size = manifest["size"] | 0;
+    uint16_t chunk = manifest["chunk"] | OTA_MAX_CHUNK;
+    uint8_t digest[OTA_PATCH_SHA256_SIZE];
+
+    if (!id || !sha || !parseHash(sha, digest) || !size || !chunk || chunk > OTA_MAX_CHUNK) {
+        logger.error("Invalid firmware manifest");
+        report("ota_begin", false, "bad_manifest");
+        return;
+    }
+
+    // Same image again: the server lost track (reconnect, restart), resume where we are
+    if ((active || verified) && transferId == id && memcmp(digest, expectedHash, sizeof(digest)) == 0) {
+        logger.info("Resuming firmware transfer %s at chunk %lu", id, (unsigned long)nextChunk);
+        gapReported = false;
+        sinceAck = 0;
+        if (active) {
+            timers.schedule(abandonTimer, OTA_ABANDON_TIMEOUT);
+        }
+        report("ota_begin", true);
+        return;
+    }
+
+    // Fail closed: without a key only OTA_ALLOW_UNSIGNED builds take images
+    if (!OTAVerifier::enabled() && !OTAVerifier::acceptsUnsigned()) {
+        logger.error("Firmware update refused, no signing key built in");
+        report("ota_begin", false, "no_signing_key");
+        return;
+    }
+
+    if (active) {
+        abort("superseded");
+    }
+    verified = false;
+    rebootTimer.cancel();
+
+    // The web portal may be writing the partition already
+    if (Update.isRunning()) {
+        report("ota_begin", false, "busy");
+        return;
+    }
+
+    bool fits = true;
+    #ifdef ESP8266
+        fits = size <= ((ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000);
+    #endif
+    if (!fits || !Update.begin(size)) {
+        logger.error("Cannot start firmware update: %s", updateError().c_str());
+        report("ota_begin", false, "no_space");
+        return;
+    }
+
+    const char* reboot = manifest["reboot"] | "auto";
+    transferId = id;
+    memcpy(expectedHash, digest, sizeof(expectedHash));
+    imageSize = size;
+    chunkSize = chunk;
+    written = 0;
+    nextChunk = 0;
+    sinceAck = 0;
+    gapReported = false;
+    autoReboot = strcmp(reboot, "manual") != 0;
+    active = true;
+    hash.begin();
+    signature.begin([](const uint8_t* data, size_t len) {
+        return Update.write(const_cast<uint8_t*>(data), len) == len;
+    });
+    timers.schedule(abandonTimer, OTA_ABANDON_TIMEOUT);
+
+    logger.info("Firmware transfer %s started: %lu bytes in %u byte chunks", id, (unsigned long)size, chunk);
+    report("ota_begin", true);
+}
+
+void MQTTUpdate::handleChunk(const char* topic, byte* payload, unsigned int length) {
+    if (!active || length < 4) return;
+
+    uint32_t seq = (uint32_t)payload[0] | ((uint32_t)payload[1] << 8) | ((uint32_t)payload[2] << 16) | ((uint32_t)payload[3] << 24);
+    const uint8_t* data = payload + 4;
+    size_t len = length - 4;
+
+    // Go-back-N: anything but the next chunk is dropped, the first gap is reported once
+    if (seq != nextChunk) {
+        if (seq > nextChunk && !gapReported) {
+            gapReported = true;
+            report("ota_chunk", false, "gap");
+        }
+        return;
+    }
+
+    uint32_t remaining = imageSize - written;
+    bool last = len >= remaining;
+    if (!len || len > remaining || (!last && len != chunkSize)) {
+        abort("bad_chunk");
+        return;
+    }
+
+    timers.schedule(abandonTimer, OTA_ABANDON_TIMEOUT);
+    hash.update(data, len);
+
+    #ifdef ESP8266
+        // eboot expands a gzip image after the reboot and boots whatever comes out
+        const char* rejected = written ? nullptr : OTAGzipPeek::compressedImageError(data, len);
+        if (rejected) {
+            logger.error("Firmware transfer %s refused: %s", transferId.c_str(), rejected);
+            abort("not_firmware");
+            return;
+        }
+    #endif
+
+    if (last) {
+        finish(data, len);
+        return;
+    }
+
+    if (!writeImage(data, len)) {
+        abort("write_failed");
+        return;
+    }
+    written += len;
+    nextChunk++;
+    gapReported = false;
+
+    if (++sinceAck >= OTA_ACK_EVERY) {
+        sinceAck = 0;
+        report("ota_chunk", true);
+    }
+}
+
+void MQTTUpdate::finish(const uint8_t* data, size_t len) {
+    uint8_t digest[OTA_PATCH_SHA256_SIZE];
+    hash.finish(digest);
+
+    // Held back until the image checks out, so a bad transfer never completes the partition
+    if (memcmp(digest, expectedHash, sizeof(digest)) != 0) {
+        abort("hash_mismatch");
+        return;
+    }
+    if (!writeImage(data, len)) {
+        abort("write_failed");
+        return;
+    }
+    written += len;
+    nextChunk++;
+
+    if (!OTAVerifier::acceptsUnsigned() && !signature.end()) {
+        logger.error("Firmware rejected: %s", signature.statusString());
+        abort(signature.status() == OTAVerifier::Status::UNSIGNED ? "unsigned" : "bad_signature");
+        return;
+    }
+    if (!Update.end(true)) {
+        logger.error("Firmware update failed: %s", updateError().c_str());
+        abort("install_failed");
+        return;
+    }
+
+    active = false;
+    verified = true;
+    abandonTimer.cancel();
+    logger.info("Firmware transfer %s verified, %lu bytes", transferId.c_str(), (unsigned long)written);
+    report("ota_end", true);
+
+    // Staged: "manual" waits for ota_reboot so a fleet can switch over together
+    if (autoReboot) {
+        timers.schedule(rebootTimer, OTA_REBOOT_DELAY);
+    }
+}
+
+bool MQTTUpdate::writeImage(const uint8_t* data, size_t len) {
+    if (OTAVerifier::acceptsUnsigned()) {
+        return Update.write(const_cast<uint8_t*>(data), len) == len;
+    }
+    return signature.write(data, len);                                                      // Holds back the trailer, forwards the rest
+}
+
+void MQTTUpdate::abort(const char* reason) {
+    if (active) {
+        #ifdef ESP8266
+            Update.end(false);                      // Unfinished, so the updater discards it
+        #else
+            Update.abort();
+        #endif
+    }
+    active = false;
+    abandonTimer.cancel();
+    logger.warn("Firmware transfer %s aborted: %s", transferId.c_str(), reason);
+    report("ota_end", false, reason);
+}
+
+void MQTTUpdate::restart() {
+    logger.info("Restarting into new firmware");
+    if (onRestart) {
+        onRestart();
+    }
+    ESP.restart();
+}
+
+void MQTTUpdate::report(const char* command, bool success, const char* error) {
+    if (!session.isConnected()) return;
+
+    JsonDocument doc;
+    doc["device_uuid"] = deviceUUID;
+    doc["command"] = "ack";
+    doc["original_command"] = command;
+    doc["success"] = success;
+    doc["id"] = transferId;
+    doc["next"] = nextChunk;
+    doc["written"] = written;
+    doc["size"] = imageSize;
+    if (verified) {
+        doc["verified"] = true;
+    }
+    if (error) {
+        doc["error"] = error;
+    }
+    doc["timestamp"] = String(millis());
+
+    String payload;
+    serializeJson(doc, payload);
+
+    if (!session.publish(uplinkTopic.c_str(), payload.c_str(), false)) {
+        logger.error("Failed to send firmware update ack: %s", command);
+    }
+}
+
+bool MQTTUpdate::parseHash(const char* hex, uint8_t* digest) {
+    if (strlen(hex) != OTA_PATCH_SHA256_SIZE * 2) return false;
+
+    for (size_t i = 0; i < OTA_PATCH_SHA256_SIZE * 2; i++) {
+        char c = hex[i];
+        uint8_t nibble;
+        if (c >= '0' && c <= '9') {
+            nibble = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            nibble = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            nibble = c - 'A' + 10;
+        } else {
+            return false;
+        }
+        digest[i / 2] = (i & 1) ? (digest[i / 2] | nibble) : (nibble << 4);
+    }
+    return true;
+}
+
+String MQTTUpdate::updateError() {
+    #ifdef ESP8266
+        return Update.getErrorString();
+    #else
+        return String(Update.errorString());
+    #endif
+}
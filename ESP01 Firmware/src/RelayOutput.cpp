@@ -0,0 +1,127 @@
+/**
+ * @file RelayOutput.cpp
+ * @brief Batched relay output staging and the in-memory test driver
+ * @author Your Name
+ * @date October 2025
+ */
+
+#include "RelayOutput.h"
+
+uint8_t RelayOutput::batchDepth = 0;
+std::vector<RelayOutput*> RelayOutput::pending;
+
+RelayOutput::Batch::Batch() {
+    beginBatch();
+}
+
+RelayOutput::Batch::~Batch() {
+    endBatch();
+}
+
+void RelayOutput::beginBatch() {
+    batchDepth++;
+}
+
+void RelayOutput::endBatch() {
+    if (batchDepth && --batchDepth == 0) {
+        commitAll();
+    }
+}
+
+RelayOutput::RelayOutput(uint8_t channels, bool activeLow)
+    : started(false)
+    , channelCount(min(channels, (uint8_t)RELAY_OUTPUT_MAX_CHANNELS))
+    , requested(0)
+    , applied(0)
+{
+    uint32_t mask = channelCount >= 32 ? 0xFFFFFFFFUL : (1UL << channelCount) - 1;
+    inversion = activeLow ? mask : 0;
+}
+
+RelayOutput::~RelayOutput() {
+    for (size_t i = 0; i < pending.size(); i++) {
+        if (pending[i] == this) {
+            pending.erase(pending.begin() + i);
+            break;
+        }
+    }
+}
+
+bool RelayOutput::begin() {
+    if (started) {
+        return true; // Shared by several controllers
+    }
+
+    if (!setup()) {
+        return false;
+    }
+
+    // Drive every channel once so the hardware matches the staged state
+    uint32_t all = channelCount >= 32 ? 0xFFFFFFFFUL : (1UL << channelCount) - 1;
+    started = apply(levels(), all);
+    if (started) {
+        applied = requested;
+    }
+    return started;
+}
+
+void RelayOutput::write(uint8_t channel, bool on) {
+    if (channel >= channelCount) return;
+
+    if (on) {
+        requested |= 1UL << channel;
+    } else {
+        requested &= ~(1UL << channel);
+    }
+
+    if (!batchDepth) {
+        commit();
+        return;
+    }
+
+    for (RelayOutput* output : pending) {
+        if (output == this) return;
+    }
+    pending.push_back(this);
+}
+
+bool RelayOutput::read(uint8_t channel) const {
+    return channel < channelCount && (requested & (1UL << channel));
+}
+
+bool RelayOutput::commit() {
+    if (!started || requested == applied) {
+        return true;
+    }
+
+    uint32_t changed = requested ^ applied;
+    if (!apply(levels(), changed)) {
+        return false;
+    }
+
+    applied = requested;
+    return true;
+}
+
+void RelayOutput::commitAll() {
+    std::vector<RelayOutput*> outputs;
+    outputs.swap(pending);
+
+    for (RelayOutput* output : outputs) {
+        output->commit();
+    }
+}
+
+FakeRelayOutput::FakeRelayOutput(uint8_t channels, bool activeLow)
+    : RelayOutput(channels, activeLow)
+{
+}
+
+bool FakeRelayOutput::setup() {
+    return true;
+}
+
+bool FakeRelayOutput::apply(uint32_t levels, uint32_t changed) {
+    log.push_back({micros(), levels, changed});
+    return true;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file RelayOutputDrivers.cpp
+ * @brief Relay output hardware backends (GPIO, 74HC595, PCF857x, MCP23S17)
+ * @author Your Name
+ * @date October 2025
+ */
+
+#include "RelayOutputDrivers.h"
+
+#ifdef ESP8266
+    #define RELAY_GPIO_REGISTER_PINS    16      // GPIO16 sits outside GPOS/GPOC
+#else
+    #include <soc/gpio_reg.h>
+    #define RELAY_GPIO_REGISTER_PINS    32      // GPIO32+ live in the second bank
+#endif
+
+#define MCP23S17_IODIRA     0x00
+#define MCP23S17_IOCON      0x0A
+#define MCP23S17_OLATA      0x14
+#define MCP23S17_OLATB      0x15
+#define MCP23S17_IOCON_HAEN 0x08
+
+GpioRelayOutput::GpioRelayOutput(uint8_t pin, bool activeLow)
+    : RelayOutput(1, activeLow)
+{
+    pins[0] = pin;
+}
+
+GpioRelayOutput::GpioRelayOutput(const uint8_t* pins, uint8_t count, bool activeLow)
+    : RelayOutput(count, activeLow)
+{
+    memcpy(this->pins, pins, channels());
+}
+
+bool GpioRelayOutput::setup() {
+    for (uint8_t i = 0; i < channels(); i++) {
+        pinMode(pins[i], OUTPUT);
+    }
+    return true;
+}
+
+bool GpioRelayOutput::apply(uint32_t levels, uint32_t changed) {
+    uint32_t setMask = 0;
+    uint32_t clearMask = 0;
+
+    for (uint8_t i = 0; i < channels(); i++) {
+        if (!(changed & (1UL << i))) continue;
+
+        bool high = levels & (1UL << i);
+        if (pins[i] < RELAY_GPIO_REGISTER_PINS) {
+            (high ? setMask : clearMask) |= 1UL << pins[i];
+        } else {
+            digitalWrite(pins[i], high ? HIGH : LOW);
+        }
+    }
+
+    #ifdef ESP8266
+        if (setMask)   GPOS = setMask;
+        if (clearMask) GPOC = clearMask;
+    #else
+        if (setMask)   REG_WRITE(GPIO_OUT_W1TS_REG, setMask);
+        if (clearMask) REG_WRITE(GPIO_OUT_W1TC_REG, clearMask);
+    #endif
+
+    return true;
+}
+
+ShiftRegisterRelayOutput::ShiftRegisterRelayOutput(uint8_t dataPin, uint8_t clockPin, uint8_t latchPin, uint8_t chips, bool activeLow)
+    : RelayOutput(chips * 8, activeLow)
+    , dataPin(dataPin)
+    , clockPin(clockPin)
+    , latchPin(latchPin)
+    , chips(channels() / 8)
+{
+}
+
+bool ShiftRegisterRelayOutput::setup() {
+    pinMode(dataPin, OUTPUT);
+    pinMode(clockPin, OUTPUT);
+    pinMode(latchPin, OUTPUT);
+    digitalWrite(latchPin, HIGH);
+    return true;
+}
+
+bool ShiftRegisterRelayOutput::apply(uint32_t levels, uint32_t changed) {
+    if (!changed) return true;
+
+    // The whole chain shifts through on every latch. Far end of the chain first, so chip 0 ends up holding channels 0-7
+    digitalWrite(latchPin, LOW);
+    for (int chip = chips - 1; chip >= 0; chip--) {
+        shiftOut(dataPin, clockPin, MSBFIRST, (levels >> (chip * 8)) & 0xFF);
+    }
+    digitalWrite(latchPin, HIGH);
+    return true;
+}
+
+Pcf857xRelayOutput::Pcf857xRelayOutput(TwoWire& wire, uint8_t address, uint8_t channels, bool activeLow)
+    : RelayOutput(channels > 8 ? 16 : 8, activeLow)
+    , wire(wire)
+    , address(address)
+{
+}
+
+bool Pcf857xRelayOutput::setup() {
+    wire.beginTransmission(address);
+    return wire.endTransmission() == 0; // Expander answers on the bus
+}
+
+bool Pcf857xRelayOutput::apply(uint32_t levels, uint32_t changed) {
+    if (!changed) return true;
+
+    // P0 latches on the first byte, P1 only follows it, so P0 alone ends the transaction early
+    wire.beginTransmission(address);
+    wire.write(levels & 0xFF);
+    if (changed >> 8) {
+        wire.write((levels >> 8) & 0xFF);
+    }
+    return wire.endTransmission() == 0;
+}
+
+Mcp23s17RelayOutput::Mcp23s17RelayOutput(SPIClass& spi, uint8_t csPin, uint8_t hardwareAddress, bool activeLow)
+    : RelayOutput(16, activeLow)
+    , spi(spi)
+    , csPin(csPin)
+    , opcode(0x40 | ((hardwareAddress & 0x07) << 1))
+{
+}
+
+bool Mcp23s17RelayOutput::setup() {
+    pinMode(csPin, OUTPUT);
+    digitalWrite(csPin, HIGH);
+
+    // Until HAEN is set every chip answers address 0, so enable it through that opcode
+    uint8_t addressed = opcode;
+    opcode = 0x40;
+    writeRegisters(MCP23S17_IOCON, MCP23S17_IOCON_HAEN, MCP23S17_IOCON_HAEN);
+    opcode = addressed;
+
+    writeRegisters(MCP23S17_IODIRA, 0x00, 0x00);                            // Both ports output
+    return true;
+}
+
+bool Mcp23s17RelayOutput::apply(uint32_t levels, uint32_t changed) {
+    bool portA = changed & 0x00FF;
+    bool portB = changed & 0xFF00;
+
+    if (portA && portB) {
+        writeRegisters(MCP23S17_OLATA, levels & 0xFF, (levels >> 8) & 0xFF);
+    } else if (portA) {
+        writeRegister(MCP23S17_OLATA, levels & 0xFF);
+    } else if (portB) {
+        writeRegister(MCP23S17_OLATB, (levels >> 8) & 0xFF);
+    }
+    return true;
+}
+
+void Mcp23s17RelayOutput::writeRegister(uint8_t reg, uint8_t value) {
+    spi.beginTransaction(SPISettings(RELAY_OUTPUT_SPI_CLOCK, MSBFIRST, SPI_MODE0));
+    digitalWrite(csPin, LOW);
+    spi.transfer(opcode);
+    spi.transfer(reg);
+    spi.transfer(value);
+    digitalWrite(csPin, HIGH);
+    spi.endTransaction();
+}
+
+void Mcp23s17RelayOutput::writeRegisters(uint8_t reg, uint8_t first, uint8_t second) {
+    // Sequential mode: the address pointer moves from port A to port B
+    spi.beginTransaction(SPISettings(RELAY_OUTPUT_SPI_CLOCK, MSBFIRST, SPI_MODE0));
+    digitalWrite(csPin, LOW);
+    spi.transfer(opcode);
+    spi.transfer(reg);
+    spi.transfer(first);
+    spi.transfer(second);
+    digitalWrite(csPin, HIGH);
+    spi.endTransaction();
+}
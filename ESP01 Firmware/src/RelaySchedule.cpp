@@ -0,0 +1,269 @@
+/**
+ * @file RelaySchedule.cpp
+ * @brief On-device relay schedule table armed on a timer wheel
+ * @author Your Name
+ * @date October 2025
+ */
+
+#include "RelaySchedule.h"
+
+RelaySchedule::RelaySchedule(TimerWheel& wheel)
+    : slot(0)
+    , wheel(wheel)
+    , logger("RelaySchedule", CHRONOLOG_LEVEL_DEBUG)
+    , onAction(nullptr)
+{
+    memset(&table, 0, sizeof(table));
+    memset(due, 0, sizeof(due));
+}
+
+void RelaySchedule::begin(uint8_t slot, ActionHandler handler) {
+    static bool clockConfigured = false;
+
+    this->slot = slot;
+    onAction = handler;
+
+    // Rule times need the wall clock, SNTP runs in the background
+    if (!clockConfigured) {
+        #ifdef ESP8266
+            configTime(SCHEDULE_TIMEZONE, SCHEDULE_NTP_SERVER);
+        #else
+            configTzTime(SCHEDULE_TIMEZONE, SCHEDULE_NTP_SERVER);
+        #endif
+        clockConfigured = true;
+    }
+
+    for (uint8_t i = 0; i < MQTT_MAX_SCHEDULE_RULES; i++) {
+        timers[i].setCallback([this, i]() { fire(i); });
+    }
+    resyncTimer.setCallback([this]() { armAll(); });
+
+    load();
+    armAll();
+}
+
+bool RelaySchedule::set(JsonArray rules, String& error) {
+    ScheduleTable updated;
+    memset(&updated, 0, sizeof(updated));
+    updated.magic = SCHEDULE_EEPROM_MAGIC;
+
+    for (JsonVariant source : rules) {
+        if (updated.count >= MQTT_MAX_SCHEDULE_RULES) {
+            error = "too many rules";
+            return false;
+        }
+        if (!parseRule(source, updated.rules[updated.count], error)) {
+            return false;
+        }
+        updated.count++;
+    }
+
+    table = updated;
+    save();
+    armAll();
+
+    logger.info("Schedule updated with %d rule(s)", table.count);
+    return true;
+}
+
+void RelaySchedule::clear() {
+    memset(&table, 0, sizeof(table));
+    table.magic = SCHEDULE_EEPROM_MAGIC;
+    save();
+    armAll();
+    logger.info("Schedule cleared");
+}
+
+void RelaySchedule::toJson(JsonArray rules) const {
+    for (uint8_t i = 0; i < table.count; i++) {
+        const ScheduleRule& rule = table.rules[i];
+        JsonObject entry = rules.add<JsonObject>();
+
+        if (rule.type == SCHEDULE_RULE_WEEKLY) {
+            char at[6];
+            snprintf(at, sizeof(at), "%02u:%02u", (unsigned)(rule.time / 60), (unsigned)(rule.time % 60));
+            entry["at"] = String(at);
+            entry["days"] = rule.days;
+        } else {
+            entry["once"] = rule.time;
+        }
+        entry["state"] = rule.state ? "on" : "off";
+        if (timers[i].isActive()) {
+            entry["next"] = (uint32_t)due[i];
+        }
+    }
+}
+
+size_t RelaySchedule::size() const {
+    return table.count;
+}
+
+bool RelaySchedule::clockSynced() {
+    return time(nullptr) > 1600000000;                                      // SNTP has set the clock at least once
+}
+
+bool RelaySchedule::load() {
+    if (slot >= MQTT_MAX_SLOTS) {
+        logger.warn("Controller slot %d has no schedule storage", slot);
+        return false;
+    }
+
+    EEPROM.begin(MQTT_EEPROM_SIZE);
+    EEPROM.get(MQTT_SCHEDULE_EEPROM_ADDR + slot * MQTT_SCHEDULE_EEPROM_LEN, table);
+    EEPROM.end();
+
+    if (table.magic != SCHEDULE_EEPROM_MAGIC || table.count > MQTT_MAX_SCHEDULE_RULES) {
+        memset(&table, 0, sizeof(table));
+        table.magic = SCHEDULE_EEPROM_MAGIC;
+        return false;
+    }
+
+    logger.info("Loaded %d schedule rule(s) from EEPROM", table.count);
+    return true;
+}
+
+bool RelaySchedule::save() {
+    if (slot >= MQTT_MAX_SLOTS) {
+        return false;
+    }
+
+    EEPROM.begin(MQTT_EEPROM_SIZE);
+    EEPROM.put(MQTT_SCHEDULE_EEPROM_ADDR + slot * MQTT_SCHEDULE_EEPROM_LEN, table);
+    bool success = EEPROM.commit();
+    EEPROM.end();
+
+    if (!success) {
+        logger.error("Failed to save schedule to EEPROM");
+    }
+    return success;
+}
+
+void RelaySchedule::arm(uint8_t index) {
+    const ScheduleRule& rule = table.rules[index];
+    time_t now = time(nullptr);
+
+    due[index] = rule.type == SCHEDULE_RULE_ONCE ? (time_t)rule.time : nextOccurrence(rule, now);
+    if (!due[index]) {
+        timers[index].cancel();
+        return;
+    }
+
+    uint32_t delayMs = due[index] > now ? (uint32_t)(due[index] - now) * 1000UL : 0;
+    wheel.schedule(timers[index], delayMs);
+}
+
+void RelaySchedule::armAll() {
+    for (uint8_t i = 0; i < MQTT_MAX_SCHEDULE_RULES; i++) {
+        timers[i].cancel();
+    }
+
+    if (!table.count) {
+        resyncTimer.cancel();
+        return;
+    }
+
+    if (!clockSynced()) {
+        logger.debug("Clock not synchronized yet, schedule armed later");
+        wheel.schedule(resyncTimer, 10000);
+        return;
+    }
+
+    for (uint8_t i = 0; i < table.count; i++) {
+        arm(i);
+    }
+
+    // millis() and the wall clock drift apart, re-arm against SNTP time
+    wheel.schedule(resyncTimer, SCHEDULE_RESYNC_INTERVAL);
+}
+
+void RelaySchedule::fire(uint8_t index) {
+    if (index >= table.count) return;
+
+    time_t now = time(nullptr);
+    if (now < due[index]) {
+        wheel.schedule(timers[index], (uint32_t)(due[index] - now) * 1000UL);  // Woke early, wait out the drift
+        return;
+    }
+
+    bool state = table.rules[index].state;
+
+    if (table.rules[index].type == SCHEDULE_RULE_ONCE) {
+        for (uint8_t i = index; i + 1 < table.count; i++) {
+            table.rules[i] = table.rules[i + 1];
+        }
+        table.count--;
+        memset(&table.rules[table.count], 0, sizeof(ScheduleRule));
+        save();
+        armAll();                                                           // Indices shifted
+    } else {
+        due[index] = nextOccurrence(table.rules[index], due[index]);
+        if (due[index]) {
+            wheel.schedule(timers[index], (uint32_t)(due[index] - now) * 1000UL);
+        }
+    }
+
+    logger.info("Schedule rule %d fired: %s", index, state ? "ON" : "OFF");
+    if (onAction) {
+        onAction(index, state);
+    }
+}
+
+bool RelaySchedule::parseRule(JsonVariant source, ScheduleRule& rule, String& error) {
+    memset(&rule, 0, sizeof(rule));
+
+    const char* state = source["state"];
+    if (!state || (strcmp(state, "on") != 0 && strcmp(state, "off") != 0)) {
+        error = "rule state must be on or off";
+        return false;
+    }
+    rule.state = strcmp(state, "on") == 0;
+
+    if (source["at"].is<const char*>()) {
+        unsigned hour, minute;
+        const char* at = source["at"];
+        if (sscanf(at, "%u:%u", &hour, &minute) != 2 || hour > 23 || minute > 59) {
+            error = "rule time must be HH:MM";
+            return false;
+        }
+
+        rule.type = SCHEDULE_RULE_WEEKLY;
+        rule.time = hour * 60 + minute;
+        rule.days = (source["days"] | 0x7F) & 0x7F;                         // Daily unless a weekday mask is given
+        if (!rule.days) {
+            error = "rule has no days";
+            return false;
+        }
+    } else if (source["once"].is<uint32_t>()) {
+        rule.type = SCHEDULE_RULE_ONCE;
+        rule.time = source["once"];
+    } else if (source["in"].is<uint32_t>()) {
+        if (!clockSynced()) {
+            error = "clock not synchronized";
+            return false;
+        }
+        rule.type = SCHEDULE_RULE_ONCE;
+        rule.time = (uint32_t)time(nullptr) + source["in"].as<uint32_t>();
+    } else {
+        error = "rule needs at, once or in";
+        return false;
+    }
+
+    return true;
+}
+
+time_t RelaySchedule::nextOccurrence(const ScheduleRule& rule, time_t after) {
+    struct tm local;
+    localtime_r(&after, &local);
+
+    uint32_t minuteNow = local.tm_hour * 60 + local.tm_min;
+    time_t midnight = after - (local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec);
+
+    for (uint8_t day = 0; day <= 7; day++) {
+        uint8_t weekday = (local.tm_wday + day) % 7;
+        if (!(rule.days & (1 << weekday))) continue;
+        if (day == 0 && rule.time <= minuteNow) continue;
+        return midnight + day * 86400L + rule.time * 60L;
+    }
+
+    return 0;
+}
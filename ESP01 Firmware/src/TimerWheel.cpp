@@ -0,0 +1,219 @@
+/**
+ * @file TimerWheel.cpp
+ * @brief Hierarchical timing wheel used for local relay automation
+ * @author Your Name
+ * @date October 2025
+ */
+
+#include "TimerWheel.h"
+
+TimerWheel::Timer::~Timer() {
+    cancel();
+}
+
+void TimerWheel::Timer::cancel() {
+    if (wheel) {
+        wheel->cancel(*this);
+    }
+}
+
+TimerWheel::TimerWheel()
+    : count(0)
+    , current(0)
+    , started(false)
+{
+}
+
+TimerWheel::~TimerWheel() {
+    for (uint8_t level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (uint8_t index = 0; index < TIMER_WHEEL_SLOTS; index++) {
+            while (slots[level][index].head) {
+                unlink(*slots[level][index].head);
+            }
+        }
+    }
+}
+
+void TimerWheel::begin(uint32_t now) {
+    current = now;
+    started = true;
+}
+
+void TimerWheel::schedule(Timer& timer, uint32_t delayMs) {
+    if (!started) {
+        begin(millis());
+    }
+    scheduleAt(timer, current + delayMs);
+}
+
+void TimerWheel::scheduleAt(Timer& timer, uint32_t expires) {
+    if (timer.wheel) {
+        timer.wheel->cancel(timer);
+    }
+
+    timer.expires = expires;
+    timer.wheel = this;
+    count++;
+    link(timer);
+}
+
+void TimerWheel::cancel(Timer& timer) {
+    if (timer.wheel != this) return;
+    unlink(timer);
+}
+
+size_t TimerWheel::advance(uint32_t now) {
+    size_t fired = 0;
+
+    if (!started) {
+        begin(now);
+    }
+
+    if (!count) {
+        current = now + 1;                                                  // Nothing pending, skip idle ticks
+        return 0;
+    }
+
+    while ((int32_t)(now - current) >= 0) {
+        uint8_t index = current & TIMER_WHEEL_SLOT_MASK;
+        if (index == 0) {
+            cascade(1);
+        }
+
+        // Detach the due slot first so callbacks can freely (re)schedule
+        Slot due;
+        Slot& slot = slots[0][index];
+        while (slot.head) {
+            Timer* timer = slot.head;
+            slot.head = timer->next;
+            timer->prev = timer->next = nullptr;
+            push(due, *timer);
+        }
+
+        current++;                                                          // Timers rescheduled below land in later ticks
+
+        while (due.head) {
+            Timer* timer = due.head;
+            unlink(*timer);
+            fired++;
+            if (timer->callback) {
+                Callback callback = timer->callback;                        // Callback may destroy or reuse the timer
+                callback();
+            }
+        }
+
+        if (!count) {
+            current = now + 1;
+            break;
+        }
+    }
+
+    return fired;
+}
+
+uint32_t TimerWheel::nextDeadline(uint32_t limit) const {
+    if (!count) return limit;
+
+    // Lower bounds from the slot start of higher levels, a slot that cascades
+    // before a level 0 hit can hold an earlier timer
+    uint32_t best = limit;
+    for (uint8_t level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+        uint8_t shift = level * TIMER_WHEEL_SLOT_BITS;
+        uint32_t base = current >> shift;
+        uint32_t first = (current & ((1UL << shift) - 1)) ? 1 : 0;         // On a slot boundary the current slot cascades with the next tick
+
+        for (uint32_t ahead = first; ahead <= TIMER_WHEEL_SLOTS; ahead++) {
+            if (slots[level][(base + ahead) & TIMER_WHEEL_SLOT_MASK].head) {
+                uint32_t start = ((base + ahead) << shift) - current;
+                if (start < best) best = start;
+                break;
+            }
+        }
+    }
+
+    // Exact answer from level 0 up to there
+    for (uint32_t ahead = 0; ahead < TIMER_WHEEL_SLOTS && ahead < best; ahead++) {
+        if (slots[0][(current + ahead) & TIMER_WHEEL_SLOT_MASK].head) {
+            return ahead;
+        }
+    }
+
+    return best;
+}
+
+void TimerWheel::link(Timer& timer) {
+    int32_t remaining = (int32_t)(timer.expires - current);
+    uint32_t delta = remaining < 0 ? 0 : (uint32_t)remaining;
+    uint32_t when = current + delta;
+
+    uint8_t level;
+    uint8_t index;
+
+    if (delta < (1UL << TIMER_WHEEL_SLOT_BITS)) {
+        level = 0;
+        index = when & TIMER_WHEEL_SLOT_MASK;
+    } else if (delta < (1UL << (2 * TIMER_WHEEL_SLOT_BITS))) {
+        level = 1;
+        index = (when >> TIMER_WHEEL_SLOT_BITS) & TIMER_WHEEL_SLOT_MASK;
+    } else if (delta < (1UL << (3 * TIMER_WHEEL_SLOT_BITS))) {
+        level = 2;
+        index = (when >> (2 * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK;
+    } else if (delta < (1UL << (4 * TIMER_WHEEL_SLOT_BITS))) {
+        level = 3;
+        index = (when >> (3 * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK;
+    } else {
+        // Beyond the wheel range: park in the last top-level slot of this
+        // rotation, the cascade relinks it with the remaining delay
+        level = 3;
+        index = ((current >> (3 * TIMER_WHEEL_SLOT_BITS)) + TIMER_WHEEL_SLOT_MASK) & TIMER_WHEEL_SLOT_MASK;
+    }
+
+    push(slots[level][index], timer);
+}
+
+void TimerWheel::unlink(Timer& timer) {
+    Slot* slot = static_cast<Slot*>(timer.slot);
+
+    if (timer.prev) {
+        timer.prev->next = timer.next;
+    } else if (slot) {
+        slot->head = timer.next;
+    }
+    if (timer.next) {
+        timer.next->prev = timer.prev;
+    }
+
+    timer.next = timer.prev = nullptr;
+    timer.slot = nullptr;
+    timer.wheel = nullptr;
+    count--;
+}
+
+void TimerWheel::cascade(uint8_t level) {
+    uint8_t index = (current >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK;
+    Slot& slot = slots[level][index];
+
+    Timer* timer = slot.head;
+    slot.head = nullptr;
+
+    while (timer) {
+        Timer* next = timer->next;
+        timer->prev = timer->next = nullptr;
+        link(*timer);
+        timer = next;
+    }
+
+    if (index == 0 && level + 1 < TIMER_WHEEL_LEVELS) {
+        cascade(level + 1);
+    }
+}
+
+void TimerWheel::push(Slot& slot, Timer& timer) {
+    timer.prev = nullptr;
+    timer.next = slot.head;
+    if (slot.head) {
+        slot.head->prev = &timer;
+    }
+    slot.head = &timer;
+    timer.slot = &slot;
+}
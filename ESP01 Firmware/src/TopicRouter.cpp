@@ -0,0 +1,172 @@
+/**
+ * @file TopicRouter.cpp
+ * @brief Trie based MQTT topic router shared by all controllers on a session
+ * @author Your Name
+ * @date October 2025
+ */
+
+#include "TopicRouter.h"
+
+bool TopicRouter::add(const char* filter, Handler handler, void* owner) {
+    if (!filter || !*filter || !handler) {
+        return false;
+    }
+
+    Node* node = &root;
+    const char* level = filter;
+
+    while (true) {
+        const char* end = strchr(level, '/');
+        size_t length = end ? (size_t)(end - level) : strlen(level);
+
+        // "#" is only valid as the last level of a filter
+        if (length == 1 && level[0] == '#' && end) {
+            return false;
+        }
+
+        node = findChild(*node, level, length, true);
+        if (!end) break;
+        level = end + 1;
+    }
+
+    node->routes.push_back({handler, owner});
+    return true;
+}
+
+void TopicRouter::remove(void* owner) {
+    strip(root, owner);
+    compact();
+}
+
+void TopicRouter::remove(const char* filter, void* owner) {
+    if (!filter || !*filter) return;
+
+    Node* node = &root;
+    const char* level = filter;
+
+    while (node) {
+        const char* end = strchr(level, '/');
+        size_t length = end ? (size_t)(end - level) : strlen(level);
+        node = findChild(*node, level, length, false);
+        if (!end) break;
+        level = end + 1;
+    }
+
+    if (!node) return;
+
+    strip(*node, owner);
+    compact();                                                              // Drop levels left without routes
+}
+
+size_t TopicRouter::dispatch(const char* topic, byte* payload, unsigned int length) {
+    if (!topic) return 0;
+
+    dispatchDepth++;
+    size_t delivered = match(root, topic, topic, payload, length);
+    dispatchDepth--;
+
+    if (!dispatchDepth && prunePending) {
+        compact();
+    }
+    return delivered;
+}
+
+void TopicRouter::compact() {
+    if (dispatchDepth) {
+        prunePending = true;                                                // Nodes may still be walked by dispatch()
+        return;
+    }
+    prunePending = false;
+    prune(root);
+}
+
+void TopicRouter::strip(Node& node, void* owner) {
+    for (size_t i = 0; i < node.routes.size(); ) {
+        if (node.routes[i].owner == owner) {
+            node.routes.erase(node.routes.begin() + i);
+        } else {
+            i++;
+        }
+    }
+
+    for (size_t i = 0; i < node.children.size(); i++) {
+        strip(*node.children[i], owner);
+    }
+}
+
+TopicRouter::Node* TopicRouter::findChild(Node& node, const char* level, size_t length, bool create) {
+    for (auto& child : node.children) {
+        if (child->level.length() == length && strncmp(child->level.c_str(), level, length) == 0) {
+            return child.get();
+        }
+    }
+
+    if (!create) return nullptr;
+
+    std::unique_ptr<Node> child(new Node());
+    child->level.reserve(length);
+    child->level.concat(level, length);
+    node.children.push_back(std::move(child));
+    return node.children.back().get();
+}
+
+bool TopicRouter::prune(Node& node) {
+    for (size_t i = 0; i < node.children.size(); ) {
+        if (prune(*node.children[i])) {
+            node.children.erase(node.children.begin() + i);
+        } else {
+            i++;
+        }
+    }
+
+    return node.routes.empty() && node.children.empty();
+}
+
+size_t TopicRouter::match(const Node& node, const char* level, const char* topic, byte* payload, unsigned int length) const {
+    size_t delivered = 0;
+
+    if (!level) {
+        // Topic fully consumed: exact routes match, and so does a "#" child
+        // because it also covers the parent level ("a/#" matches "a")
+        delivered += deliver(node.routes, topic, payload, length);
+        for (size_t i = 0; i < node.children.size(); i++) {                  // Index loop, handlers may add levels
+            const Node& child = *node.children[i];
+            if (child.level == "#") {
+                delivered += deliver(child.routes, topic, payload, length);
+            }
+        }
+        return delivered;
+    }
+
+    const char* end = strchr(level, '/');
+    size_t levelLength = end ? (size_t)(end - level) : strlen(level);
+    const char* next = end ? end + 1 : nullptr;
+    bool systemTopic = (level == topic && level[0] == '$');                  // Wildcards never match "$SYS"-style topics
+
+    for (size_t i = 0; i < node.children.size(); i++) {
+        const Node& child = *node.children[i];
+        const String& key = child.level;
+
+        if (key == "#") {
+            if (!systemTopic) delivered += deliver(child.routes, topic, payload, length);
+        } else if (key == "+") {
+            if (!systemTopic) delivered += match(child, next, topic, payload, length);
+        } else if (key.length() == levelLength && strncmp(key.c_str(), level, levelLength) == 0) {
+            delivered += match(child, next, topic, payload, length);
+        }
+    }
+
+    return delivered;
+}
+
+size_t TopicRouter::deliver(const std::vector<Route>& routes, const char* topic, byte* payload, unsigned int length) {
+    size_t delivered = 0;
+
+    for (size_t i = 0; i < routes.size(); i++) {
+        Handler handler = routes[i].handler;                                // Copy, handlers may subscribe while running
+        handler(topic, payload, length);
+        delivered++;
+    }
+
+    return delivered;
+}
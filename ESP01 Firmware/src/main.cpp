@@ -1,21 +1,32 @@
 #include <Arduino.h>
 #include <OTADash.h>
 #include <MQTTRelay.h>
+#include <ConnectionManager.h>
+#include <LoopWake.h>
+
+#if __has_include("OTASigningKey.h")
+  #include "OTASigningKey.h"          // scripts/ota_sign.py keygen
+#elif !defined(OTA_ALLOW_UNSIGNED)    // Opting out takes -DOTA_ALLOW_UNSIGNED in build_flags
+  #error "No include/OTASigningKey.h: run scripts/ota_sign.py keygen, or define OTA_ALLOW_UNSIGNED to install unsigned updates"
+#endif
 
 #define RELAY_EEPROM_ADDR           100
 #define RELAY_EEPROM_SIZE           50
 
 OTADash       *otaDash            = nullptr;
 MQTTRelay     *mqttRelay          = nullptr;
-bool          otaModeActive       = false;
+MQTTSession   *mqttSession        = nullptr;
+ConnectionManager *connection     = nullptr;
 bool          relayState          = false;
 
 ChronoLogger  mainLogger("Main", CHRONOLOG_LEVEL_DEBUG);
 
-void connectToWiFi();
-bool readCredentials();
+bool connectToWiFi(const NetworkCredentials& creds);
+void idleFor(uint32_t ms);
+bool readCredentials(NetworkCredentials& creds);
 bool checkButtonPress();
 void initializeOTAMode();
+void initializeMaintenancePortal();
 void initializeMQTTRelay();
 String generateDeviceUUID();
 String generateDeviceName(const String& uuid);
@@ -28,38 +39,87 @@ void setup() {
   randomSeed(analogRead(0) + ESP.getCycleCount());
   
   pinMode(LED_BUILTIN, INPUT_PULLUP);
+  LoopWake::begin();
+
+#if __has_include("OTASigningKey.h")
+  // Portal and MQTT updates then only install images signed with the matching private key
+  OTAVerifier::setPublicKey(OTA_SIGNING_KEY);
+#endif
 
   // Check credentials and button press to determine mode
-  bool hasCredentials = readCredentials();
+  NetworkCredentials creds;
+  bool hasCredentials = readCredentials(creds);
   bool buttonPressed = hasCredentials ? checkButtonPress() : false;
   
-  if (!hasCredentials || buttonPressed) {
-    const char* reason = !hasCredentials ? "No WiFi credentials found" : "Button pressed";
-    mainLogger.warn("%s. Starting in OTA mode.", reason);
+  if (!hasCredentials) {
+    mainLogger.warn("No WiFi credentials found. Starting in OTA mode.");
     initializeOTAMode();
   } else {
     mainLogger.info("Normal mode - Starting MQTT Relay");
+    bool joined = connectToWiFi(creds);
+
+    // Without the station there is no relay to keep running, and only the AP can be reached
+    if (buttonPressed && !joined) {
+      mainLogger.warn("Button pressed but WiFi not connected. Starting in OTA mode.");
+      delete connection;
+      connection = nullptr;
+      initializeOTAMode();
+      return;
+    }
+
+    // Started even without WiFi, the session connects once the link comes up
     pinMode(LED_BUILTIN, OUTPUT);
-    connectToWiFi();
-    
-    // Initialize MQTT Relay if WiFi connected
-    if (WiFi.status() == WL_CONNECTED) {
-      initializeMQTTRelay();
+    initializeMQTTRelay();
+    connection->attach(mqttSession->getTimers(), [](bool up) {
+      mqttSession->setLinkUp(up);
+    });
+
+    // Maintenance keeps the relay online, the portal runs next to it
+    if (buttonPressed) {
+      mainLogger.warn("Button pressed. Starting the portal alongside the relay.");
+      initializeMaintenancePortal();
     }
   }
 }
 
 void loop() {
-  if (!otaModeActive) {
-    // Handle MQTT relay operations
-    if (mqttRelay) {
-      mqttRelay->loop();
-    }
+  uint32_t idle = LOOP_IDLE_MAX_MS;
+
+  // Link changes first, so a session whose WiFi came back reconnects in this pass
+  if (connection) {
+    connection->loop();
   }
+
+  // Relay first, the portal only gets a turn once no command is waiting on the socket
+  if (mqttSession) {
+    mqttSession->loop();
+  }
+  if (mqttRelay) {
+    mqttRelay->loop();
+  }
+  bool commandWaiting = mqttSession && mqttSession->hasInput();
+  if (otaDash && !commandWaiting) {
+    idle = min(idle, otaDash->loop());
+  }
+
+  // Sleep until the next timer or portal job instead of spinning
+  if (commandWaiting) {
+    idle = 0;
+  } else if (mqttSession) {
+    idle = mqttSession->nextDeadline(idle);
+  }
+  idleFor(idle);
+}
+
+void idleFor(uint32_t ms) {
+  // Blocks until the deadline; WiFi events and portal requests notify, broker data is checked while suspended
+  LoopWake::sleep(ms, []() {
+    return (connection && connection->hasEvent()) || (mqttSession && mqttSession->hasInput()) || (otaDash && otaDash->nextDeadline() == 0);
+  });
 }
 
 bool checkButtonPress() {
-  mainLogger.info("Press and hold button for 3 seconds to enter OTA mode...");
+  mainLogger.info("Press and hold button for 3 seconds to open the maintenance portal...");
   
   uint32_t buttonPressStart = 0;
   uint32_t checkStart = millis();
@@ -83,8 +143,19 @@ bool checkButtonPress() {
 
 void initializeOTAMode() {
   otaDash = new OTADash("Wasa_Controller", "", "wasa_controller", "Wasa_Controller Portal");
+  otaDash->onRestart(MQTTRelay::prepareRestart);
+  otaDash->onWake(LoopWake::notify);
   otaDash->begin(NetworkMode::ACCESS_POINT);
-  otaModeActive = true;
+}
+
+void initializeMaintenancePortal() {
+  otaDash = new OTADash("Wasa_Controller", "", "wasa_controller", "Wasa_Controller Portal");
+  otaDash->onRestart(MQTTRelay::prepareRestart);
+  otaDash->onWake(LoopWake::notify);                      // Requests arm portal jobs, a sleeping loop() picks them up
+  otaDash->setAutoReconnect(false);                       // The connection manager looks after the station
+  otaDash->setHeapReserve(PORTAL_HEAP_RESERVE);
+  otaDash->setJobsPerLoop(PORTAL_JOBS_PER_LOOP);
+  otaDash->begin(PORTAL_DUAL_AP ? NetworkMode::DUAL : NetworkMode::STATION);
 }
 
 void initializeMQTTRelay() {
@@ -97,13 +168,18 @@ void initializeMQTTRelay() {
   mainLogger.info("Generated Device UUID: %s", deviceUUID.c_str());
   mainLogger.info("Generated Device Name: %s", deviceName.c_str());
   
-  mqttRelay = new MQTTRelay(LED_BUILTIN, deviceUUID.c_str(), deviceName.c_str());
+  // One session carries every relay controller on this device
+  mqttSession = new MQTTSession(deviceUUID.c_str());
+  mqttSession->begin();
+  mqttRelay = new MQTTRelay(*mqttSession, LED_BUILTIN, deviceUUID.c_str(), deviceName.c_str());
   
   if (mqttRelay->begin()) {
     mainLogger.info("MQTT Relay Controller initialized successfully");
     
     // Attempt initial connection
-    if (mqttRelay->connect()) {
+    if (!connection->isUp()) {
+      mainLogger.warn("WiFi not connected - MQTT connects once the link is up");
+    } else if (mqttSession->connect()) {
       mainLogger.info("Connected to MQTT broker");
     } else {
       mainLogger.warn("Failed initial MQTT connection - will retry automatically");
@@ -113,39 +189,13 @@ void initializeMQTTRelay() {
   }
 }
 
-void connectToWiFi() {
-  NetworkCredentials creds = otaDash ? otaDash->getNetworkCredentials() : NetworkCredentials{};
-  
-  // If using OTADash, get credentials from it, otherwise read from EEPROM
-  if (!otaDash) {
-    EEPROM.begin(OTA_DASH_EEPROM_SIZE);
-    EEPROM.get(OTA_DASH_EEPROM_ADDR, creds);
-    EEPROM.end();
-  }
-
-  if (strlen(creds.ssid) == 0) {
-    mainLogger.error("SSID is empty, cannot connect to WiFi");
-    return;
-  }
-
-  mainLogger.info("Connecting to WiFi SSID: %s", creds.ssid);
-  WiFi.begin(creds.ssid, creds.password);
-
-  uint32_t startTime = millis();
-  while (WiFi.status() != WL_CONNECTED && millis() - startTime < 10000) {
-    delay(500);
-    mainLogger.info("Attempting to connect...");
-  }
-
-  if (WiFi.status() == WL_CONNECTED) {
-    mainLogger.info("Connected to WiFi! IP address: %s", WiFi.localIP().toString().c_str());
-  } else {
-    mainLogger.error("Failed to connect to WiFi after 10 seconds");
-  }
+bool connectToWiFi(const NetworkCredentials& creds) {
+  // Stays in charge of the station after setup(), see loop()
+  connection = new ConnectionManager();
+  return connection->begin(creds.ssid, creds.password, WIFI_CONNECT_TIMEOUT);
 }
 
-bool readCredentials() {
-  NetworkCredentials creds;
+bool readCredentials(NetworkCredentials& creds) {
   EEPROM.begin(OTA_DASH_EEPROM_SIZE);
   EEPROM.get(OTA_DASH_EEPROM_ADDR, creds);
   EEPROM.end();
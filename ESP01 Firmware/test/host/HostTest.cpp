@@ -0,0 +1,11 @@
+#include "HostTest.h"
+#include <Arduino.h>
+
+uint64_t hostMicros = 0;
+int hostFailures = 0;
+
+int main() {
+    runTests();
+    printf("%s: %s\n", hostTestName, hostFailures ? "FAILED" : "passed");
+    return hostFailures ? 1 : 0;
+}
@@ -0,0 +1,29 @@
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+// Minimal check macros for the host tests, a binary exits non-zero when any check failed
+
+#include <stdio.h>
+
+extern int hostFailures;
+
+#define CHECK(cond) do { \
+        if (!(cond)) { \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            hostFailures++; \
+        } \
+    } while (0)
+
+#define CHECK_EQ(a, b) do { \
+        long long _a = (long long)(a), _b = (long long)(b); \
+        if (_a != _b) { \
+            printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n", __FILE__, __LINE__, #a, #b, _a, _b); \
+            hostFailures++; \
+        } \
+    } while (0)
+
+// Each test binary defines these, HostTest.cpp runs them and reports
+extern const char* const hostTestName;
+void runTests();
+
+#endif // HOST_TEST_H
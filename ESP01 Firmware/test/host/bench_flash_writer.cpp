@@ -0,0 +1,141 @@
+// OTAFlashWriter throughput against a fake NOR flash
+//
+// A sender thread stands in for the TCP callback and delivers 1436 B segments
+// at a fixed WiFi rate, the loop thread calls service() like the portal does.
+// The fake flash erases and programs every 4 KB sector with datasheet timings,
+// so the numbers show how much of the erase time the two sectors hide. The old
+// path, every segment straight into an Updater-like buffer, runs on the sender.
+// Built in the ESP32 shape (two sectors, two tasks); hashing is left out. An
+// ESP8266 build has one sector and one context, nothing overlaps there, so it
+// has nothing to measure here.
+//
+//   make -C test/host bench [BENCH_ARGS="<image KB> <erase ms> <page ms>"]
+
+#include "OTAFlashWriter.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock Clock;
+
+uint64_t hostMicros = 0;
+
+void OTASha256::begin() {}
+void OTASha256::update(const uint8_t*, size_t) {}
+void OTASha256::finish(uint8_t digest[OTA_PATCH_SHA256_SIZE]) { memset(digest, 0, OTA_PATCH_SHA256_SIZE); }
+
+static const size_t SEGMENT = 1436;                                 // One TCP segment at the default MSS
+static double eraseMs = 30.0;                                       // W25Q32 class: sector erase
+static double pageMs  = 0.4;                                        // and 256 B page program, typical
+
+static void busy(double ms) {
+    Clock::time_point end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(ms));
+    while (Clock::now() < end) {}
+}
+
+// Updater-like: buffers to a sector, erases and programs it when full
+struct FakeFlash {
+    std::vector<uint8_t>    image;
+    std::vector<uint8_t>    buffer;
+
+    void write(const uint8_t* data, size_t len) {
+        buffer.insert(buffer.end(), data, data + len);
+        while (buffer.size() >= OTA_FLASH_SECTOR) {
+            program(OTA_FLASH_SECTOR);
+        }
+    }
+
+    void end() {
+        if (!buffer.empty()) program(buffer.size());
+    }
+
+    void program(size_t len) {
+        busy(eraseMs + pageMs * ((len + 255) / 256));
+        image.insert(image.end(), buffer.begin(), buffer.begin() + len);
+        buffer.erase(buffer.begin(), buffer.begin() + len);
+    }
+};
+
+static double direct(const std::vector<uint8_t>& source, double wifiMBs) {
+    double segmentMs = SEGMENT / (wifiMBs * 1e3);
+    FakeFlash flash;
+
+    Clock::time_point start = Clock::now();
+    for (size_t offset = 0; offset < source.size(); offset += SEGMENT) {
+        busy(segmentMs);
+        flash.write(&source[offset], std::min(SEGMENT, source.size() - offset));
+    }
+    flash.end();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (flash.image != source) {
+        printf("direct: image mismatch\n");
+        exit(1);
+    }
+    return source.size() / seconds / 1e6;
+}
+
+static double pipelined(const std::vector<uint8_t>& source, double wifiMBs) {
+    double segmentMs = SEGMENT / (wifiMBs * 1e3);
+    FakeFlash flash;
+    OTAFlashWriter writer;
+    writer.begin([&flash](const uint8_t* data, size_t len, bool last) {
+        flash.write(data, len);
+        if (last) flash.end();
+        return true;
+    });
+
+    std::atomic<bool> done(false);
+    Clock::time_point start = Clock::now();
+    std::thread loop([&]() {
+        while (!done || writer.pending()) {
+            writer.service();
+            std::this_thread::yield();
+        }
+    });
+
+    for (size_t offset = 0; offset < source.size(); ) {
+        busy(segmentMs);
+        size_t len = std::min(SEGMENT, source.size() - offset);
+        size_t taken = 0;
+        while (taken < len) {                                       // Both sectors wait for flash: TCP back-pressure
+            taken += writer.write(&source[offset + taken], len - taken);
+            if (taken < len) std::this_thread::yield();
+        }
+        offset += len;
+    }
+    while (!writer.finish()) std::this_thread::yield();
+    done = true;
+    loop.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (!writer.complete() || flash.image != source) {
+        printf("sector writer: image mismatch\n");
+        exit(1);
+    }
+    writer.end();
+    return source.size() / seconds / 1e6;
+}
+
+int main(int argc, char** argv) {
+    size_t size = (argc > 1 ? atoi(argv[1]) : 256) * 1024;
+    if (argc > 2) eraseMs = atof(argv[2]);
+    if (argc > 3) pageMs = atof(argv[3]);
+
+    std::vector<uint8_t> source(size);
+    for (size_t i = 0; i < size; i++) {
+        source[i] = (uint8_t)(i * 31 + (i >> 9));
+    }
+
+    double flashMBs = OTA_FLASH_SECTOR / ((eraseMs + pageMs * OTA_FLASH_SECTOR / 256) * 1e3);
+    printf("image %zu KB, flash %.3f MB/s (erase %.1f ms, page %.2f ms)\n", size / 1024, flashMBs, eraseMs, pageMs);
+    for (double wifi : {0.1, 0.25, 0.5, 1.0}) {
+        double before = direct(source, wifi);
+        double after = pipelined(source, wifi);
+        printf("wifi %.2f MB/s: direct %.3f MB/s, sector writer %.3f MB/s\n", wifi, before, after);
+    }
+    return 0;
+}
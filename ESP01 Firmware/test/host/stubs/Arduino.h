@@ -0,0 +1,26 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+// Just enough of the Arduino core to build the hardware-independent firmware
+// modules on the host. Time is simulated: tests move it with hostAdvance().
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <algorithm>
+
+typedef uint8_t byte;
+
+using std::min;
+using std::max;
+
+extern uint64_t hostMicros;
+
+inline unsigned long micros()                   { return (unsigned long)hostMicros; }
+inline unsigned long millis()                   { return (unsigned long)(hostMicros / 1000); }
+inline void hostAdvance(uint32_t ms)            { hostMicros += (uint64_t)ms * 1000; }
+inline void hostSetMillis(uint32_t ms)          { hostMicros = (uint64_t)ms * 1000; }
+inline void yield()                             {}
+inline void delay(unsigned long ms)             { hostAdvance(ms); }
+
+#endif // HOST_ARDUINO_H
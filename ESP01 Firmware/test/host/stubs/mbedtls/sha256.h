@@ -0,0 +1,12 @@
+#ifndef HOST_MBEDTLS_SHA256_H
+#define HOST_MBEDTLS_SHA256_H
+
+// Context type only, so OTAPatch.h builds in its ESP32 shape; hosts provide OTASha256 themselves
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t    state[8];
+} mbedtls_sha256_context;
+
+#endif // HOST_MBEDTLS_SHA256_H
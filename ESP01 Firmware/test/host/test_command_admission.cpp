@@ -0,0 +1,154 @@
+// CommandAdmission: token buckets, coalescing window, throttling and a downlink flood
+
+#include "HostTest.h"
+#include "CommandAdmission.h"
+
+const char* const hostTestName = "command_admission";
+
+// Stands in for MQTTRelay: what the admission stage decides and what reaches the relay
+struct Controller {
+    TimerWheel          wheel;
+    CommandAdmission    admission;
+    bool                relay       = false;
+    uint32_t            actuations  = 0;
+    uint32_t            settled     = 0;
+    uint32_t            dropped     = 0;
+
+    Controller() : admission(wheel) {
+        wheel.begin(millis());
+        admission.begin([this]() {
+            return relay;
+        }, [this](bool state) {
+            settled++;
+            set(state);
+        }, [this](uint32_t count) {
+            dropped += count;
+        });
+    }
+
+    void set(bool state) {
+        if (relay != state) actuations++;
+        relay = state;
+    }
+
+    CommandAdmission::Verdict request(bool state) {
+        CommandAdmission::Verdict verdict = admission.admitState(state, relay);
+        if (verdict == CommandAdmission::ADMIT_APPLY) {
+            set(state);
+        }
+        return verdict;
+    }
+
+    void run(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            hostAdvance(1);
+            wheel.advance(millis());
+        }
+    }
+};
+
+static void testBurstThenThrottled() {
+    hostSetMillis(10000);
+    Controller c;
+
+    // ADMISSION_ACT_BURST changes spaced past the window, then the budget is gone
+    for (int i = 0; i < ADMISSION_ACT_BURST; i++) {
+        CHECK_EQ(c.request(i % 2 == 0), CommandAdmission::ADMIT_APPLY);
+        c.run(ADMISSION_COALESCE_MS + 10);
+    }
+    CHECK_EQ(c.actuations, ADMISSION_ACT_BURST);
+
+    bool next = !c.relay;
+    CHECK_EQ(c.request(next), CommandAdmission::ADMIT_THROTTLED);
+    CHECK(c.relay != next);
+    CHECK(!c.admission.hasPending());                       // Refused, not deferred
+
+    CHECK_EQ(c.request(c.relay), CommandAdmission::ADMIT_APPLY);    // Unchanged state costs nothing
+
+    c.run(ADMISSION_ACT_REFILL_MS);
+    CHECK_EQ(c.request(next), CommandAdmission::ADMIT_APPLY);
+    CHECK_EQ(c.relay, next);
+}
+
+static void testWindowCoalescesToLast() {
+    hostSetMillis(20000);
+    Controller c;
+
+    CHECK_EQ(c.request(true), CommandAdmission::ADMIT_APPLY);
+    CHECK_EQ(c.request(false), CommandAdmission::ADMIT_COALESCED);
+    CHECK_EQ(c.request(true), CommandAdmission::ADMIT_COALESCED);
+    CHECK_EQ(c.request(false), CommandAdmission::ADMIT_COALESCED);
+    CHECK(c.admission.hasPending());
+    CHECK(c.relay);
+
+    c.run(ADMISSION_COALESCE_MS);
+    CHECK(!c.admission.hasPending());
+    CHECK(!c.relay);
+    CHECK_EQ(c.settled, 1);
+    CHECK_EQ(c.actuations, 2);
+}
+
+static void testUnchangedTargetSpendsNoToken() {
+    hostSetMillis(30000);
+    Controller c;
+
+    // Spend the whole burst, the last change opens a window
+    for (int i = 0; i < ADMISSION_ACT_BURST; i++) {
+        CHECK_EQ(c.request(i % 2 == 0), CommandAdmission::ADMIT_APPLY);
+        if (i < ADMISSION_ACT_BURST - 1) c.run(ADMISSION_COALESCE_MS + 10);
+    }
+
+    // A burst inside it that ends where it started settles without waiting for a token
+    bool start = c.relay;
+    CHECK_EQ(c.request(!start), CommandAdmission::ADMIT_COALESCED);
+    CHECK_EQ(c.request(start), CommandAdmission::ADMIT_COALESCED);
+    uint32_t before = c.actuations;
+    c.run(ADMISSION_COALESCE_MS + 1);                       // Wheel runs 1 ms ahead after an advance
+    CHECK_EQ(c.settled, 1);
+    CHECK_EQ(c.actuations, before);
+    CHECK_EQ(c.relay, start);
+    CHECK(!c.admission.hasPending());
+
+    // So the first refilled token is still there for a real change
+    c.run(ADMISSION_ACT_REFILL_MS);
+    CHECK_EQ(c.request(!start), CommandAdmission::ADMIT_APPLY);
+}
+
+static void testFlood() {
+    hostSetMillis(40000);
+    Controller c;
+
+    const int count = 5000;
+    uint32_t admitted = 0, applied = 0, coalesced = 0, throttled = 0;
+    bool lastAccepted = c.relay;
+
+    // 5000 alternating set_state commands spread over one second
+    for (int i = 0; i < count; i++) {
+        if (i % 5 == 0) c.run(1);
+        if (!c.admission.acceptMessage()) continue;
+
+        admitted++;
+        bool state = i % 2;
+        switch (c.request(state)) {
+            case CommandAdmission::ADMIT_APPLY:     applied++;   lastAccepted = state; break;
+            case CommandAdmission::ADMIT_COALESCED: coalesced++; lastAccepted = state; break;
+            case CommandAdmission::ADMIT_THROTTLED: throttled++; break;
+        }
+    }
+    c.run(2000);                                            // Drain the window and the drop report
+
+    printf("flood: %d commands, %u admitted (%u applied, %u coalesced, %u throttled), %u dropped, %u actuations\n",
+           count, admitted, applied, coalesced, throttled, c.dropped, c.actuations);
+
+    CHECK(admitted <= ADMISSION_MSG_BURST + 1000 / ADMISSION_MSG_REFILL_MS + 1);
+    CHECK_EQ(c.dropped, count - admitted);
+    CHECK(c.actuations <= ADMISSION_ACT_BURST + 3000 / ADMISSION_ACT_REFILL_MS + 1);
+    CHECK_EQ(c.relay, lastAccepted);                        // Last writer wins
+}
+
+void runTests() {
+    testBurstThenThrottled();
+    testWindowCoalescesToLast();
+    testUnchangedTargetSpendsNoToken();
+    testFlood();
+}
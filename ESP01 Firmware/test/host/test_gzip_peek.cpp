@@ -0,0 +1,135 @@
+// OTAGzipPeek: first bytes of gzip streams from zlib, every block type, truncated input
+
+#include "HostTest.h"
+#include "OTAGzipPeek.h"
+#include <random>
+#include <vector>
+#include <zlib.h>
+
+const char* const hostTestName = "gzip_peek";
+
+static std::vector<uint8_t> gzip(const std::vector<uint8_t>& data, int level, int strategy = Z_DEFAULT_STRATEGY) {
+    z_stream stream = {};
+    deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 9, strategy);                // +16: gzip wrapper
+    std::vector<uint8_t> out(deflateBound(&stream, data.size()) + 64);
+    stream.next_in   = const_cast<uint8_t*>(data.data());
+    stream.avail_in  = data.size();
+    stream.next_out  = out.data();
+    stream.avail_out = out.size();
+    deflate(&stream, Z_FINISH);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return out;
+}
+
+// Looks like a patch: magic, header fields, then op stream with repeats
+static std::vector<uint8_t> patchLike(size_t size) {
+    std::vector<uint8_t> data(size);
+    std::mt19937 rng(size);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = i % 97 < 40 ? (uint8_t)(i / 97) : (uint8_t)rng();
+    }
+    memcpy(data.data(), "ODP1", 4);
+    return data;
+}
+
+static size_t peekGzip(const std::vector<uint8_t>& gz, size_t inputLen, uint8_t* out, size_t want) {
+    size_t header = OTAGzipPeek::headerLength(gz.data(), gz.size());
+    CHECK_EQ(header, 10);
+    return OTAGzipPeek::peek(gz.data() + header, std::min(inputLen, gz.size()) - header, out, want);
+}
+
+static void testEveryLevelAndStrategy() {
+    std::vector<uint8_t> data = patchLike(50000);
+    const int strategies[] = { Z_DEFAULT_STRATEGY, Z_FIXED, Z_HUFFMAN_ONLY, Z_RLE, Z_FILTERED };
+
+    for (int level = 0; level <= 9; level++) {
+        for (int strategy : strategies) {
+            std::vector<uint8_t> gz = gzip(data, level, strategy);
+            uint8_t out[64] = {};
+            CHECK_EQ(peekGzip(gz, gz.size(), out, sizeof(out)), sizeof(out));
+            CHECK(memcmp(out, data.data(), sizeof(out)) == 0);
+        }
+    }
+}
+
+static void testBackReferences() {
+    std::vector<uint8_t> data(4096, 0xAB);                                          // Almost all of it one match
+    data[0] = 0xE9;
+    std::vector<uint8_t> gz = gzip(data, 9);
+
+    uint8_t out[300] = {};
+    CHECK_EQ(peekGzip(gz, gz.size(), out, sizeof(out)), sizeof(out));
+    CHECK(memcmp(out, data.data(), sizeof(out)) == 0);
+}
+
+static void testTruncatedInput() {
+    std::vector<uint8_t> data = patchLike(50000);
+    std::vector<uint8_t> gz = gzip(data, 9);
+
+    // Too little for the dynamic tables: nothing decoded, never bytes that are not in the stream
+    uint8_t out[4] = {};
+    CHECK_EQ(peekGzip(gz, 20, out, sizeof(out)), 0);
+    CHECK_EQ(peekGzip(gz, 1400, out, sizeof(out)), sizeof(out));
+    CHECK(memcmp(out, "ODP1", 4) == 0);
+}
+
+static void testHeaderFields() {
+    std::vector<uint8_t> data = patchLike(1000);
+    std::vector<uint8_t> gz = gzip(data, 6);
+
+    // FEXTRA and FNAME between the fixed header and the deflate data
+    std::vector<uint8_t> named(gz.begin(), gz.begin() + 10);
+    named[3] |= 0x04 | 0x08;
+    const uint8_t extra[] = { 4, 0, 'O', 'D', 0, 0 };
+    named.insert(named.end(), extra, extra + sizeof(extra));
+    const char name[] = "update.patch";
+    named.insert(named.end(), name, name + sizeof(name));
+    named.insert(named.end(), gz.begin() + 10, gz.end());
+
+    size_t header = OTAGzipPeek::headerLength(named.data(), named.size());
+    CHECK_EQ(header, 10 + sizeof(extra) + sizeof(name));
+    uint8_t out[4] = {};
+    CHECK_EQ(OTAGzipPeek::peek(named.data() + header, named.size() - header, out, sizeof(out)), 4);
+    CHECK(memcmp(out, "ODP1", 4) == 0);
+
+    CHECK_EQ(OTAGzipPeek::headerLength(data.data(), data.size()), 0);              // Not gzip
+    CHECK_EQ(OTAGzipPeek::headerLength(named.data(), 14), 0);                      // Header split across chunks
+}
+
+static void testCorruptStreams() {
+    std::mt19937 rng(7);
+    uint8_t out[16];
+    for (int i = 0; i < 2000; i++) {
+        uint8_t junk[64];
+        for (uint8_t& byte : junk) byte = rng();
+        CHECK(OTAGzipPeek::peek(junk, sizeof(junk), out, sizeof(out)) <= sizeof(out));
+    }
+}
+
+static void testCompressedImageError() {
+    std::vector<uint8_t> image = patchLike(20000);
+    image[0] = 0xE9;
+    std::vector<uint8_t> gzImage = gzip(image, 9);
+    CHECK(OTAGzipPeek::compressedImageError(gzImage.data(), gzImage.size()) == nullptr);
+    CHECK(OTAGzipPeek::compressedImageError(image.data(), image.size()) == nullptr);          // Plain, not this check's business
+
+    std::vector<uint8_t> patch = patchLike(20000);
+    std::vector<uint8_t> gzPatch = gzip(patch, 9);
+    const char* error = OTAGzipPeek::compressedImageError(gzPatch.data(), gzPatch.size());
+    CHECK(error && strstr(error, "ESP32"));
+
+    std::vector<uint8_t> junk(20000, 0x42);
+    std::vector<uint8_t> gzJunk = gzip(junk, 6);
+    CHECK(OTAGzipPeek::compressedImageError(gzJunk.data(), gzJunk.size()) != nullptr);
+    CHECK(OTAGzipPeek::compressedImageError(gzPatch.data(), 16) != nullptr);                  // Cut short: refused, not waved through
+}
+
+void runTests() {
+    testEveryLevelAndStrategy();
+    testBackReferences();
+    testTruncatedInput();
+    testHeaderFields();
+    testCorruptStreams();
+    testCompressedImageError();
+}
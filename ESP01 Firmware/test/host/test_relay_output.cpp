@@ -0,0 +1,148 @@
+// FakeRelayOutput: logical to physical mapping and batched bus writes
+
+#include "HostTest.h"
+#include "RelayOutput.h"
+
+const char* const hostTestName = "relay_output";
+
+static void testUnbatchedWritesCommitAtOnce() {
+    FakeRelayOutput board(8);
+    CHECK(board.begin());
+    CHECK_EQ(board.transactions().size(), 1);                   // begin() drives every channel once
+    CHECK_EQ(board.transactions()[0].changed, 0xFF);
+    board.clear();
+
+    board.write(3, true);
+    CHECK_EQ(board.transactions().size(), 1);
+    CHECK_EQ(board.transactions()[0].levels, 0x08);
+    CHECK_EQ(board.transactions()[0].changed, 0x08);
+    CHECK(board.read(3));
+
+    board.write(3, true);                                       // Unchanged, no bus write
+    CHECK_EQ(board.transactions().size(), 1);
+}
+
+static void testActiveLowInversion() {
+    FakeRelayOutput board(4, true);
+    CHECK(board.begin());
+    CHECK_EQ(board.transactions()[0].levels, 0x0F);             // All off means all high
+    board.clear();
+
+    board.write(1, true);
+    CHECK_EQ(board.transactions()[0].levels, 0x0D);
+    CHECK(board.read(1));
+    CHECK(!board.read(0));
+}
+
+static void testBatchCoalescesAcrossOutputs() {
+    FakeRelayOutput first(8);
+    FakeRelayOutput second(16);
+    first.begin();
+    second.begin();
+    first.clear();
+    second.clear();
+
+    {
+        RelayOutput::Batch outer;
+        first.write(0, true);
+        first.write(1, true);
+        {
+            RelayOutput::Batch inner;
+            second.write(9, true);
+        }
+        CHECK(first.transactions().empty());                    // Nested scope ends, outer still holds
+        CHECK(second.transactions().empty());
+        first.write(1, false);
+    }
+
+    CHECK_EQ(first.transactions().size(), 1);
+    CHECK_EQ(first.transactions()[0].levels, 0x01);
+    CHECK_EQ(first.transactions()[0].changed, 0x01);
+    CHECK_EQ(second.transactions().size(), 1);
+    CHECK_EQ(second.transactions()[0].levels, 0x200);
+}
+
+static void testBeginEndBatchMatchScope() {
+    FakeRelayOutput board(8);
+    board.begin();
+    board.clear();
+
+    RelayOutput::beginBatch();
+    RelayOutput::beginBatch();                                  // One per dispatch listener
+    board.write(2, true);
+    board.write(5, true);
+    RelayOutput::endBatch();
+    CHECK(board.transactions().empty());
+    RelayOutput::endBatch();
+    CHECK_EQ(board.transactions().size(), 1);
+    CHECK_EQ(board.transactions()[0].changed, 0x24);
+
+    RelayOutput::endBatch();                                    // Unbalanced end is ignored
+    board.write(2, false);
+    CHECK_EQ(board.transactions().size(), 2);
+}
+
+static void testRevertedWriteSkipsBus() {
+    FakeRelayOutput board(8);
+    board.begin();
+    board.clear();
+
+    {
+        RelayOutput::Batch batch;
+        board.write(4, true);
+        board.write(4, false);
+    }
+    CHECK(board.transactions().empty());
+}
+
+static void testDestroyedOutputLeavesBatch() {
+    FakeRelayOutput kept(8);
+    kept.begin();
+    kept.clear();
+
+    {
+        RelayOutput::Batch batch;
+        FakeRelayOutput* dropped = new FakeRelayOutput(8);
+        dropped->begin();
+        dropped->write(0, true);
+        kept.write(0, true);
+        delete dropped;
+    }
+    CHECK_EQ(kept.transactions().size(), 1);
+}
+
+static void testTransactionsCarryTime() {
+    FakeRelayOutput board(8);
+    board.begin();
+    board.clear();
+
+    hostSetMillis(1000);
+    board.write(0, true);
+    hostAdvance(5);
+    board.write(0, false);
+    CHECK_EQ(board.transactions()[0].timeUs, 1000000);
+    CHECK_EQ(board.transactions()[1].timeUs, 1005000);
+}
+
+static void testChannelsOutOfRange() {
+    FakeRelayOutput board(40);
+    CHECK_EQ(board.channels(), RELAY_OUTPUT_MAX_CHANNELS);
+    board.begin();
+    CHECK_EQ(board.transactions()[0].changed, 0xFFFFFFFFUL);
+    board.clear();
+
+    board.write(32, true);
+    CHECK(board.transactions().empty());
+    CHECK(!board.read(32));
+}
+
+void runTests() {
+    testUnbatchedWritesCommitAtOnce();
+    testActiveLowInversion();
+    testBatchCoalescesAcrossOutputs();
+    testBeginEndBatchMatchScope();
+    testRevertedWriteSkipsBus();
+    testDestroyedOutputLeavesBatch();
+    testTransactionsCarryTime();
+    testChannelsOutOfRange();
+}
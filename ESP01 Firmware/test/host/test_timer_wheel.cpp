@@ -0,0 +1,137 @@
+// TimerWheel: firing accuracy under load, across every level and the millis() wrap
+
+#include "HostTest.h"
+#include "TimerWheel.h"
+#include "MQTTConfig.h"
+#include <random>
+#include <vector>
+
+const char* const hostTestName = "timer_wheel";
+
+static const uint32_t LOAD_MAX_MS   = 20;                           // Longest a callback or other loop() work keeps the CPU
+
+struct Probe {
+    TimerWheel::Timer   timer;
+    uint32_t            due         = 0;
+    uint32_t            fired       = 0;
+    uint32_t            repeats     = 0;
+};
+
+static uint32_t now() {
+    return (uint32_t)millis();
+}
+
+// Mixed delays so timers land in level 0 and cascade down from every higher level
+static uint32_t randomDelay(std::mt19937& rng) {
+    switch (rng() % 5) {
+        case 0:  return rng() % 64;
+        case 1:  return rng() % 4096;
+        case 2:  return rng() % 300000;
+        case 3:  return rng() % 20000000;
+        default: return rng() % 40000000;
+    }
+}
+
+// Same arithmetic as MQTTSession::nextDeadline(), the wheel may lag or lead millis()
+static uint32_t sleepFor(const TimerWheel& wheel, uint32_t limit) {
+    int64_t wait = (int64_t)wheel.nextDeadline(limit) + (int32_t)(wheel.now() - now());
+    return wait < 0 ? 0 : std::min<int64_t>(wait, limit);
+}
+
+static void runLoaded(uint32_t start) {
+    hostSetMillis(start);
+    TimerWheel wheel;
+    wheel.begin(now());
+    std::mt19937 rng(start + 1);
+
+    const int count = 3000;
+    std::vector<Probe> probes(count);
+    uint32_t pass = start;                                          // now() handed to advance()
+    uint32_t carried = 0, busy = 0;                                 // Time spent working in the previous and this pass
+    uint32_t offTick = 0, early = 0, late = 0, worst = 0;
+
+    for (int i = 0; i < count; i++) {
+        bool periodic = i % 10 == 0;
+        probes[i].timer.setCallback([&, i, periodic]() {
+            Probe& p = probes[i];
+            if (wheel.now() - 1 != p.due) offTick++;                // The wheel runs exactly the due tick
+            int32_t lateness = (int32_t)(pass - p.due);
+            if (lateness < 0) early++;
+            else if ((uint32_t)lateness > carried) late++;          // Only a busy previous pass may delay it
+            if (lateness > 0 && (uint32_t)lateness > worst) worst = lateness;
+            p.fired++;
+
+            if (i % 7 == 0) {
+                uint32_t load = rng() % (LOAD_MAX_MS + 1);
+                hostAdvance(load);
+                busy += load;
+            }
+            if (periodic && p.repeats < 20) {                       // Re-arms itself from inside the callback
+                p.repeats++;
+                uint32_t delay = 1 + rng() % 2000;
+                p.due = wheel.now() + delay;
+                wheel.schedule(p.timer, delay);
+            }
+        });
+        uint32_t delay = randomDelay(rng);
+        probes[i].due = start + delay;
+        wheel.schedule(probes[i].timer, delay);
+    }
+
+    // Same shape as loop(): other work, then sleep until the next deadline unless woken sooner
+    while (wheel.size()) {
+        if (rng() % 3 == 0) {
+            uint32_t load = rng() % (LOAD_MAX_MS + 1);
+            hostAdvance(load);
+            busy += load;
+        }
+        uint32_t sleep = sleepFor(wheel, LOOP_IDLE_MAX_MS);
+        uint32_t wake = rng() % 4 == 0 ? rng() % (sleep + 1) : sleep;  // Broker data or a WiFi event
+        hostAdvance(wake);
+
+        pass = now();
+        carried = busy;
+        busy = 0;
+        wheel.advance(pass);
+    }
+
+    uint32_t missed = 0;
+    for (int i = 0; i < count; i++) {
+        if (probes[i].fired != (i % 10 == 0 ? 21u : 1u)) missed++;
+    }
+
+    printf("start %u: worst lateness %u ms, none past the time the loop was busy\n", start, worst);
+    CHECK_EQ(offTick, 0);
+    CHECK_EQ(early, 0);
+    CHECK_EQ(late, 0);
+    CHECK_EQ(missed, 0);
+}
+
+static void testCancelledNeverFires() {
+    hostSetMillis(5000);
+    TimerWheel wheel;
+    wheel.begin(now());
+
+    uint32_t fired = 0;
+    TimerWheel::Timer near, far;
+    near.setCallback([&]() { fired++; });
+    far.setCallback([&]() { fired++; });
+    wheel.schedule(near, 10);
+    wheel.schedule(far, 100000);
+    near.cancel();
+    wheel.cancel(far);
+    CHECK(!near.isActive());
+    CHECK(!far.isActive());
+
+    hostAdvance(200000);
+    wheel.advance(now());
+    CHECK_EQ(fired, 0);
+    CHECK_EQ(wheel.size(), 0);
+}
+
+void runTests() {
+    for (uint32_t start : {0u, 4095u, 4096u, 262143u, 123457u, 0xFFFFF000u}) {
+        runLoaded(start);
+    }
+    testCancelledNeverFires();
+}
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""
+Command-to-ack latency probe for MQTT relay devices
+Sends set_state commands to one device (real or esp32_simulator.py) and
+reports the round trip from publish to ack, plus the device-side processing
+time ("proc_us") when the firmware reports it.
+
+Before/after comparison against the simulator:
+    python esp32_simulator.py --inline-commit    # ack waits on the flash commit
+    python esp32_simulator.py                    # deferred commit
+    python ack_latency.py --device AABBCCDDEEF1 --count 50
+
+Flood benchmark (admission stage): publish a burst first, then probe how
+quickly the device still answers and how the burst was admitted:
+    python ack_latency.py --device AABBCCDDEEF1 --flood 5000 --count 20
+"""
+
+import json
+import time
+import ssl
+import argparse
+import threading
+import statistics
+import paho.mqtt.client as mqtt
+
+# Configuration (same broker and certificates as esp32_simulator.py)
+MQTT_BROKER = "localhost"
+MQTT_PORT = 8883
+CA_CERT = "server/certs/ca.crt"
+CLIENT_CERT = "server/certs/client.crt"
+CLIENT_KEY = "server/certs/client.key"
+
+UPLINK_TOPIC = "ControlDevice/Uplink/"
+DOWNLINK_TOPIC = "ControlDevice/Downlink/"
+
+
+class AckLatencyProbe:
+    def __init__(self, device_uuid, broker, port):
+        self.device_uuid = device_uuid
+        self.broker = broker
+        self.port = port
+        self.ack = None
+        self.ack_event = threading.Event()
+        self.expected_state = None
+        self.outcomes = {}
+        self.client = mqtt.Client(callback_api_version=mqtt.CallbackAPIVersion.VERSION2)
+        self.client.tls_set(
+            ca_certs=CA_CERT,
+            certfile=CLIENT_CERT,
+            keyfile=CLIENT_KEY,
+            cert_reqs=ssl.CERT_REQUIRED,
+            tls_version=ssl.PROTOCOL_TLS
+        )
+        self.client.on_message = self.on_message
+
+    def on_message(self, client, userdata, msg):
+        try:
+            data = json.loads(msg.payload.decode())
+        except ValueError:
+            return
+        if data.get("command") != "ack":
+            return
+        outcome = data.get("admission", "applied" if data.get("success") else "failed")
+        self.outcomes[outcome] = self.outcomes.get(outcome, 0) + data.get("dropped", 1)
+        if data.get("original_command") == "set_state" and data.get("state") == self.expected_state:
+            self.ack = data
+            self.ack_event.set()
+
+    def flood(self, count):
+        """Publish count set_state commands as fast as the client allows"""
+        start = time.perf_counter()
+        for i in range(count):
+            payload = json.dumps({"command": "set_state", "state": "on" if i % 2 else "off"})
+            self.client.publish(DOWNLINK_TOPIC + self.device_uuid, payload, qos=0)
+        elapsed = time.perf_counter() - start
+        print(f"Flood: {count} commands in {elapsed:.2f} s ({count / elapsed:.0f}/s)")
+
+    def run(self, count, interval, timeout, flood=0):
+        self.client.connect(self.broker, self.port, 60)
+        self.client.subscribe(UPLINK_TOPIC + self.device_uuid, qos=1)
+        self.client.loop_start()
+        time.sleep(1.0)                                                 # Let the subscription settle
+
+        if flood:
+            self.flood(flood)
+            time.sleep(2.0)                                             # Let coalesced targets and drop reports drain
+            print(f"Flood outcomes: {self.outcomes}")
+            self.outcomes = {}
+
+        round_trips = []
+        device_times = []
+        lost = 0
+
+        for i in range(count):
+            self.expected_state = "on" if i % 2 == 0 else "off"
+            self.ack_event.clear()
+            payload = json.dumps({"command": "set_state", "state": self.expected_state})
+
+            start = time.perf_counter()
+            self.client.publish(DOWNLINK_TOPIC + self.device_uuid, payload, qos=1)
+            if not self.ack_event.wait(timeout):
+                lost += 1
+                continue
+
+            round_trips.append((time.perf_counter() - start) * 1000.0)
+            if "proc_us" in self.ack:
+                device_times.append(self.ack["proc_us"] / 1000.0)
+            time.sleep(interval)
+
+        self.client.loop_stop()
+        self.client.disconnect()
+
+        self.report("Round trip (ms)", round_trips)
+        self.report("Device processing (ms)", device_times)
+        print(f"Acks lost: {lost}/{count}  outcomes: {self.outcomes}")
+
+    @staticmethod
+    def report(title, samples):
+        if not samples:
+            print(f"{title}: no samples")
+            return
+        ordered = sorted(samples)
+        p95 = ordered[min(len(ordered) - 1, int(len(ordered) * 0.95))]
+        print(f"{title}: min {ordered[0]:.2f}  median {statistics.median(ordered):.2f}  "
+              f"p95 {p95:.2f}  max {ordered[-1]:.2f}  (n={len(ordered)})")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Measure set_state command-to-ack latency")
+    parser.add_argument("--device", required=True, help="Device UUID")
+    parser.add_argument("--count", type=int, default=50)
+    parser.add_argument("--interval", type=float, default=0.2, help="Seconds between commands")
+    parser.add_argument("--timeout", type=float, default=5.0)
+    parser.add_argument("--flood", type=int, default=0, help="Commands to publish back to back before probing")
+    parser.add_argument("--broker", default=MQTT_BROKER)
+    parser.add_argument("--port", type=int, default=MQTT_PORT)
+    args = parser.parse_args()
+
+    AckLatencyProbe(args.device, args.broker, args.port).run(args.count, args.interval, args.timeout, args.flood)
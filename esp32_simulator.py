@@ -8,6 +8,8 @@ import json
 import time
 import random
 import ssl
+import argparse
+import threading
 import paho.mqtt.client as mqtt
 from datetime import datetime
 
@@ -17,11 +19,16 @@ DEVICE_NAME = "Test ESP32 Relay"
 MQTT_BROKER = "localhost"
 MQTT_PORT = 8883
 MQTT_KEEPALIVE = 60
+FLASH_COMMIT_MS = 30        # Emulated EEPROM sector erase + write on ESP8266
+PERSIST_DELAY_MS = 1000     # Matches RELAY_PERSIST_DELAY in the firmware
+FIRMWARE_VERSION = "1.1.0-sim"
+CAPABILITIES = ["pulse", "timing", "schedule", "groups", "admission", "shadow"]
 
 # Topics
 UPLINK_TOPIC = f"ControlDevice/Uplink/{DEVICE_UUID}"
 DOWNLINK_TOPIC = f"ControlDevice/Downlink/{DEVICE_UUID}"
 STATUS_TOPIC = f"ControlDevice/Status/{DEVICE_UUID}"
+DESIRED_TOPIC = f"ControlDevice/Desired/{DEVICE_UUID}"
 
 # Certificate paths (use your existing certs)
 CA_CERT = "server/certs/ca.crt"
@@ -29,10 +36,16 @@ CLIENT_CERT = "server/certs/client.crt"
 CLIENT_KEY = "server/certs/client.key"
 
 class ESP32Simulator:
-    def __init__(self):
+    def __init__(self, commit_ms=FLASH_COMMIT_MS, inline_commit=False):
         self.device_uuid = DEVICE_UUID
         self.device_name = DEVICE_NAME
         self.relay_state = "off"
+        self.saved_state = "off"
+        self.commit_ms = commit_ms
+        self.inline_commit = inline_commit
+        self.persist_timer = None
+        self.published_state = None
+        self.applied_version = 0
         # Use the newer callback API version to avoid deprecation warning
         self.client = mqtt.Client(callback_api_version=mqtt.CallbackAPIVersion.VERSION2)
         self.setup_mqtt()
@@ -58,7 +71,7 @@ class ESP32Simulator:
         lwt_message = {
             "device_uuid": self.device_uuid,
             "status": "offline",
-            "timestamp": datetime.utcnow().isoformat()
+            "session": self.device_uuid
         }
         self.client.will_set(STATUS_TOPIC, json.dumps(lwt_message), qos=1, retain=True)
         
@@ -71,16 +84,20 @@ class ESP32Simulator:
             # Subscribe to downlink topic
             client.subscribe(DOWNLINK_TOPIC)
             print(f"📡 Subscribed to: {DOWNLINK_TOPIC}")
+            client.subscribe(DESIRED_TOPIC, qos=1)
+            print(f"📡 Subscribed to: {DESIRED_TOPIC}")
             
-            # Send hello message
-            self.send_hello()
-            
-            # Send online status
+            # Replace the retained document (the broker may hold our will)
+            self.published_state = None
             self.send_status("online")
             
     def on_message(self, client, userdata, msg):
         try:
+            received = time.perf_counter()
             payload = msg.payload.decode()
+            if msg.topic == DESIRED_TOPIC:
+                self.reconcile(payload)
+                return
             data = json.loads(payload)
             print(f"📥 Received: {payload}")
             
@@ -92,11 +109,15 @@ class ESP32Simulator:
                     print(f"🔄 Changing relay state from {self.relay_state} to {new_state}")
                     self.relay_state = new_state
                     
-                    # Simulate relay switching delay
-                    time.sleep(0.5)
+                    # Old firmware committed flash before acking, new firmware defers it
+                    if self.inline_commit:
+                        self.persist_state()
+                    else:
+                        self.schedule_persist()
                     
-                    # Send acknowledgment
-                    self.send_ack(new_state)
+                    # Send acknowledgment, then refresh the retained document
+                    self.send_ack(new_state, received)
+                    self.send_status("online")
                     print(f"✅ Relay state changed to: {self.relay_state}")
                 else:
                     print(f"❌ Invalid state: {new_state}")
@@ -107,43 +128,76 @@ class ESP32Simulator:
         except Exception as e:
             print(f"❌ Error processing message: {e}")
             
+    def reconcile(self, payload):
+        """Apply the retained desired state once per version, like the firmware"""
+        if not payload:
+            return
+        data = json.loads(payload)
+        version = data.get("version", 0)
+        if version <= self.applied_version or data.get("state") not in ("on", "off"):
+            print(f"🔁 Desired version {version} already applied")
+            return
+        self.relay_state = data["state"]
+        self.applied_version = version
+        self.schedule_persist()
+        self.send_status("online")
+        print(f"🎯 Desired state {self.relay_state} applied at version {version}")
+            
     def on_disconnect(self, client, userdata, reason_code, properties=None):
         if reason_code.is_failure:
             print(f"❌ Unexpected disconnection: {reason_code}")
         else:
             print(f"📤 Disconnected from MQTT broker (Code: {reason_code})")
         
-    def send_hello(self):
-        """Send hello message to announce device presence"""
-        message = {
-            "device_uuid": self.device_uuid,
-            "message": "hello",
-            "device_name": self.device_name,
-            "state": self.relay_state,
-            "timestamp": datetime.utcnow().isoformat()
-        }
-        self.client.publish(UPLINK_TOPIC, json.dumps(message))
-        print(f"👋 Sent hello message")
+    def persist_state(self):
+        """Emulate the blocking EEPROM commit of the relay state"""
+        self.persist_timer = None
+        if self.saved_state != self.relay_state:
+            time.sleep(self.commit_ms / 1000.0)
+            self.saved_state = self.relay_state
+            
+    def schedule_persist(self):
+        """Coalesce commits like the firmware: one write per RELAY_PERSIST_DELAY window"""
+        if self.persist_timer is None:
+            self.persist_timer = threading.Timer(PERSIST_DELAY_MS / 1000.0, self.persist_state)
+            self.persist_timer.start()
         
-    def send_ack(self, state):
+    def send_ack(self, state, received=None):
         """Send acknowledgment for state change"""
         message = {
             "device_uuid": self.device_uuid,
             "command": "ack",
+            "original_command": "set_state",
+            "success": True,
             "state": state,
             "timestamp": datetime.utcnow().isoformat()
         }
+        if received is not None:
+            message["proc_us"] = int((time.perf_counter() - received) * 1e6)
         self.client.publish(UPLINK_TOPIC, json.dumps(message))
         print(f"✅ Sent ACK for state: {state}")
         
     def send_status(self, status):
-        """Send device status (online/offline)"""
+        """Publish the retained device state document, only when it changed"""
         message = {
             "device_uuid": self.device_uuid,
             "status": status,
-            "timestamp": datetime.utcnow().isoformat()
+            "session": self.device_uuid
         }
-        self.client.publish(STATUS_TOPIC, json.dumps(message), retain=True)
+        if status != "offline":
+            message.update({
+                "device_name": self.device_name,
+                "state": self.relay_state,
+                "version": self.applied_version,
+                "firmware": FIRMWARE_VERSION,
+                "capabilities": CAPABILITIES,
+                "groups": []
+            })
+        payload = json.dumps(message, separators=(",", ":"))
+        if payload == self.published_state:
+            return
+        self.client.publish(STATUS_TOPIC, payload, qos=1, retain=True)
+        self.published_state = payload
         print(f"📊 Sent status: {status}")
         
     def send_heartbeat(self):
@@ -191,11 +245,19 @@ class ESP32Simulator:
                 
         except KeyboardInterrupt:
             print("\\n🛑 Shutting down...")
+            if self.persist_timer:
+                self.persist_timer.cancel()
+                self.persist_state()
             self.send_status("offline")
             self.client.loop_stop()
             self.client.disconnect()
             print("✅ Disconnected cleanly")
 
 if __name__ == "__main__":
-    simulator = ESP32Simulator()
+    parser = argparse.ArgumentParser(description="ESP32 relay device simulator")
+    parser.add_argument("--commit-ms", type=float, default=FLASH_COMMIT_MS, help="Emulated flash commit time")
+    parser.add_argument("--inline-commit", action="store_true", help="Commit before acking (old firmware behaviour)")
+    args = parser.parse_args()
+    
+    simulator = ESP32Simulator(args.commit_ms, args.inline_commit)
     simulator.run()
\ No newline at end of file
@@ -2,9 +2,11 @@
 
 import  os
 import  json
+import  struct
 import  asyncio
+import  hashlib
 import  requests
-from    typing              import Dict
+from    typing              import Dict, Optional
 from    datetime            import datetime
 from    paho.mqtt           import client as mqtt_client
 from    config              import constants, credentials
@@ -35,6 +37,12 @@ class MQTTClient:
         self.client.on_connect  = self.on_connect
         self.client.on_message  = self.on_message
         self.response_callbacks = {}
+        self.group_callbacks    = {}
+        self.group_sequence     = 0
+        self.online_devices     = set()                                                                         # Seen online since the last offline document
+        self.session_members: Dict[str, set] = {}                                                               # MQTT client id -> devices sharing it
+        self.shadow_waiters: Dict[str, list] = {}                                                               # device -> [(version, event)]
+        self.rollouts: Dict[str, Dict] = {}                                                                     # rollout id -> progress per device
         try:
             self.loop = asyncio.get_running_loop()
         except RuntimeError:
@@ -67,16 +75,82 @@ class MQTTClient:
             await self.handleUplinkMessage(topic, payload)
 
     async def handleStatusMessage(self, payload):
+        # Retained state document: also delivered for every device when the server (re)subscribes
         try:
+            if not payload:
+                return                                                                                          # Retained document cleared
             data = json.loads(payload)
             device_id = data.get("device_uuid")
             status = data.get("status")
-            if status == "offline" and device_id:
-                logger.info(f"Device {device_id} disconnected (offline notification)")
-                await self.update_device_online_status(device_id, False)
+            session_id = data.get("session")
+            if not device_id:
+                return
+
+            if status == "online":
+                if session_id:
+                    self.session_members.setdefault(session_id, set()).add(device_id)
+                await self.update_device_report(device_id, data)
+                if device_id not in self.online_devices:
+                    self.online_devices.add(device_id)
+                    logger.info(f"[mqtt_client] Device {device_id} connected")
+                    await self.send_pending_messages(device_id)
+            elif status == "offline":
+                # One will covers every controller sharing the connection
+                members = self.session_members.pop(session_id, set()) if session_id else set()
+                for member in members | {device_id}:
+                    logger.info(f"Device {member} disconnected (offline notification)")
+                    self.online_devices.discard(member)
+                    await self.update_device_online_status(member, False)
         except Exception as e:
             logger.error(f"Error handling LWT message: {e}")
 
+    async def update_device_report(self, device_uuid: str, data: Dict):
+        """Apply a reported state document to the database"""
+        version = data.get("version")
+        superseded = data.get("superseded")
+        drop_desired = False
+        try:
+            session = get_session()
+            device = session.get(Device, device_uuid)
+            if device and isinstance(version, int) and version < (device.reported_version or 0):
+                logger.info(f"Ignoring stale report from {device_uuid} (version {version} < {device.reported_version})")
+                device = None
+            if device:
+                device.online = True
+                if data.get("state") and data["state"] != device.state:
+                    device.state = data["state"]
+                    device.state_updated_at = datetime.utcnow()
+                if isinstance(version, int):
+                    device.reported_version = version
+                    if version > (device.desired_version or 0):
+                        device.desired_version = version                                                        # Never issue a version the device would ignore
+                if isinstance(superseded, int) and device.desired_state and superseded >= (device.desired_version or 0):
+                    logger.info(f"Device {device_uuid} superseded desired version {superseded} with a later command")
+                    device.desired_version = superseded
+                    device.desired_state = None                                                                 # Overridden, not converged
+                    drop_desired = True
+                if data.get("firmware"):
+                    device.firmware_version = data["firmware"]
+                if isinstance(data.get("capabilities"), list):
+                    device.capabilities = ",".join(data["capabilities"])
+                session.add(device)
+                session.commit()
+                logger.info(f"Updated device {device_uuid} from reported state")
+            session.close()
+        except Exception as e:
+            logger.error(f"Error applying reported state: {e}")
+
+        # A retained document the device will never apply would otherwise be replayed after a reboot
+        if drop_desired:
+            self.clear_desired_state(device_uuid)
+
+        for waiter in self.shadow_waiters.get(device_uuid, []):
+            if isinstance(version, int) and version >= waiter[0]:
+                waiter[1].set()
+            elif isinstance(superseded, int) and superseded >= waiter[0]:
+                waiter[2] = True
+                waiter[1].set()
+
     async def update_device_online_status(self, device_uuid: str, online: bool):
         """Update device online status in database"""
         try:
@@ -115,27 +189,26 @@ class MQTTClient:
                 except Exception as e:
                     logger.error(f"Error in response callback: {e}")
 
-        if data.get("message", "").lower() in ("hello", "greetings"):
+        group = data.get("group")
+        if group and group in self.group_callbacks:
+            for cb in self.group_callbacks[group][:]:
+                try:
+                    cb(device_uuid, data)
+                except Exception as e:
+                    logger.error(f"Error in group callback: {e}")
+
+        # Switches the device made on its own: schedules, pulse ends, auto-off, interlocks
+        if data.get("command") == "ack" and data.get("original_command") in constants.LOCAL_ACTION_ACKS and data.get("state"):
+            logger.info(f"[mqtt_client] Device {device_uuid} {data['original_command']} switched to {data['state']}")
+            await self.update_device_states([device_uuid], data["state"])
+
+        # Older firmware announces itself with hello instead of a retained state document
+        if data.get("message", "").lower() in ("hello", "greetings") and device_uuid not in self.online_devices:
             logger.info(f"[mqtt_client] Device {device_uuid} connected")
+            self.online_devices.add(device_uuid)
             await self.update_device_online_status(device_uuid, True)
-            await self.send_hello(device_uuid)
             await self.send_pending_messages(device_uuid)
 
-    async def send_hello(self, device_uuid: str):
-        downlink_topic = constants.SERVER_PUB_TOPIC + device_uuid
-        response = {
-            "device_id"  : device_uuid,
-            "message"    : "hello from server",
-        }
-        payload = json.dumps(response)
-        result = self.client.publish(downlink_topic, payload)
-        
-        status = result[0]
-        if status == 0:
-            logger.info(f"Sent hello to device {device_uuid} on topic {downlink_topic}")
-        else:
-            logger.error(f"Failed to send hello to {downlink_topic}")
-
     async def send_pending_messages(self, device_uuid: str):
         """Send any pending messages for this device"""
         try:
@@ -168,8 +241,68 @@ class MQTTClient:
         except Exception as e:
             logger.error(f"Error sending pending messages: {e}")
 
+    async def set_desired_state(self, device_uuid: str, state: str) -> Dict:
+        """Publish a new retained desired state and wait for the device to report its version"""
+        session = get_session()
+        device = session.get(Device, device_uuid)
+        if not device:
+            session.close()
+            return {"published": False, "converged": False}
+
+        # Devices that have not reported shadow support keep the command/ack path
+        if "shadow" not in (device.capabilities or "").split(","):
+            session.close()
+            converged = await self.send_state_command(device_uuid, state)
+            if converged:
+                await self.update_device_states([device_uuid], state)
+            return {"published": True, "converged": converged, "version": None}
+
+        version = (device.desired_version or 0) + 1
+        device.desired_state = state
+        device.desired_version = version
+        session.add(device)
+        session.commit()
+        session.close()
+
+        desired_topic = constants.DEVICE_DESIRED_TOPIC + device_uuid
+        payload = json.dumps({"version": version, "state": state})
+
+        converged = asyncio.Event()
+        waiter = [version, converged, False]                                                                    # Version, reported event, superseded
+        self.shadow_waiters.setdefault(device_uuid, []).append(waiter)
+
+        try:
+            # Retained: an offline device picks up the newest version when it reconnects, older ones are never replayed
+            result = self.client.publish(desired_topic, payload, qos=1, retain=True)
+            if result[0] != 0:
+                logger.error(f"Failed to publish desired state for device {device_uuid}")
+                return {"published": False, "converged": False, "version": version}
+
+            logger.info(f"Published desired state for device {device_uuid}: {state} (version {version})")
+
+            try:
+                await asyncio.wait_for(converged.wait(), timeout=constants.SHADOW_CONVERGE_TIMEOUT)
+                if waiter[2]:
+                    logger.warning(f"Device {device_uuid} superseded version {version} with a later command")
+                    return {"published": True, "converged": False, "superseded": True, "version": version}
+                logger.info(f"Device {device_uuid} reported version {version}")
+                return {"published": True, "converged": True, "version": version}
+            except asyncio.TimeoutError:
+                logger.warning(f"Device {device_uuid} has not reported version {version} yet")
+                return {"published": True, "converged": False, "version": version}
+        finally:
+            waiters = self.shadow_waiters.get(device_uuid, [])
+            if waiter in waiters:
+                waiters.remove(waiter)
+            if not waiters:
+                self.shadow_waiters.pop(device_uuid, None)
+
+    def clear_desired_state(self, device_uuid: str):
+        """Drop the retained shadow so a re-registered device does not replay it"""
+        self.client.publish(constants.DEVICE_DESIRED_TOPIC + device_uuid, "", qos=1, retain=True)
+
     async def send_state_command(self, device_uuid: str, state: str) -> bool:
-        """Send state change command and wait for acknowledgment"""
+        """Send state change command and wait for acknowledgment (firmware without shadow support)"""
         downlink_topic = constants.SERVER_PUB_TOPIC + device_uuid
         command = {
             "device_id": device_uuid,
@@ -219,6 +352,332 @@ class MQTTClient:
                 except ValueError:
                     pass
 
+    async def send_group_command(self, group: str, state: str, ack_sample: int = constants.GROUP_ACK_SAMPLE_PERCENT) -> Dict:
+        """Switch every device subscribed to a group with one publish and aggregate sampled acks"""
+        downlink_topic = constants.GROUP_DOWNLINK_TOPIC + group
+        self.group_sequence += 1
+        command = {
+            "command": "set_state",
+            "state": state,
+            "seq": self.group_sequence,
+            "ack": ack_sample,
+            "timestamp": datetime.utcnow().isoformat()
+        }
+        payload = json.dumps(command)
+
+        acked: Dict[str, bool] = {}
+
+        def group_ack_callback(device_uuid, response_data):
+            if response_data.get("command") == "ack" and response_data.get("original_command") == "set_state":
+                acked[device_uuid] = bool(response_data.get("success"))
+
+        self.group_callbacks.setdefault(group, []).append(group_ack_callback)
+
+        try:
+            result = self.client.publish(downlink_topic, payload, qos=1)
+            if result[0] != 0:
+                logger.error(f"Failed to send group command to {downlink_topic}")
+                return {"group": group, "published": False}
+
+            logger.info(f"Sent group command to {downlink_topic}: {state} (ack sample {ack_sample}%)")
+
+            # Members ack independently, collect whatever arrives within the window
+            await asyncio.sleep(constants.GROUP_ACK_WINDOW)
+        finally:
+            callbacks = self.group_callbacks.get(group, [])
+            if group_ack_callback in callbacks:
+                callbacks.remove(group_ack_callback)
+            if not callbacks:
+                self.group_callbacks.pop(group, None)
+
+        successful = [uuid for uuid, ok in acked.items() if ok]
+        await self.update_device_states(successful, state)
+
+        estimated = None
+        if 0 < ack_sample < 100:
+            estimated = round(len(successful) * 100 / ack_sample)
+
+        return {
+            "group": group,
+            "published": True,
+            "seq": self.group_sequence,
+            "ack_sample": ack_sample,
+            "acks": len(acked),
+            "failures": len(acked) - len(successful),
+            "estimated_members": estimated if estimated is not None else len(acked)
+        }
+
+    async def update_device_states(self, device_uuids, state: str):
+        """Record a state change reported by several devices in one transaction"""
+        if not device_uuids:
+            return
+        try:
+            session = get_session()
+            now = datetime.utcnow()
+            for device in session.exec(select(Device).where(Device.device_uuid.in_(device_uuids))).all():
+                device.state = state
+                device.state_updated_at = now
+                session.add(device)
+            session.commit()
+            session.close()
+        except Exception as e:
+            logger.error(f"Error updating device states: {e}")
+
+    async def send_groups_command(self, device_uuid: str, groups) -> bool:
+        """Configure the group topics a device listens on and wait for its acknowledgment"""
+        downlink_topic = constants.SERVER_PUB_TOPIC + device_uuid
+        payload = json.dumps({
+            "device_id": device_uuid,
+            "command": "set_groups",
+            "groups": list(groups),
+            "timestamp": datetime.utcnow().isoformat()
+        })
+
+        ack_received = asyncio.Event()
+        ack_result = {"success": False}
+
+        def ack_callback(response_data):
+            if response_data.get("command") == "ack" and response_data.get("original_command") == "set_groups":
+                ack_result["success"] = bool(response_data.get("success"))
+                ack_received.set()
+
+        self.register_response_callback(device_uuid, ack_callback)
+        try:
+            if self.client.publish(downlink_topic, payload)[0] != 0:
+                logger.error(f"Failed to send groups to device {device_uuid}")
+                return False
+            await asyncio.wait_for(ack_received.wait(), timeout=5.0)
+            return ack_result["success"]
+        except asyncio.TimeoutError:
+            logger.warning(f"No groups acknowledgment from device {device_uuid} within 5 seconds")
+            return False
+        finally:
+            self.unregister_response_callback(device_uuid, ack_callback)
+
+    async def send_schedule_command(self, device_uuid: str, rules) -> bool:
+        """Push a local schedule table to a device and wait for its acknowledgment"""
+        downlink_topic = constants.SERVER_PUB_TOPIC + device_uuid
+        payload = json.dumps({
+            "device_id": device_uuid,
+            "command": "set_schedule",
+            "rules": list(rules),
+            "timestamp": datetime.utcnow().isoformat()
+        })
+
+        ack_received = asyncio.Event()
+        ack_result = {"success": False}
+
+        def ack_callback(response_data):
+            if response_data.get("command") == "ack" and response_data.get("original_command") == "set_schedule":
+                ack_result["success"] = bool(response_data.get("success"))
+                ack_received.set()
+
+        self.register_response_callback(device_uuid, ack_callback)
+        try:
+            if self.client.publish(downlink_topic, payload, qos=1)[0] != 0:
+                logger.error(f"Failed to send schedule to device {device_uuid}")
+                return False
+            await asyncio.wait_for(ack_received.wait(), timeout=5.0)
+            return ack_result["success"]
+        except asyncio.TimeoutError:
+            logger.warning(f"No schedule acknowledgment from device {device_uuid} within 5 seconds")
+            await self.store_pending_message(device_uuid, payload)
+            return False
+        finally:
+            self.unregister_response_callback(device_uuid, ack_callback)
+
+    async def send_device_command(self, device_uuid: str, command: str, fields: Dict) -> Optional[Dict]:
+        """Send a command to a device and return its acknowledgment, None on timeout"""
+        downlink_topic = constants.SERVER_PUB_TOPIC + device_uuid
+        payload = json.dumps({
+            "device_id": device_uuid,
+            "command": command,
+            **fields,
+            "timestamp": datetime.utcnow().isoformat()
+        })
+
+        ack_received = asyncio.Event()
+        ack_result = {}
+
+        def ack_callback(response_data):
+            if response_data.get("command") == "ack" and response_data.get("original_command") == command:
+                ack_result.update(response_data)
+                ack_received.set()
+
+        self.register_response_callback(device_uuid, ack_callback)
+        try:
+            if self.client.publish(downlink_topic, payload, qos=1)[0] != 0:
+                logger.error(f"Failed to send {command} to device {device_uuid}")
+                return None
+            await asyncio.wait_for(ack_received.wait(), timeout=5.0)
+            return ack_result
+        except asyncio.TimeoutError:
+            logger.warning(f"No {command} acknowledgment from device {device_uuid} within 5 seconds")
+            return None
+        finally:
+            self.unregister_response_callback(device_uuid, ack_callback)
+
+    async def send_firmware(self, device_uuid: str, image: bytes, version: str, reboot: str = "auto", progress: Optional[Dict] = None) -> Dict:
+        """Stream a firmware image over MQTT: manifest, windowed chunks, resume on silence, verify on the device"""
+        sha256 = hashlib.sha256(image).hexdigest()
+        transfer_id = f"{version}-{sha256[:8]}"
+        chunk_size = constants.OTA_CHUNK_SIZE
+        total = (len(image) + chunk_size - 1) // chunk_size
+        chunk_topic = constants.DEVICE_OTA_TOPIC + device_uuid
+        manifest = {
+            "id": transfer_id,
+            "size": len(image),
+            "sha256": sha256,
+            "chunk": chunk_size,
+            "version": version,
+            "reboot": reboot,
+        }
+        progress = progress if progress is not None else {}
+        progress.update({"status": "starting", "id": transfer_id, "chunks": total, "acked": 0})
+
+        acks: asyncio.Queue = asyncio.Queue()
+
+        def ota_callback(response_data):
+            # ota_begin acks are returned by send_device_command itself
+            if response_data.get("command") == "ack" and response_data.get("original_command") in ("ota_chunk", "ota_end") \
+                    and response_data.get("id") == transfer_id:
+                acks.put_nowait(response_data)
+
+        def failed(error):
+            logger.warning(f"Firmware transfer {transfer_id} to device {device_uuid} failed: {error}")
+            progress.update({"status": "failed", "error": error})
+            return dict(progress)
+
+        async def send_manifest():
+            # Also the resume request: the device answers with the chunk it expects next
+            ack = await self.send_device_command(device_uuid, "ota_begin", manifest)
+            if not ack:
+                return None
+            if not ack.get("success"):
+                raise RuntimeError(ack.get("error", "rejected"))
+            return ack
+
+        self.register_response_callback(device_uuid, ota_callback)
+        try:
+            resumes = 0
+            try:
+                ack = await send_manifest()
+            except RuntimeError as e:
+                return failed(str(e))
+
+            acked = sent = 0
+            while True:
+                if ack is None:
+                    resumes += 1
+                    if resumes > constants.OTA_MAX_RESUMES:
+                        return failed("no_response")
+                    logger.info(f"Resuming firmware transfer {transfer_id} to device {device_uuid} ({resumes})")
+                    try:
+                        ack = await send_manifest()
+                    except RuntimeError as e:
+                        return failed(str(e))
+                    continue
+
+                command = ack.get("original_command")
+                if command == "ota_end":
+                    if not ack.get("success"):
+                        return failed(ack.get("error", "install_failed"))
+                    break
+                if command == "ota_begin" and ack.get("verified"):
+                    break                                                                                       # Finished before we lost track of it
+                if command in ("ota_begin", "ota_chunk"):
+                    next_chunk = int(ack.get("next", 0))
+                    if next_chunk > acked:
+                        resumes = 0
+                    acked = max(acked, next_chunk) if command == "ota_chunk" else next_chunk
+                    if command == "ota_begin" or ack.get("error") == "gap":
+                        sent = next_chunk                                                                       # Go back N
+                    progress.update({"status": "sending", "acked": acked})
+
+                # Keep the window full, paced so a rollout never floods the broker
+                while sent < total and sent - acked < constants.OTA_WINDOW:
+                    data = image[sent * chunk_size:(sent + 1) * chunk_size]
+                    self.client.publish(chunk_topic, struct.pack("<I", sent) + data, qos=1)
+                    sent += 1
+                    await asyncio.sleep(constants.OTA_CHUNK_INTERVAL)
+
+                try:
+                    ack = await asyncio.wait_for(acks.get(), timeout=constants.OTA_ACK_TIMEOUT)
+                except asyncio.TimeoutError:
+                    ack = None
+        finally:
+            self.unregister_response_callback(device_uuid, ota_callback)
+
+        logger.info(f"Firmware {version} verified on device {device_uuid}")
+        progress.update({"status": "staged", "acked": total})
+        if reboot == "manual":
+            return dict(progress)
+        return await self.wait_for_firmware(device_uuid, version, progress)
+
+    async def wait_for_firmware(self, device_uuid: str, version: str, progress: Dict) -> Dict:
+        """Wait for the rebooted device to report the new firmware in its state document"""
+        progress["status"] = "rebooting"
+        deadline = asyncio.get_running_loop().time() + constants.OTA_REBOOT_TIMEOUT
+        while asyncio.get_running_loop().time() < deadline:
+            session = get_session()
+            device = session.get(Device, device_uuid)
+            session.close()
+            if device and device.online and device.firmware_version == version:
+                logger.info(f"Device {device_uuid} is running firmware {version}")
+                progress["status"] = "installed"
+                return dict(progress)
+            await asyncio.sleep(1.0)
+        progress.update({"status": "failed", "error": "not_rebooted"})
+        return dict(progress)
+
+    async def run_rollout(self, rollout_id: str, device_uuids, image: bytes, version: str, concurrency: int, reboot: str):
+        """Update a list of devices a few at a time; "staged" reboots them only once every transfer is done"""
+        rollout = self.rollouts[rollout_id]
+        devices = rollout["devices"]
+        limit = asyncio.Semaphore(max(1, concurrency))
+
+        async def update(device_uuid):
+            async with limit:
+                session = get_session()
+                device = session.get(Device, device_uuid)
+                session.close()
+                if not device or not device.online:
+                    devices[device_uuid].update({"status": "failed", "error": "offline"})
+                    return
+                if device.firmware_version == version:
+                    devices[device_uuid]["status"] = "installed"
+                    return
+                if "ota" not in (device.capabilities or "").split(","):
+                    devices[device_uuid].update({"status": "failed", "error": "unsupported"})
+                    return
+                try:
+                    await self.send_firmware(device_uuid, image, version, "manual" if reboot == "staged" else "auto", devices[device_uuid])
+                except Exception as e:
+                    logger.error(f"Firmware transfer to device {device_uuid} failed: {e}")
+                    devices[device_uuid].update({"status": "failed", "error": str(e)})
+
+        async def restart(device_uuid):
+            async with limit:
+                ack = await self.send_device_command(device_uuid, "ota_reboot", {})
+                if not ack or not ack.get("success"):
+                    devices[device_uuid].update({"status": "failed", "error": "reboot_refused"})
+                    return
+                await self.wait_for_firmware(device_uuid, version, devices[device_uuid])
+
+        logger.info(f"Rollout {rollout_id}: firmware {version} to {len(device_uuids)} device(s), {concurrency} at a time")
+        rollout["status"] = "transferring"
+        await asyncio.gather(*(update(device_uuid) for device_uuid in device_uuids))
+
+        staged = [device_uuid for device_uuid in device_uuids if devices[device_uuid]["status"] == "staged"]
+        if staged:
+            rollout["status"] = "rebooting"
+            await asyncio.gather(*(restart(device_uuid) for device_uuid in staged))
+
+        rollout["status"] = "finished"
+        rollout["finished_at"] = datetime.utcnow().isoformat()
+        failed = sum(1 for entry in devices.values() if entry["status"] == "failed")
+        logger.info(f"Rollout {rollout_id} finished, {len(device_uuids) - failed} updated, {failed} failed")
+
     async def store_pending_message(self, device_uuid: str, message: str):
         """Store message for later delivery when device comes online"""
         try:
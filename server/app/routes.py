@@ -1,15 +1,18 @@
 # server/app/routes.py
 
+import  os
 import  json
 import  asyncio
 import  requests
 
 from    enum               import Enum
+from    typing             import List, Optional
 from    uuid               import uuid4
-from    sqlmodel           import select
+from    sqlmodel           import select, SQLModel
 from    datetime           import datetime
+from    config             import constants
 from    database.db        import get_session
-from    fastapi            import APIRouter, Request, HTTPException, status
+from    fastapi            import APIRouter, Request, HTTPException, Query, status
 from    utils.logger       import getLogger
 from    database.models    import Device, DeviceCreate, DeviceRead
 from    fastapi.responses  import JSONResponse
@@ -23,6 +26,34 @@ class DeviceState(str, Enum):
     on = "on"
     off = "off"
 
+
+class ScheduleRule(SQLModel):
+    state: DeviceState
+    at: Optional[str] = None                                            # "HH:MM" local time, repeats on `days`
+    days: Optional[int] = None                                          # Weekday mask, bit 0 = Sunday
+    once: Optional[int] = None                                          # UTC epoch seconds
+    at_in: Optional[int] = None                                         # Seconds from now (sent as "in")
+
+
+class RolloutReboot(str, Enum):
+    auto = "auto"                                                       # Each device restarts as soon as its image is verified
+    staged = "staged"                                                   # Restart only after every transfer has finished
+
+
+class FirmwareRollout(SQLModel):
+    firmware: str                                                       # File name inside constants.FIRMWARE_DIR
+    version: str                                                        # Reported by the device once it runs the image
+    devices: List[str]
+    concurrency: int = constants.OTA_ROLLOUT_CONCURRENCY
+    reboot: RolloutReboot = RolloutReboot.auto
+
+
+class RelayTiming(SQLModel):
+    auto_off: Optional[int] = None                                      # ms, 0 disables
+    min_on: Optional[int] = None                                        # ms
+    min_off: Optional[int] = None                                       # ms
+    interlock: Optional[int] = None                                     # Group id, 0 = none
+
 # API Endpoints
 
 # Create Device
@@ -65,6 +96,7 @@ async def delete_device(device_uuid: str):
 
     session.delete(device)
     session.commit()
+    mqtt_client_instance.clear_desired_state(device_uuid)
 
     logger.info(f"Deleted device id {device_uuid}")
     return {"device_uuid": device_uuid, "status": "deleted"}
@@ -92,32 +124,163 @@ async def set_device_state(device_uuid: str, state: DeviceState):
         raise HTTPException(status_code=404, detail="Device not found")
 
     logger.info(f"Setting device {device_uuid} state to {state.value}")
-    
-    # Send MQTT command and wait for acknowledgment
-    ack_received = await mqtt_client_instance.send_state_command(device_uuid, state.value)
-    
-    if ack_received:
-        # Update database only if device acknowledged
-        device.state = state.value
-        device.state_updated_at = datetime.utcnow()
-        session.add(device)
-        session.commit()
-        session.refresh(device)
+    session.close()
+
+    # Publish the desired state; the device converges on it now or when it reconnects
+    result = await mqtt_client_instance.set_desired_state(device_uuid, state.value)
+
+    if result["converged"]:
+        session = get_session()
+        device = session.get(Device, device_uuid)
         session.close()
-        
-        logger.info(f"Device {device_uuid} acknowledged state change to {state.value}")
+
+        logger.info(f"Device {device_uuid} converged on state {state.value}")
         return {
             "device_uuid": device.device_uuid,
             "state": device.state,
+            "version": result["version"],
             "acknowledged": True,
             "state_updated_at": device.state_updated_at.isoformat() + "Z"
         }
+    elif result.get("superseded"):
+        logger.warning(f"Device {device_uuid} overrode desired state {state.value} with a later command")
+        return {
+            "device_uuid": device_uuid,
+            "state": state.value,
+            "version": result["version"],
+            "acknowledged": False,
+            "superseded": True,
+            "message": "A later set_state command won before the desired state was applied"
+        }
     else:
-        session.close()
-        logger.warning(f"Device {device_uuid} did not acknowledge state change - message stored as pending")
+        logger.warning(f"Device {device_uuid} has not converged on state {state.value} yet")
         return {
             "device_uuid": device_uuid,
             "state": state.value,
+            "version": result.get("version"),
             "acknowledged": False,
-            "message": "Device did not respond - command will be sent when device comes online"
-        }
\ No newline at end of file
+            "message": "Device did not respond - it will converge on the desired state when it comes online"
+        }
+
+# Set Group State
+@router.get("/ControlDevice/set_group_state/{group:path}")
+async def set_group_state(group: str, state: DeviceState, ack_sample: int = Query(default=constants.GROUP_ACK_SAMPLE_PERCENT, ge=0, le=100)):
+    if not group or "#" in group or "+" in group:
+        raise HTTPException(status_code=400, detail="Group must be a concrete topic path")
+
+    logger.info(f"Setting group {group} state to {state.value}")
+
+    # One publish reaches every member, only a sample of them acknowledges
+    return await mqtt_client_instance.send_group_command(group, state.value, ack_sample)
+
+# Set Device Groups
+@router.post("/ControlDevice/set_groups/{device_uuid}")
+async def set_device_groups(device_uuid: str, groups: List[str]):
+    session = get_session()
+    device = session.get(Device, device_uuid)
+    session.close()
+
+    if not device:
+        raise HTTPException(status_code=404, detail="Device not found")
+
+    acknowledged = await mqtt_client_instance.send_groups_command(device_uuid, groups)
+    return {"device_uuid": device_uuid, "groups": groups, "acknowledged": acknowledged}
+
+# Set Device Schedule
+@router.post("/ControlDevice/set_schedule/{device_uuid}")
+async def set_device_schedule(device_uuid: str, rules: List[ScheduleRule]):
+    session = get_session()
+    device = session.get(Device, device_uuid)
+    session.close()
+
+    if not device:
+        raise HTTPException(status_code=404, detail="Device not found")
+
+    payload_rules = []
+    for rule in rules:
+        entry = {"state": rule.state.value}
+        if rule.at is not None:
+            entry["at"] = rule.at
+            if rule.days is not None:
+                entry["days"] = rule.days
+        elif rule.once is not None:
+            entry["once"] = rule.once
+        elif rule.at_in is not None:
+            entry["in"] = rule.at_in
+        else:
+            raise HTTPException(status_code=400, detail="Rule needs at, once or at_in")
+        payload_rules.append(entry)
+
+    # The device runs the rules locally, state changes come back as acks
+    acknowledged = await mqtt_client_instance.send_schedule_command(device_uuid, payload_rules)
+    return {"device_uuid": device_uuid, "rules": payload_rules, "acknowledged": acknowledged}
+
+# Pulse Device (momentary switch timed on the device)
+@router.get("/ControlDevice/pulse/{device_uuid}")
+async def pulse_device(device_uuid: str, duration_ms: int = Query(gt=0, le=constants.MAX_PULSE_MS), state: DeviceState = DeviceState.on):
+    session = get_session()
+    device = session.get(Device, device_uuid)
+    session.close()
+
+    if not device:
+        raise HTTPException(status_code=404, detail="Device not found")
+
+    ack = await mqtt_client_instance.send_device_command(device_uuid, "pulse", {"state": state.value, "duration": duration_ms})
+    return {
+        "device_uuid": device_uuid,
+        "duration_ms": duration_ms,
+        "acknowledged": bool(ack and ack.get("success")),
+        "state": ack.get("state") if ack else None
+    }
+
+# Set Device Timing Rules
+@router.post("/ControlDevice/set_timing/{device_uuid}")
+async def set_device_timing(device_uuid: str, timing: RelayTiming):
+    session = get_session()
+    device = session.get(Device, device_uuid)
+    session.close()
+
+    if not device:
+        raise HTTPException(status_code=404, detail="Device not found")
+
+    fields = {key: value for key, value in timing.dict().items() if value is not None}
+    ack = await mqtt_client_instance.send_device_command(device_uuid, "set_timing", fields)
+    return {"device_uuid": device_uuid, "timing": fields, "acknowledged": bool(ack and ack.get("success"))}
+
+# Start a firmware rollout over MQTT (runs in the background)
+@router.post("/ControlDevice/ota_rollout")
+async def start_ota_rollout(rollout: FirmwareRollout):
+    firmware_dir = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", constants.FIRMWARE_DIR))
+    path = os.path.abspath(os.path.join(firmware_dir, rollout.firmware))
+    if os.path.dirname(path) != firmware_dir or not os.path.isfile(path):
+        raise HTTPException(status_code=404, detail="Firmware image not found")
+    if not rollout.devices or rollout.concurrency < 1:
+        raise HTTPException(status_code=400, detail="Rollout needs devices and a concurrency of at least 1")
+
+    with open(path, "rb") as f:
+        image = f.read()
+    if image[:1] != b"\xE9":
+        raise HTTPException(status_code=400, detail="Not a firmware image")
+
+    rollout_id = uuid4().hex[:12]
+    mqtt_client_instance.rollouts[rollout_id] = {
+        "rollout_id": rollout_id,
+        "firmware": rollout.firmware,
+        "version": rollout.version,
+        "reboot": rollout.reboot.value,
+        "status": "queued",
+        "started_at": datetime.utcnow().isoformat(),
+        "devices": {device_uuid: {"status": "pending"} for device_uuid in rollout.devices},
+    }
+    asyncio.create_task(mqtt_client_instance.run_rollout(rollout_id, list(dict.fromkeys(rollout.devices)), image,
+                                                         rollout.version, rollout.concurrency, rollout.reboot.value))
+    logger.info(f"Started rollout {rollout_id}: {rollout.firmware} ({rollout.version})")
+    return mqtt_client_instance.rollouts[rollout_id]
+
+# Rollout Progress
+@router.get("/ControlDevice/ota_rollout/{rollout_id}")
+async def get_ota_rollout(rollout_id: str):
+    rollout = mqtt_client_instance.rollouts.get(rollout_id)
+    if not rollout:
+        raise HTTPException(status_code=404, detail="Rollout not found")
+    return rollout
@@ -10,10 +10,32 @@ SERVER_LWT_TOPIC                    = "ControlDevice/Status/+"
 DEVICE_LWT_TOPIC                    = "ControlDevice/Status/"
 DEVICE_UPLINK_TOPIC                 = "ControlDevice/Uplink/"
 DEVICE_DOWNLINK_TOPIC               = "ControlDevice/Downlink/"
+GROUP_DOWNLINK_TOPIC                = "ControlDevice/Group/"
+DEVICE_DESIRED_TOPIC                = "ControlDevice/Desired/"      # Retained shadow, reconciled by the device on connect
+SHADOW_CONVERGE_TIMEOUT             = 5.0                           # Seconds to wait for the reported version to catch up
+GROUP_ACK_SAMPLE_PERCENT            = 10                            # Share of group members asked to ack
+GROUP_ACK_WINDOW                    = 3.0                           # Seconds spent collecting group acks
+LOCAL_ACTION_ACKS                   = ("schedule", "timer", "interlock", "admission") # Acks for switches the device made itself
+MAX_PULSE_MS                        = 3600000                       # Matches RELAY_MAX_PULSE_MS on the device
+DEVICE_OTA_TOPIC                    = "ControlDevice/OTA/"          # Firmware chunks, u32 LE chunk number + data
+FIRMWARE_DIR                        = "firmware"                    # Images offered to rollouts, relative to the server directory
+OTA_CHUNK_SIZE                      = 768                           # At most OTA_MAX_CHUNK on the device
+OTA_WINDOW                          = 8                             # Chunks in flight before waiting for an ack
+OTA_CHUNK_INTERVAL                  = 0.02                          # Seconds between chunk publishes, per transfer
+OTA_ACK_TIMEOUT                     = 10.0                          # Seconds without progress before the manifest is re-sent
+OTA_MAX_RESUMES                     = 5                             # Re-sends without progress before a transfer is given up
+OTA_REBOOT_TIMEOUT                  = 90.0                          # Seconds for a rebooted device to report the new version
+OTA_ROLLOUT_CONCURRENCY             = 2                             # Devices updated at the same time by default
 
 # API Endpoints (WebApp)
 
 SET_CONTROL_DEVICE_API_ENDPOINT     = "/ControlDevice/set_state/"
+SET_GROUP_STATE_API_ENDPOINT        = "/ControlDevice/set_group_state/"
+SET_DEVICE_GROUPS_API_ENDPOINT      = "/ControlDevice/set_groups/"
+SET_DEVICE_SCHEDULE_API_ENDPOINT    = "/ControlDevice/set_schedule/"
+PULSE_DEVICE_API_ENDPOINT           = "/ControlDevice/pulse/"
+SET_DEVICE_TIMING_API_ENDPOINT      = "/ControlDevice/set_timing/"
 FETCH_CONTROL_DEVICE_API_ENDPOINT   = "/ControlDevice/fetch_device_info/"
 CREATE_CONTROL_DEVICE_API_ENDPOINT  = "/ControlDevice/create_device"
-DELETE_CONTROL_DEVICE_API_ENDPOINT  = "/ControlDevice/delete_device/"
\ No newline at end of file
+DELETE_CONTROL_DEVICE_API_ENDPOINT  = "/ControlDevice/delete_device/"
+OTA_ROLLOUT_API_ENDPOINT            = "/ControlDevice/ota_rollout"
\ No newline at end of file
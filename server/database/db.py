@@ -1,6 +1,7 @@
 # server/database/db.py
 
 import os
+from sqlalchemy import inspect, text
 from sqlmodel import SQLModel, Session, create_engine
 
 # Get the absolute path to the database file
@@ -14,6 +15,20 @@ def init_db():
     # Ensure the database directory exists
     os.makedirs(os.path.dirname(db_path), exist_ok=True)
     SQLModel.metadata.create_all(engine)
+    add_missing_columns()
+
+def add_missing_columns():
+    # create_all() never alters existing tables, add nullable columns introduced later
+    inspector = inspect(engine)
+    with engine.begin() as connection:
+        for table in SQLModel.metadata.sorted_tables:
+            if not inspector.has_table(table.name):
+                continue
+            existing = {column["name"] for column in inspector.get_columns(table.name)}
+            for column in table.columns:
+                if column.name not in existing and column.nullable:
+                    column_type = column.type.compile(engine.dialect)
+                    connection.execute(text(f'ALTER TABLE "{table.name}" ADD COLUMN "{column.name}" {column_type}'))
 
 def get_session():
     return Session(engine)
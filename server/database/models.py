@@ -12,6 +12,11 @@ class Device(SQLModel, table=True):
     state:                          str = Field(default="off")
     online:                         bool = Field(default=False)  # Online status
     attached_system_uuid:           Optional[str] = None
+    firmware_version:               Optional[str] = None  # From the retained state document
+    capabilities:                   Optional[str] = None  # Comma separated, from the retained state document
+    desired_state:                  Optional[str] = None  # Shadow: last state requested through the desired topic
+    desired_version:                Optional[int] = None  # Shadow: version of desired_state, only ever increases
+    reported_version:               Optional[int] = None  # Shadow: desired version the device has applied
     created_at: datetime =          Field(default_factory=datetime.utcnow)
     state_updated_at: datetime =    Field(default_factory=datetime.utcnow)
 
@@ -35,5 +40,10 @@ class DeviceRead(SQLModel):
     state: str
     online: bool  # Include online status in API response
     attached_system_uuid: Optional[str]
+    firmware_version: Optional[str] = None
+    capabilities: Optional[str] = None
+    desired_state: Optional[str] = None
+    desired_version: Optional[int] = None
+    reported_version: Optional[int] = None
     created_at: datetime
     state_updated_at: datetime
\ No newline at end of file